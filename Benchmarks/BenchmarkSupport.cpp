@@ -0,0 +1,70 @@
+/**
+ * @file BenchmarkSupport.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include <pch.h>
+#include "BenchmarkSupport.h"
+#include <wx/filename.h>
+#include <wx/filefn.h>
+#include <Game.h>
+#include <Conveyor.h>
+#include <LevelGenerator.h>
+
+/// Seed for every generated benchmark level so runs are comparable
+const unsigned int BenchmarkSeed = 20241019;
+
+/**
+ * Visitor that finds the conveyor
+ */
+class BenchmarkConveyorFinder : public VisitorBase
+{
+public:
+    /// The conveyor in the game
+    Conveyor* mConveyor = nullptr;
+
+    /**
+     * Visit the conveyor
+     * @param conveyor Conveyor we are visiting
+     */
+    void VisitConveyor(Conveyor* conveyor) override { mConveyor = conveyor; }
+};
+
+/**
+ * Constructor, writes the generated level
+ * @param productCount Number of products on the conveyor
+ * @param gateCount Number of gates in the circuit
+ * @param sensorCount Number of sensors
+ */
+GeneratedLevel::GeneratedLevel(int productCount, int gateCount, int sensorCount)
+{
+    LevelGenerator generator(BenchmarkSeed);
+    generator.SetProductCount(productCount);
+    generator.SetGateCount(gateCount);
+    generator.SetSensorCount(sensorCount);
+
+    mFilename = wxFileName::CreateTempFileName(L"sparty-bench");
+    generator.Save(mFilename);
+}
+
+/**
+ * Destructor, removes the level file
+ */
+GeneratedLevel::~GeneratedLevel()
+{
+    wxRemoveFile(mFilename);
+}
+
+/**
+ * Start the conveyor so products move on every update
+ * @param game Game with a level already loaded
+ */
+void StartConveyor(Game* game)
+{
+    BenchmarkConveyorFinder finder;
+    game->Accept(&finder);
+    if (finder.mConveyor != nullptr)
+    {
+        finder.mConveyor->Start();
+    }
+}
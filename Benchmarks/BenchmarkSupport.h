@@ -0,0 +1,35 @@
+/**
+ * @file BenchmarkSupport.h
+ * @author Attulya Pratap Gupta
+ *
+ * Helpers that build games and circuits for the benchmarks
+ */
+
+#ifndef BENCHMARKSUPPORT_H
+#define BENCHMARKSUPPORT_H
+
+class Game;
+
+/**
+ * A generated level file that is deleted when this object goes away
+ */
+class GeneratedLevel
+{
+private:
+    /// Name of the temporary level file
+    wxString mFilename;
+
+public:
+    GeneratedLevel(int productCount, int gateCount, int sensorCount = 1);
+    ~GeneratedLevel();
+
+    /**
+     * Get the name of the level file
+     * @return File name to pass to Game::Load
+     */
+    const wxString& GetFilename() const { return mFilename; }
+};
+
+void StartConveyor(Game* game);
+
+#endif //BENCHMARKSUPPORT_H
@@ -0,0 +1,121 @@
+/**
+ * @file CircuitBenchmark.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include <pch.h>
+#include <benchmark/benchmark.h>
+#include <Game.h>
+#include <BeamVisitor.h>
+#include <SensorOutputVisitor.h>
+#include <CircuitCompiler.h>
+#include <CircuitOptimizer.h>
+#include <KickPredictor.h>
+#include "BenchmarkSupport.h"
+
+/**
+ * Topologically sort a generated circuit
+ * @param state Benchmark state, range(0) is the number of gates
+ */
+static void BM_TopologicalSort(benchmark::State& state)
+{
+    GeneratedLevel level(6, int(state.range(0)), 3);
+    Game game;
+    game.Load(level.GetFilename());
+
+    BeamVisitor beamVisitor;
+    game.Accept(&beamVisitor);
+    SensorOutputVisitor sensorVisitor;
+    game.Accept(&sensorVisitor);
+
+    for (auto _ : state)
+    {
+        auto sorted = game.TopologicalSort(beamVisitor.GetOutputPin(), sensorVisitor.GetOutput());
+        benchmark::DoNotOptimize(sorted.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TopologicalSort)->RangeMultiplier(10)->Range(10, 100000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Evaluate a generated circuit once it has been compiled to a flat netlist
+ * @param state Benchmark state, range(0) is the number of gates
+ */
+static void BM_CompiledCircuit(benchmark::State& state)
+{
+    GeneratedLevel level(6, int(state.range(0)), 3);
+    Game game;
+    game.Load(level.GetFilename());
+
+    auto circuit = CircuitCompiler::Compile(&game);
+    for (auto _ : state)
+    {
+        circuit->Run();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CompiledCircuit)->RangeMultiplier(10)->Range(10, 100000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Evaluate a generated circuit one level at a time on the thread pool, whatever its size
+ * @param state Benchmark state, range(0) is the number of gates
+ */
+static void BM_ParallelCircuit(benchmark::State& state)
+{
+    GeneratedLevel level(6, int(state.range(0)), 3);
+    Game game;
+    game.Load(level.GetFilename());
+
+    auto circuit = CircuitCompiler::Compile(&game);
+    circuit->SetParallelThreshold(0);
+    for (auto _ : state)
+    {
+        circuit->Run();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParallelCircuit)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Evaluate a generated circuit after the optimizer has removed redundant gates
+ * @param state Benchmark state, range(0) is the number of gates
+ */
+static void BM_OptimizedCircuit(benchmark::State& state)
+{
+    GeneratedLevel level(6, int(state.range(0)), 3);
+    Game game;
+    game.Load(level.GetFilename());
+
+    CircuitOptimizer optimizer;
+    auto circuit = optimizer.Optimize(*CircuitCompiler::Compile(&game));
+    for (auto _ : state)
+    {
+        circuit->Run();
+    }
+
+    state.counters["nodes"] = circuit->GetNodeCount();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_OptimizedCircuit)->RangeMultiplier(10)->Range(10, 100000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Predict the score of a level with many products without running the conveyor
+ * @param state Benchmark state, range(0) is the number of products
+ */
+static void BM_KickPredictor(benchmark::State& state)
+{
+    GeneratedLevel level(int(state.range(0)), 100, 3);
+    Game game;
+    game.Load(level.GetFilename());
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(KickPredictor::PredictScore(&game));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_KickPredictor)->RangeMultiplier(10)->Range(10, 10000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,99 @@
+/**
+ * @file GameBenchmark.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include <pch.h>
+#include <benchmark/benchmark.h>
+#include <Game.h>
+#include <ProductDetector.h>
+#include <OffscreenRenderer.h>
+#include "BenchmarkSupport.h"
+
+/// Simulated time for one tick at 60 frames per second
+const double TickTime = 1.0 / 60.0;
+
+/**
+ * One Game::Update tick with a running conveyor
+ * @param state Benchmark state, range(0) is the number of products
+ */
+static void BM_GameUpdate(benchmark::State& state)
+{
+    GeneratedLevel level(int(state.range(0)), 3);
+    Game game;
+    game.Load(level.GetFilename());
+    StartConveyor(&game);
+
+    for (auto _ : state)
+    {
+        game.Update(TickTime);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GameUpdate)->RangeMultiplier(4)->Range(6, 6 << 10);
+
+/**
+ * One scan of the beam, sensor and Sparty by the product detector
+ * @param state Benchmark state, range(0) is the number of products
+ */
+static void BM_ProductDetectorScan(benchmark::State& state)
+{
+    GeneratedLevel level(int(state.range(0)), 0);
+    Game game;
+    game.Load(level.GetFilename());
+
+    for (auto _ : state)
+    {
+        ProductDetector::UpdateLanes(&game);
+
+        ProductDetector detector(0);
+        game.Accept(&detector);
+        detector.UpdateSparty();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ProductDetectorScan)->RangeMultiplier(4)->Range(6, 6 << 10);
+
+/**
+ * Hit test a point that misses every item, the worst case for a click
+ * @param state Benchmark state, range(0) is the number of gates
+ */
+static void BM_HitTest(benchmark::State& state)
+{
+    GeneratedLevel level(6, int(state.range(0)));
+    Game game;
+    game.Load(level.GetFilename());
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(game.HitTest(1, 1));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HitTest)->RangeMultiplier(10)->Range(10, 10000);
+
+/**
+ * Draw one frame into an image, with no window or compositor involved
+ * @param state Benchmark state, range(0) is the number of products
+ */
+static void BM_OffscreenDraw(benchmark::State& state)
+{
+    GeneratedLevel level(int(state.range(0)), 3);
+    Game game;
+    game.Load(level.GetFilename());
+    StartConveyor(&game);
+
+    OffscreenRenderer renderer(1150, 800);
+    renderer.Advance(&game, 1.0);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(renderer.Render(&game));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OffscreenDraw)->RangeMultiplier(8)->Range(6, 6 << 9);
@@ -0,0 +1,27 @@
+/**
+ * @file LevelBenchmark.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include <pch.h>
+#include <benchmark/benchmark.h>
+#include <Game.h>
+
+/// Number of the last level shipped in levels/
+const int LastShippedLevel = 8;
+
+/**
+ * Load each shipped level file, including XML parsing and image decoding
+ * @param state Benchmark state, range(0) is the level number
+ */
+static void BM_LevelLoad(benchmark::State& state)
+{
+    Game game;
+    auto filename = wxString::Format(L"levels/level%d.xml", int(state.range(0)));
+
+    for (auto _ : state)
+    {
+        game.Load(filename);
+    }
+}
+BENCHMARK(BM_LevelLoad)->DenseRange(0, LastShippedLevel)->Unit(benchmark::kMillisecond);
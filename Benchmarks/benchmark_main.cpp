@@ -0,0 +1,49 @@
+/**
+ * @file benchmark_main.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include <pch.h>
+#include <benchmark/benchmark.h>
+#include <wx/filefn.h>
+#include <string>
+#include <vector>
+
+/// File the results are written to unless --benchmark_out is given
+const char* DefaultBenchmarkOut = "--benchmark_out=bench_output.json";
+
+/// Format of the results file unless --benchmark_out_format is given
+const char* DefaultBenchmarkOutFormat = "--benchmark_out_format=json";
+
+int main(int argc, char** argv) {
+    // Always write JSON results so runs can be compared across releases
+    std::vector<char*> args(argv, argv + argc);
+    bool hasOut = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::string(argv[i]).rfind("--benchmark_out=", 0) == 0)
+        {
+            hasOut = true;
+        }
+    }
+
+    if (!hasOut)
+    {
+        args.push_back(const_cast<char*>(DefaultBenchmarkOut));
+        args.push_back(const_cast<char*>(DefaultBenchmarkOutFormat));
+    }
+
+    int count = int(args.size());
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data()))
+    {
+        return 1;
+    }
+
+    wxSetWorkingDirectory(L"..");
+    wxInitAllImageHandlers();
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
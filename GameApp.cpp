@@ -6,6 +6,12 @@
 #include "pch.h"
 #include "GameApp.h"
 #include <MainFrame.h>
+#include <TraceRecorder.h>
+#include <SpriteAtlas.h>
+#include <ProductSpriteCache.h>
+
+/// Environment variable naming the file to save a Chrome trace to
+const wxString TraceEnvironmentVariable = L"SPARTY_TRACE";
 
 #ifdef WIN32
 #define _CRTDBG_MAP_ALLOC
@@ -26,6 +32,12 @@ bool GameApp::OnInit()
     if (!wxApp::OnInit())
         return false;
 
+    // Record a trace of the whole run if requested
+    if (wxGetEnv(TraceEnvironmentVariable, &mTraceFile) && !mTraceFile.IsEmpty())
+    {
+        TraceRecorder::Get().SetEnabled(true);
+    }
+
     // Add image type handlers
     wxInitAllImageHandlers();
 
@@ -35,3 +47,22 @@ bool GameApp::OnInit()
 
     return true;
 }
+
+/**
+ * Clean up the application, saving the trace if one was recorded.
+ * @return Exit code
+ */
+int GameApp::OnExit()
+{
+    // The cached sprites hold graphics objects that must go before wxWidgets shuts down
+    SpriteAtlas::Get().Clear();
+    ProductSpriteCache::Get().Clear();
+
+    if (!mTraceFile.IsEmpty())
+    {
+        TraceRecorder::Get().SetEnabled(false);
+        TraceRecorder::Get().Save(mTraceFile);
+    }
+
+    return wxApp::OnExit();
+}
@@ -14,9 +14,12 @@
 class GameApp : public wxApp
 {
 private:
+    /// File to save the trace to on exit, empty if tracing is off
+    wxString mTraceFile;
 
 public:
     virtual bool OnInit() override;
+    virtual int OnExit() override;
 };
 
 
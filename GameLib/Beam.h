@@ -90,6 +90,18 @@ public:
      * @param show whether or not we should show control points
      * */
     void SetShowControlPoints(bool show) override { mOutputPin->SetShowControlPoints(show);}
+
+    /**
+     * Save the beam output
+     * @param state Buffer to save into
+     */
+    void SaveState(GameState* state) override { state->Put(mOutput); mOutputPin->SaveState(state); }
+
+    /**
+     * Restore the beam output
+     * @param state Buffer to restore from
+     */
+    void RestoreState(GameState* state) override { state->Get(mOutput); mOutputPin->RestoreState(state); }
 };
 
 #endif //PROJECT1_GAMELIB_BEAM_H
@@ -4,3 +4,21 @@
  */
 #include "pch.h"
 #include "BeamVisitor.h"
+
+/**
+ * Gets the output pin of the beam across a lane
+ * @param lane Lane of the beam
+ * @return Pointer to the output pin, nullptr if the lane has no beam
+ */
+std::shared_ptr<Pin> BeamVisitor::GetOutputPin(int lane)
+{
+	for (size_t i = 0; i < mOutputs.size(); i++)
+	{
+		if (mLanes[i] == lane)
+		{
+			return mOutputs[i];
+		}
+	}
+
+	return nullptr;
+}
@@ -16,21 +16,32 @@
  */
 class BeamVisitor : public VisitorBase {
 private:
-	/// Output pin of beam
-	std::shared_ptr<Pin> mOutput;
+	/// Output pins of the beams, in the order they were visited
+	std::vector<std::shared_ptr<Pin>> mOutputs;
+
+	/// Lane of each beam in mOutputs
+	std::vector<int> mLanes;
 
 public:
 	/**
 	* Visits the beam and saves the pointer to the output pin
 	* @param beam The beam object we are visiting
 	*/
-	void VisitBeam(Beam* beam) { mOutput = beam->GetOutputPin(); }
+	void VisitBeam(Beam* beam) override { mOutputs.push_back(beam->GetOutputPin()); mLanes.push_back(beam->GetLane()); }
+
+	/**
+	* Gets the output pin of the first beam we visited
+	* @return Pointer to the output pin, nullptr if there is no beam
+	*/
+	std::shared_ptr<Pin> GetOutputPin() { return mOutputs.empty() ? nullptr : mOutputs[0]; }
+
+	std::shared_ptr<Pin> GetOutputPin(int lane);
 
 	/**
-	* Gets the output pin of the beam object we visited
-	* @return Pointer to the output pin
+	* Gets the output pins of every beam we visited
+	* @return Pointers to the output pins
 	*/
-	std::shared_ptr<Pin> GetOutputPin() { return mOutput; }
+	const std::vector<std::shared_ptr<Pin>>& GetOutputPins() { return mOutputs; }
 
 };
 
@@ -0,0 +1,256 @@
+/**
+ * @file CircuitCompiler.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "CircuitCompiler.h"
+#include "Game.h"
+#include "Gate.h"
+#include "GateAnd.h"
+#include "GateOr.h"
+#include "GateNot.h"
+#include "GateSRFlipFlop.h"
+#include "GateDFlipFlop.h"
+#include "GateMulti.h"
+#include "GateLut.h"
+#include "GateMacro.h"
+#include "Sparty.h"
+#include "TraceRecorder.h"
+#include <map>
+
+/// Node types for the operations of a multi-input gate
+static const std::map<GateMulti::Operations, CompiledCircuit::NodeTypes> MultiNodeTypes = {
+    {GateMulti::Operations::And, CompiledCircuit::NodeTypes::And},
+    {GateMulti::Operations::Or, CompiledCircuit::NodeTypes::Or},
+    {GateMulti::Operations::Xor, CompiledCircuit::NodeTypes::Xor},
+};
+
+/**
+ * Visitor that adds the node for a single gate to a circuit
+ */
+class GateNodeAdder : public VisitorBase
+{
+private:
+    CompiledCircuit* mCircuit;        ///< Circuit to add to
+    const std::vector<int>& mInputs;  ///< Signals for the gate's input pins
+    const std::vector<int>& mOutputs; ///< Signals for the gate's output pins
+
+    /**
+     * Add a node with the gate's inputs and outputs
+     * @param type What the node computes
+     * @param table Truth table for a Lut node
+     */
+    void Add(CompiledCircuit::NodeTypes type, uint64_t table = 0) { mCircuit->AddNode(type, mInputs, mOutputs, table); }
+
+public:
+    /**
+     * Constructor
+     * @param circuit Circuit to add to
+     * @param inputs Signals for the gate's input pins
+     * @param outputs Signals for the gate's output pins
+     */
+    GateNodeAdder(CompiledCircuit* circuit, const std::vector<int>& inputs, const std::vector<int>& outputs) :
+        mCircuit(circuit), mInputs(inputs), mOutputs(outputs) {}
+
+    void VisitGateAnd(GateAnd* gate) override { Add(CompiledCircuit::NodeTypes::And); }
+    void VisitGateOr(GateOr* gate) override { Add(CompiledCircuit::NodeTypes::Or); }
+    void VisitGateNot(GateNot* gate) override { Add(CompiledCircuit::NodeTypes::Not); }
+    void VisitGateSRFlipFlop(GateSRFlipFlop* gate) override { Add(CompiledCircuit::NodeTypes::SRFlipFlop); }
+    void VisitGateDFlipFlop(GateDFlipFlop* gate) override;
+    void VisitGateMulti(GateMulti* gate) override { Add(MultiNodeTypes.at(gate->GetOperation())); }
+    void VisitGateLut(GateLut* gate) override { Add(CompiledCircuit::NodeTypes::Lut, gate->GetTable()); }
+    void VisitGateMacro(GateMacro* gate) override { gate->GetDefinition()->Instantiate(mCircuit, mInputs, mOutputs); }
+};
+
+/**
+ * Add the node for a D flip flop, starting from the clock the gate last saw
+ * so a circuit compiled mid-run does not see a rising edge the gate already latched
+ * @param gate Gate we are visiting
+ */
+void GateNodeAdder::VisitGateDFlipFlop(GateDFlipFlop* gate)
+{
+    int node = mCircuit->AddNode(CompiledCircuit::NodeTypes::DFlipFlop, mInputs, mOutputs);
+    mCircuit->SetClock(node, gate->GetClockState() ? SignalOne : SignalZero);
+}
+
+/**
+ * Compile the gates of a game
+ * @param game Game to compile
+ * @return The compiled circuit, with the game's pins bound to it
+ */
+std::unique_ptr<CompiledCircuit> CircuitCompiler::Compile(Game* game)
+{
+    TraceScope trace("CircuitCompiler::Compile", "circuit");
+
+    CircuitCompiler compiler;
+    game->Accept(&compiler);
+    return compiler.Build();
+}
+
+/**
+ * Add the node or nodes for a gate to a circuit
+ * @param circuit Circuit to add to
+ * @param gate The gate
+ * @param inputs Signals for the gate's input pins, in GetInputPins order
+ * @param outputs Signals for the gate's output pins
+ */
+void CircuitCompiler::AddGate(CompiledCircuit* circuit, Gate* gate, const std::vector<int>& inputs,
+                              const std::vector<int>& outputs)
+{
+    GateNodeAdder adder(circuit, inputs, outputs);
+    gate->Accept(&adder);
+}
+
+/**
+ * Build the circuit from the gates visited
+ * @return The compiled circuit
+ */
+std::unique_ptr<CompiledCircuit> CircuitCompiler::Build()
+{
+    auto circuit = std::make_unique<CompiledCircuit>();
+
+    // Inputs that are not wired to anything
+    int unknown = circuit->AddSignal();
+
+    // Outputs start from the pins, so flip flops keep the state they hold
+    std::map<Pin*, int> signals;
+    for (auto gate : mGates)
+    {
+        auto pins = gate->GetOutputPins();
+        for (auto& pin : {pins.first, pins.second})
+        {
+            if (pin != nullptr)
+            {
+                signals[pin.get()] = circuit->AddSignal(CompiledCircuit::ReadPin(pin.get()));
+                circuit->BindSink(signals[pin.get()], pin.get());
+            }
+        }
+    }
+
+    // Find the signal an input pin reads, making a source for beam and sensor outputs
+    auto inputSignal = [&](Pin* pin) {
+        auto source = pin->GetConnected();
+        if (source == nullptr)
+        {
+            return unknown;
+        }
+
+        auto found = signals.find(source);
+        if (found != signals.end())
+        {
+            return found->second;
+        }
+
+        int signal = circuit->AddSignal();
+        circuit->BindSource(signal, source);
+        signals[source] = signal;
+        return signal;
+    };
+
+    for (auto gate : mGates)
+    {
+        std::vector<int> inputs;
+        for (auto& pin : gate->GetInputPins())
+        {
+            inputs.push_back(inputSignal(pin.get()));
+            circuit->BindSink(inputs.back(), pin.get());
+        }
+
+        std::vector<int> outputs;
+        auto pins = gate->GetOutputPins();
+        for (auto& pin : {pins.first, pins.second})
+        {
+            if (pin != nullptr)
+            {
+                outputs.push_back(signals[pin.get()]);
+            }
+        }
+
+        AddGate(circuit.get(), gate, inputs, outputs);
+    }
+
+    // One root for each lane's Sparty, all sharing the one circuit
+    for (auto sparty : mSpartys)
+    {
+        auto pin = sparty->GetInputPin();
+        auto signal = inputSignal(pin.get());
+        circuit->BindSink(signal, pin.get());
+        circuit->AddRoot(signal);
+    }
+
+    circuit->Finalize();
+    return circuit;
+}
+
+/**
+ * Visit an and gate
+ * @param gate Gate we are visiting
+ */
+void CircuitCompiler::VisitGateAnd(GateAnd* gate)
+{
+    mGates.push_back(gate);
+}
+
+/**
+ * Visit an or gate
+ * @param gate Gate we are visiting
+ */
+void CircuitCompiler::VisitGateOr(GateOr* gate)
+{
+    mGates.push_back(gate);
+}
+
+/**
+ * Visit a not gate
+ * @param gate Gate we are visiting
+ */
+void CircuitCompiler::VisitGateNot(GateNot* gate)
+{
+    mGates.push_back(gate);
+}
+
+/**
+ * Visit an SR flip flop
+ * @param gate Gate we are visiting
+ */
+void CircuitCompiler::VisitGateSRFlipFlop(GateSRFlipFlop* gate)
+{
+    mGates.push_back(gate);
+}
+
+/**
+ * Visit a D flip flop
+ * @param gate Gate we are visiting
+ */
+void CircuitCompiler::VisitGateDFlipFlop(GateDFlipFlop* gate)
+{
+    mGates.push_back(gate);
+}
+
+/**
+ * Visit a multi-input gate
+ * @param gate Gate we are visiting
+ */
+void CircuitCompiler::VisitGateMulti(GateMulti* gate)
+{
+    mGates.push_back(gate);
+}
+
+/**
+ * Visit a lookup table gate
+ * @param gate Gate we are visiting
+ */
+void CircuitCompiler::VisitGateLut(GateLut* gate)
+{
+    mGates.push_back(gate);
+}
+
+/**
+ * Visit a macro gate
+ * @param gate Gate we are visiting
+ */
+void CircuitCompiler::VisitGateMacro(GateMacro* gate)
+{
+    mGates.push_back(gate);
+}
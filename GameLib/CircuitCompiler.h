@@ -0,0 +1,59 @@
+/**
+ * @file CircuitCompiler.h
+ * @author Attulya Pratap Gupta
+ *
+ * Visitor that compiles the gates of a game into a flat netlist
+ */
+
+#ifndef CIRCUITCOMPILER_H
+#define CIRCUITCOMPILER_H
+
+#include <memory>
+#include <vector>
+
+#include "VisitorBase.h"
+#include "CompiledCircuit.h"
+
+class Game;
+
+/**
+ * Visitor that compiles the gates of a game into a CompiledCircuit.
+ *
+ * Gate output pins become signals, and so do the beam and sensor
+ * outputs the gates are wired to, which are read in as sources. Inputs
+ * that are not wired to anything read a signal that is always unknown.
+ * Macros are flattened into the gates they are made of.
+ */
+class CircuitCompiler : public VisitorBase
+{
+private:
+    /// The gates visited
+    std::vector<Gate*> mGates;
+
+    /// Sparty of each lane, in the order they were visited
+    std::vector<Sparty*> mSpartys;
+
+    std::unique_ptr<CompiledCircuit> Build();
+
+public:
+    static std::unique_ptr<CompiledCircuit> Compile(Game* game);
+    static void AddGate(CompiledCircuit* circuit, Gate* gate, const std::vector<int>& inputs,
+                        const std::vector<int>& outputs);
+
+    void VisitGateAnd(GateAnd* gate) override;
+    void VisitGateOr(GateOr* gate) override;
+    void VisitGateNot(GateNot* gate) override;
+    void VisitGateSRFlipFlop(GateSRFlipFlop* gate) override;
+    void VisitGateDFlipFlop(GateDFlipFlop* gate) override;
+    void VisitGateMulti(GateMulti* gate) override;
+    void VisitGateLut(GateLut* gate) override;
+    void VisitGateMacro(GateMacro* gate) override;
+
+    /**
+     * Visit Sparty, whose input is driven by the circuit
+     * @param sparty Sparty object we are visiting
+     */
+    void VisitSparty(Sparty* sparty) override { mSpartys.push_back(sparty); }
+};
+
+#endif //CIRCUITCOMPILER_H
@@ -0,0 +1,329 @@
+/**
+ * @file CircuitOptimizer.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "CircuitOptimizer.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+using NodeTypes = CompiledCircuit::NodeTypes;
+
+/// A node that survives folding, with its inputs already resolved
+struct KeptNode
+{
+    NodeTypes mType;          ///< What the node computes
+    std::vector<int> mInputs; ///< Input signals of the original circuit
+    int mOutputs[2];          ///< Output signals of the original circuit
+    uint64_t mTable;          ///< Truth table of a Lut node
+    unsigned char mClock;     ///< Clock a D flip flop saw on its last evaluation
+};
+
+/**
+ * Is a node an AND, OR or XOR, whose inputs can be put in any order?
+ * @param type Kind of node
+ * @return True if the node is commutative
+ */
+static bool IsCommutative(NodeTypes type)
+{
+    return type == NodeTypes::And || type == NodeTypes::Or || type == NodeTypes::Xor;
+}
+
+/**
+ * Build the optimized circuit
+ * @param circuit Circuit to optimize, which is left unchanged
+ * @return The optimized circuit, bound to the same pins
+ */
+std::unique_ptr<CompiledCircuit> CircuitOptimizer::Optimize(const CompiledCircuit& circuit)
+{
+    TraceScope trace("CircuitOptimizer::Optimize", "circuit");
+
+    mFolded = mBypassed = mMerged = mDead = 0;
+
+    auto& nodes = circuit.GetNodes();
+    auto& nodeInputs = circuit.GetInputs();
+    int signalCount = circuit.GetSignalCount();
+
+    // Signals that nothing drives and no pin sets keep their initial value forever
+    std::vector<bool> driven(signalCount, false);
+    for (auto& node : nodes)
+    {
+        for (auto output : node.mOutputs)
+        {
+            if (output >= 0)
+            {
+                driven[output] = true;
+            }
+        }
+    }
+    for (auto& source : circuit.GetSources())
+    {
+        driven[source.first] = true;
+    }
+
+    const int NotConstant = -1;
+    std::vector<int> constant(signalCount, NotConstant);
+    for (int s = 0; s < signalCount; s++)
+    {
+        if (!driven[s])
+        {
+            constant[s] = circuit.GetSignal(s);
+        }
+    }
+
+    // Each signal that was replaced points at the signal that replaces it
+    std::vector<int> alias(signalCount);
+    for (int s = 0; s < signalCount; s++)
+    {
+        alias[s] = s;
+    }
+    auto resolve = [&alias](int signal) {
+        while (alias[signal] != signal)
+        {
+            signal = alias[signal];
+        }
+        return signal;
+    };
+
+    // Replace an output with another signal, unless that would close a loop
+    auto replace = [&](int output, int signal) {
+        signal = resolve(signal);
+        if (signal == output)
+        {
+            return false;
+        }
+        alias[output] = signal;
+        return true;
+    };
+
+    // Make an output a constant
+    auto fold = [&](int output, unsigned char value) {
+        constant[output] = value;
+        mFolded++;
+    };
+
+    std::vector<KeptNode> kept;
+    std::vector<int> keptDriver(signalCount, -1);
+    std::map<std::tuple<int, std::vector<int>, uint64_t>, int> structures;
+
+    for (auto n : circuit.GetOrder())
+    {
+        auto& node = nodes[n];
+        int output = node.mOutputs[0];
+
+        std::vector<int> inputs;
+        for (int i = 0; i < node.mInputCount; i++)
+        {
+            inputs.push_back(resolve(nodeInputs[node.mFirstInput + i]));
+        }
+
+        bool stateful = node.mType == NodeTypes::SRFlipFlop || node.mType == NodeTypes::DFlipFlop;
+        if (!stateful)
+        {
+            // Fold once every input is constant, or as soon as one is unknown
+            bool allConstant = true;
+            bool anyUnknown = false;
+            std::vector<unsigned char> values;
+            for (auto input : inputs)
+            {
+                allConstant = allConstant && constant[input] != NotConstant;
+                anyUnknown = anyUnknown || constant[input] == SignalUnknown;
+                values.push_back(constant[input] == NotConstant ? SignalUnknown : constant[input]);
+            }
+
+            if (anyUnknown || allConstant)
+            {
+                fold(output, CompiledCircuit::EvaluateCombinational(node.mType, values.data(),
+                                                                    int(values.size()), node.mTable));
+                continue;
+            }
+
+            auto type = node.mType;
+            if (IsCommutative(type))
+            {
+                // Drop inputs that do not change the result: a one into an AND, a zero into an OR or XOR
+                unsigned char identity = type == NodeTypes::And ? SignalOne : SignalZero;
+                bool invert = false;
+                std::vector<int> remaining;
+                for (auto input : inputs)
+                {
+                    if (constant[input] == identity)
+                    {
+                        continue;
+                    }
+                    if (type == NodeTypes::Xor && constant[input] == SignalOne)
+                    {
+                        invert = !invert;
+                        continue;
+                    }
+                    remaining.push_back(input);
+                }
+
+                // x AND x and x OR x are just x
+                if (type != NodeTypes::Xor)
+                {
+                    std::sort(remaining.begin(), remaining.end());
+                    remaining.erase(std::unique(remaining.begin(), remaining.end()), remaining.end());
+                }
+
+                if (remaining.size() == 1 && constant[remaining[0]] == NotConstant)
+                {
+                    if (!invert)
+                    {
+                        if (replace(output, remaining[0]))
+                        {
+                            mBypassed++;
+                            continue;
+                        }
+                    }
+                    else
+                    {
+                        type = NodeTypes::Not;
+                    }
+                }
+                else if (invert)
+                {
+                    // Keep the constant one so the parity is unchanged
+                    remaining.push_back(inputs[std::find_if(inputs.begin(), inputs.end(),
+                        [&](int s) { return constant[s] == SignalOne; }) - inputs.begin()]);
+                }
+
+                if (!remaining.empty())
+                {
+                    inputs = remaining;
+                }
+            }
+
+            // NOT of a NOT is the original signal
+            if (type == NodeTypes::Not)
+            {
+                auto driver = keptDriver[inputs[0]];
+                if (driver >= 0 && kept[driver].mType == NodeTypes::Not && replace(output, kept[driver].mInputs[0]))
+                {
+                    mBypassed++;
+                    continue;
+                }
+            }
+
+            // Merge with an identical node seen earlier
+            auto key = inputs;
+            if (IsCommutative(type))
+            {
+                std::sort(key.begin(), key.end());
+            }
+            auto structure = std::make_tuple(int(type), key, type == NodeTypes::Lut ? node.mTable : 0);
+            auto found = structures.find(structure);
+            if (found != structures.end() && replace(output, found->second))
+            {
+                mMerged++;
+                continue;
+            }
+            structures[structure] = output;
+
+            keptDriver[output] = int(kept.size());
+            kept.push_back({type, inputs, {output, -1}, node.mTable, SignalZero});
+            continue;
+        }
+
+        keptDriver[output] = int(kept.size());
+        if (node.mOutputs[1] >= 0)
+        {
+            keptDriver[node.mOutputs[1]] = int(kept.size());
+        }
+        kept.push_back({node.mType, inputs, {node.mOutputs[0], node.mOutputs[1]}, node.mTable, circuit.GetClock(n)});
+    }
+
+    // Keep only the nodes that something in the cone of a root reads
+    std::vector<bool> live(kept.size(), false);
+    std::vector<int> pending;
+    for (auto root : circuit.GetRoots())
+    {
+        pending.push_back(resolve(root));
+    }
+    while (!pending.empty())
+    {
+        auto signal = pending.back();
+        pending.pop_back();
+
+        auto driver = keptDriver[signal];
+        if (driver < 0 || live[driver])
+        {
+            continue;
+        }
+
+        live[driver] = true;
+        for (auto input : kept[driver].mInputs)
+        {
+            pending.push_back(resolve(input));
+        }
+    }
+
+    // Build the new circuit from the live nodes
+    auto optimized = std::make_unique<CompiledCircuit>();
+    std::vector<int> mapped(signalCount, -1);
+    auto map = [&](int signal) {
+        signal = resolve(signal);
+        if (mapped[signal] < 0)
+        {
+            auto value = constant[signal] != NotConstant ? constant[signal] : circuit.GetSignal(signal);
+            mapped[signal] = optimized->AddSignal((unsigned char)value);
+        }
+        return mapped[signal];
+    };
+
+    for (size_t k = 0; k < kept.size(); k++)
+    {
+        if (!live[k])
+        {
+            mDead++;
+            continue;
+        }
+
+        auto& node = kept[k];
+        std::vector<int> inputs;
+        for (auto input : node.mInputs)
+        {
+            inputs.push_back(map(input));
+        }
+
+        std::vector<int> outputs;
+        for (auto output : node.mOutputs)
+        {
+            if (output >= 0)
+            {
+                outputs.push_back(map(output));
+            }
+        }
+
+        int added = optimized->AddNode(node.mType, inputs, outputs, node.mTable);
+        optimized->SetClock(added, node.mClock);
+    }
+
+    for (auto root : circuit.GetRoots())
+    {
+        optimized->AddRoot(map(root));
+    }
+
+    for (auto& source : circuit.GetSources())
+    {
+        if (mapped[source.first] >= 0)
+        {
+            optimized->BindSource(mapped[source.first], source.second);
+        }
+    }
+
+    for (auto& sink : circuit.GetSinks())
+    {
+        auto signal = resolve(sink.first);
+        if (mapped[signal] >= 0)
+        {
+            optimized->BindSink(mapped[signal], sink.second);
+        }
+    }
+
+    optimized->Finalize();
+    return optimized;
+}
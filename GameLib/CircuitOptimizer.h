@@ -0,0 +1,69 @@
+/**
+ * @file CircuitOptimizer.h
+ * @author Attulya Pratap Gupta
+ *
+ * Removes redundant gates from a compiled circuit
+ */
+
+#ifndef CIRCUITOPTIMIZER_H
+#define CIRCUITOPTIMIZER_H
+
+#include <memory>
+
+#include "CompiledCircuit.h"
+
+/**
+ * Builds a smaller compiled circuit that computes the same root signals.
+ *
+ * Only the compiled netlist is rewritten, never the gates and wires the
+ * player placed. The passes follow the gates' own rule that any unknown
+ * input makes the output unknown, so a constant zero into an AND only
+ * folds once every other input is constant too.
+ *
+ * Pins of gates that are removed are no longer updated by the optimized
+ * circuit, so it is meant for simulation rather than for drawing.
+ */
+class CircuitOptimizer
+{
+private:
+    /// Number of nodes replaced by a constant
+    int mFolded = 0;
+
+    /// Number of nodes replaced by one of their inputs, such as double NOTs
+    int mBypassed = 0;
+
+    /// Number of nodes merged with an identical node
+    int mMerged = 0;
+
+    /// Number of nodes that do not reach a root
+    int mDead = 0;
+
+public:
+    std::unique_ptr<CompiledCircuit> Optimize(const CompiledCircuit& circuit);
+
+    /**
+     * Get the number of nodes replaced by a constant
+     * @return Number of nodes
+     */
+    int GetFoldedCount() const { return mFolded; }
+
+    /**
+     * Get the number of nodes replaced by one of their inputs
+     * @return Number of nodes
+     */
+    int GetBypassedCount() const { return mBypassed; }
+
+    /**
+     * Get the number of nodes merged with an identical node
+     * @return Number of nodes
+     */
+    int GetMergedCount() const { return mMerged; }
+
+    /**
+     * Get the number of nodes removed because nothing they drive reaches a root
+     * @return Number of nodes
+     */
+    int GetDeadCount() const { return mDead; }
+};
+
+#endif //CIRCUITOPTIMIZER_H
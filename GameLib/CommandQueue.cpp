@@ -0,0 +1,85 @@
+/**
+ * @file CommandQueue.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "CommandQueue.h"
+#include "InputLog.h"
+#include "TraceRecorder.h"
+
+using Types = InputEvent::Types;
+
+/**
+ * Constructor
+ * @param capacity Number of actions that can be waiting at once
+ */
+CommandQueue::CommandQueue(size_t capacity) : mQueue(capacity)
+{
+    mBatch.reserve(capacity);
+}
+
+/**
+ * Post an action, only ever called by the window
+ * @param event The action
+ * @return False if the queue is full and the action was dropped
+ */
+bool CommandQueue::Post(const InputEvent& event)
+{
+    if (!mQueue.Push(event))
+    {
+        mDropped++;
+        return false;
+    }
+
+    mPosted++;
+    return true;
+}
+
+/**
+ * Apply every waiting action to the game, skipping mouse moves that a
+ * later move in the same batch replaces. Only ever called by the owner
+ * of the game, between ticks.
+ * @param game Game to apply the actions to
+ * @param log If not null, the actions applied are recorded here
+ * @return Number of actions applied
+ */
+int CommandQueue::Apply(Game* game, InputLog* log)
+{
+    mBatch.clear();
+    InputEvent event;
+    while (mQueue.Pop(event))
+    {
+        mBatch.push_back(event);
+    }
+
+    if (mBatch.empty())
+    {
+        return 0;
+    }
+
+    TraceScope trace("CommandQueue::Apply", "input");
+
+    int applied = 0;
+    for (size_t i = 0; i < mBatch.size(); i++)
+    {
+        auto& current = mBatch[i];
+
+        // A move followed straight away by another with the button the same is replaced by it
+        if (current.GetType() == Types::MouseMove && i + 1 < mBatch.size() &&
+            mBatch[i + 1].GetType() == Types::MouseMove && mBatch[i + 1].GetValue() == current.GetValue())
+        {
+            continue;
+        }
+
+        if (log != nullptr)
+        {
+            log->Record(current);
+        }
+        current.Apply(game);
+        applied++;
+    }
+
+    mApplied += applied;
+    return applied;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file CommandQueue.h
+ * @author Attulya Pratap Gupta
+ *
+ * Bounded lock-free queue of user actions applied at tick boundaries
+ */
+
+#ifndef COMMANDQUEUE_H
+#define COMMANDQUEUE_H
+
+#include <vector>
+
+#include "InputEvent.h"
+#include "SpscQueue.h"
+
+class Game;
+class InputLog;
+
+/**
+ * Carries user actions from the window to the game.
+ *
+ * The window posts every circuit edit and conveyor control as an
+ * InputEvent instead of calling Game itself, and whoever owns the game
+ * applies them all at the next tick boundary. Mouse moves are positions,
+ * not offsets, so when several arrive between ticks with the button in
+ * the same state only the last one is applied. A fast mouse then costs
+ * one drag update a tick however many motion events it sends.
+ */
+class CommandQueue
+{
+private:
+    /// Actions waiting to be applied
+    SpscQueue<InputEvent> mQueue;
+
+    /// Actions taken from the queue for the batch being applied
+    std::vector<InputEvent> mBatch;
+
+    /// Number of actions posted
+    int mPosted = 0;
+
+    /// Number of actions applied
+    int mApplied = 0;
+
+    /// Number of actions dropped because the queue was full
+    int mDropped = 0;
+
+public:
+    /// Number of actions that can be waiting at once when none is given
+    static const int DefaultCapacity = 1024;
+
+    explicit CommandQueue(size_t capacity = DefaultCapacity);
+
+    bool Post(const InputEvent& event);
+    int Apply(Game* game, InputLog* log = nullptr);
+
+    /**
+     * Is anything waiting to be applied?
+     * @return True if the queue is empty
+     */
+    bool IsEmpty() const { return mQueue.IsEmpty(); }
+
+    /**
+     * Get the number of actions posted, only read by the window
+     * @return Number of actions
+     */
+    int GetPostedCount() const { return mPosted; }
+
+    /**
+     * Get the number of actions applied, only read by whoever applies them
+     * @return Number of actions, less than posted by the number coalesced
+     */
+    int GetAppliedCount() const { return mApplied; }
+
+    /**
+     * Get the number of actions dropped because the queue was full, only read by the window
+     * @return Number of actions
+     */
+    int GetDroppedCount() const { return mDropped; }
+};
+
+#endif //COMMANDQUEUE_H
@@ -0,0 +1,641 @@
+/**
+ * @file CompiledCircuit.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "CompiledCircuit.h"
+#include "GateKernels.h"
+#include "Pin.h"
+#include "ThreadPool.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <tuple>
+
+/**
+ * Get the value of a signal from the state of a pin
+ * @param pin Pin to read
+ * @return SignalZero, SignalOne or SignalUnknown
+ */
+unsigned char CompiledCircuit::ReadPin(Pin* pin)
+{
+    if (pin->IsOne())
+    {
+        return SignalOne;
+    }
+
+    return pin->IsZero() ? SignalZero : SignalUnknown;
+}
+
+/**
+ * Set the state of a pin from the value of a signal
+ * @param pin Pin to set
+ * @param value SignalZero, SignalOne or SignalUnknown
+ */
+void CompiledCircuit::WritePin(Pin* pin, unsigned char value)
+{
+    if (value == SignalOne)
+    {
+        pin->SetOne();
+    }
+    else if (value == SignalZero)
+    {
+        pin->SetZero();
+    }
+    else
+    {
+        pin->SetUnknown();
+    }
+}
+
+/**
+ * Add a signal that is not driven by any node yet
+ * @param value Initial value of the signal
+ * @return Index of the new signal
+ */
+int CompiledCircuit::AddSignal(unsigned char value)
+{
+    mSignals.push_back(value);
+    return int(mSignals.size()) - 1;
+}
+
+/**
+ * Get the number of outputs a kind of node has
+ * @param type Kind of node
+ * @return 2 for flip flops, 1 otherwise
+ */
+int CompiledCircuit::GetOutputCount(NodeTypes type)
+{
+    return type == NodeTypes::SRFlipFlop || type == NodeTypes::DFlipFlop ? 2 : 1;
+}
+
+/**
+ * Add a node that drives signals that already exist
+ * @param type What the node computes
+ * @param inputs Input signals, S then R for an SR flip flop and D then clock for a D flip flop
+ * @param outputs Output signals, Q then Q' for flip flops
+ * @param table Truth table for a Lut node
+ * @return Index of the new node
+ */
+int CompiledCircuit::AddNode(NodeTypes type, const std::vector<int>& inputs, const std::vector<int>& outputs,
+                             uint64_t table)
+{
+    Node node;
+    node.mType = type;
+    node.mFirstInput = int(mInputs.size());
+    node.mInputCount = int(inputs.size());
+    node.mTable = table;
+    for (int port = 0; port < GetOutputCount(type) && port < int(outputs.size()); port++)
+    {
+        node.mOutputs[port] = outputs[port];
+    }
+
+    mInputs.insert(mInputs.end(), inputs.begin(), inputs.end());
+    mNodes.push_back(node);
+    mClocks.push_back(SignalZero);
+    return int(mNodes.size()) - 1;
+}
+
+/**
+ * Add a node along with new signals for its outputs
+ * @param type What the node computes
+ * @param inputs Input signals
+ * @param table Truth table for a Lut node
+ * @return Index of the new node, see GetOutput for its outputs
+ */
+int CompiledCircuit::AddNode(NodeTypes type, const std::vector<int>& inputs, uint64_t table)
+{
+    std::vector<int> outputs;
+    for (int port = 0; port < GetOutputCount(type); port++)
+    {
+        outputs.push_back(AddSignal());
+    }
+
+    return AddNode(type, inputs, outputs, table);
+}
+
+/**
+ * Put the nodes in dependency order once they have all been added.
+ *
+ * Nodes in a feedback loop have no such order, so each loop is evaluated
+ * as one step in the order its nodes were added, the way the gates update
+ * when the loop is only closed through a flip flop's held state. Nodes
+ * the loop drives are levelled after it and only read its new values.
+ */
+void CompiledCircuit::Finalize()
+{
+    TraceScope trace("CompiledCircuit::Finalize", "circuit");
+
+    // Which node drives each signal
+    std::vector<int> drivers(mSignals.size(), -1);
+    for (int n = 0; n < int(mNodes.size()); n++)
+    {
+        for (auto output : mNodes[n].mOutputs)
+        {
+            if (output >= 0)
+            {
+                drivers[output] = n;
+            }
+        }
+    }
+
+    // List who reads each node
+    std::vector<std::vector<int>> readers(mNodes.size());
+    for (int n = 0; n < int(mNodes.size()); n++)
+    {
+        auto& node = mNodes[n];
+        for (int i = 0; i < node.mInputCount; i++)
+        {
+            auto driver = drivers[mInputs[node.mFirstInput + i]];
+            if (driver >= 0)
+            {
+                readers[driver].push_back(n);
+            }
+        }
+    }
+
+    // Nodes that read each other's outputs, directly or not, form a loop
+    std::vector<int> components;
+    int componentCount = FindComponents(readers, components);
+
+    std::vector<int> sizes(componentCount, 0);
+    for (auto component : components)
+    {
+        sizes[component]++;
+    }
+
+    std::vector<int> loops(mNodes.size(), -1);
+    for (int n = 0; n < int(mNodes.size()); n++)
+    {
+        bool selfLoop = std::find(readers[n].begin(), readers[n].end(), n) != readers[n].end();
+        if (sizes[components[n]] > 1 || selfLoop)
+        {
+            loops[n] = components[n];
+        }
+    }
+
+    // Visit the nodes a component at a time, every component after the ones it reads from
+    mOrder.resize(mNodes.size());
+    for (int n = 0; n < int(mNodes.size()); n++)
+    {
+        mOrder[n] = n;
+    }
+    auto byComponent = mOrder;
+    std::sort(byComponent.begin(), byComponent.end(), [&components](int a, int b) {
+        return components[a] < components[b];
+    });
+
+    // Level each component by its longest path from the sources. A loop is
+    // one step, so the nodes it drives are levelled after it like any others
+    std::vector<int> componentLevels(componentCount, 0);
+    for (auto n : byComponent)
+    {
+        for (auto reader : readers[n])
+        {
+            if (components[reader] != components[n])
+            {
+                componentLevels[components[reader]] =
+                    std::max(componentLevels[components[reader]], componentLevels[components[n]] + 1);
+            }
+        }
+    }
+
+    std::vector<int> levels(mNodes.size());
+    for (int n = 0; n < int(mNodes.size()); n++)
+    {
+        levels[n] = componentLevels[components[n]];
+    }
+
+    Schedule(levels, loops);
+}
+
+/**
+ * Find the strongly connected components of the nodes with Tarjan's
+ * algorithm, without recursion so large circuits cannot overflow the stack.
+ *
+ * @param readers Nodes that read the output of each node
+ * @param components Set to the component of each node. Components are
+ * numbered so a node only reads from its own component or lower numbered ones
+ * @return Number of components
+ */
+int CompiledCircuit::FindComponents(const std::vector<std::vector<int>>& readers, std::vector<int>& components)
+{
+    int count = int(readers.size());
+    std::vector<int> index(count, -1);
+    std::vector<int> low(count, 0);
+    std::vector<bool> onStack(count, false);
+    std::vector<int> stack;
+    components.assign(count, -1);
+
+    // Nodes being searched, with the next reader of each to look at
+    std::vector<std::pair<int, size_t>> calls;
+    int nextIndex = 0;
+    int found = 0;
+
+    auto enter = [&](int n) {
+        index[n] = low[n] = nextIndex++;
+        stack.push_back(n);
+        onStack[n] = true;
+        calls.emplace_back(n, 0);
+    };
+
+    for (int root = 0; root < count; root++)
+    {
+        if (index[root] >= 0)
+        {
+            continue;
+        }
+
+        enter(root);
+        while (!calls.empty())
+        {
+            int n = calls.back().first;
+            if (calls.back().second < readers[n].size())
+            {
+                int reader = readers[n][calls.back().second++];
+                if (index[reader] < 0)
+                {
+                    enter(reader);
+                }
+                else if (onStack[reader])
+                {
+                    low[n] = std::min(low[n], index[reader]);
+                }
+                continue;
+            }
+
+            calls.pop_back();
+            if (!calls.empty())
+            {
+                int caller = calls.back().first;
+                low[caller] = std::min(low[caller], low[n]);
+            }
+
+            if (low[n] == index[n])
+            {
+                int member;
+                do
+                {
+                    member = stack.back();
+                    stack.pop_back();
+                    onStack[member] = false;
+                    components[member] = found;
+                } while (member != n);
+                found++;
+            }
+        }
+    }
+
+    // Tarjan's algorithm finds a component after every component it drives
+    for (auto& component : components)
+    {
+        component = found - 1 - component;
+    }
+    return found;
+}
+
+/**
+ * Group the nodes into buckets of the same level, type and number of inputs.
+ *
+ * Nodes of one level do not read each other's outputs, so they can be
+ * evaluated in any order. Sorting them by type and number of inputs
+ * lets each bucket use one kernel in one loop. A feedback loop is evaluated
+ * after the other nodes of its level, its nodes together and in the order they
+ * were added in.
+ *
+ * @param levels Level of each node
+ * @param loops Feedback loop each node is in, -1 for nodes not in a loop
+ */
+void CompiledCircuit::Schedule(const std::vector<int>& levels, const std::vector<int>& loops)
+{
+    auto key = [this, &levels, &loops](int n) {
+        bool loop = loops[n] >= 0;
+        return std::make_tuple(levels[n], loop, loop ? loops[n] : int(mNodes[n].mType),
+                               loop ? 0 : mNodes[n].mInputCount);
+    };
+    std::stable_sort(mOrder.begin(), mOrder.end(), [&key](int a, int b) {
+        return key(a) < key(b);
+    });
+
+    mBuckets.clear();
+    mScheduledInputs.clear();
+    mScheduledOutputs.clear();
+    mScheduledTables.clear();
+    for (int k = 0; k < int(mOrder.size()); k++)
+    {
+        auto& node = mNodes[mOrder[k]];
+        bool loop = loops[mOrder[k]] >= 0;
+        int level = loop ? -1 : levels[mOrder[k]];
+
+        auto kernel = loop ? nullptr : GateKernels::FindRun(node.mType, node.mInputCount);
+
+        // Nodes without a kernel are evaluated one at a time, so their inputs may differ
+        if (mBuckets.empty() || mBuckets.back().mKernel != kernel || mBuckets.back().mLevel != level ||
+            (kernel != nullptr && mBuckets.back().mArity != node.mInputCount))
+        {
+            Bucket bucket;
+            bucket.mKernel = kernel;
+            bucket.mLevel = level;
+            bucket.mFirst = k;
+            bucket.mArity = node.mInputCount;
+            bucket.mFirstInput = int(mScheduledInputs.size());
+            mBuckets.push_back(bucket);
+        }
+        mBuckets.back().mCount++;
+
+        mScheduledInputs.insert(mScheduledInputs.end(), mInputs.begin() + node.mFirstInput,
+                                mInputs.begin() + node.mFirstInput + node.mInputCount);
+        mScheduledOutputs.push_back(node.mOutputs[0]);
+        mScheduledTables.push_back(node.mTable);
+    }
+
+    mLevelStarts.clear();
+    for (int b = 0; b < int(mBuckets.size()); b++)
+    {
+        if (b == 0 || mBuckets[b].mLevel != mBuckets[b - 1].mLevel)
+        {
+            mLevelStarts.push_back(b);
+        }
+    }
+    mLevelStarts.push_back(int(mBuckets.size()));
+}
+
+/**
+ * Read every source pin into its signal
+ */
+void CompiledCircuit::LoadSources()
+{
+    for (auto& source : mSources)
+    {
+        mSignals[source.first] = ReadPin(source.second);
+    }
+}
+
+/**
+ * Evaluate every node once, in dependency order.
+ * Circuits of at least the parallel threshold are evaluated on the thread pool.
+ */
+void CompiledCircuit::Evaluate()
+{
+    if (GetNodeCount() >= mParallelThreshold)
+    {
+        EvaluateParallel();
+        return;
+    }
+
+    for (auto& bucket : mBuckets)
+    {
+        EvaluateBucket(bucket, bucket.mFirst, bucket.mFirst + bucket.mCount);
+    }
+}
+
+/**
+ * Evaluate every node once, one level at a time on the thread pool.
+ *
+ * Nodes of a level only read signals from earlier levels, so a level is
+ * split into chunks that the threads evaluate at the same time, and the
+ * next level starts once they have all finished. Levels too small to be
+ * worth splitting and nodes in feedback loops are evaluated on this thread.
+ */
+void CompiledCircuit::EvaluateParallel()
+{
+    TraceScope trace("CompiledCircuit::EvaluateParallel", "circuit");
+
+    auto& pool = ThreadPool::Get();
+    for (int l = 0; l + 1 < int(mLevelStarts.size()); l++)
+    {
+        int firstBucket = mLevelStarts[l];
+        int lastBucket = mLevelStarts[l + 1];
+        int begin = mBuckets[firstBucket].mFirst;
+        int end = mBuckets[lastBucket - 1].mFirst + mBuckets[lastBucket - 1].mCount;
+
+        if (mBuckets[firstBucket].mLevel < 0 || end - begin < ParallelChunk * 2)
+        {
+            EvaluateLevel(firstBucket, lastBucket, begin, end);
+            continue;
+        }
+
+        pool.ParallelFor(end - begin, ParallelChunk, [this, firstBucket, lastBucket, begin](int from, int to) {
+            EvaluateLevel(firstBucket, lastBucket, begin + from, begin + to);
+        });
+    }
+}
+
+/**
+ * Evaluate part of a level
+ * @param firstBucket First bucket of the level
+ * @param lastBucket One past the last bucket of the level
+ * @param begin Index in the evaluation order of the first node to evaluate
+ * @param end One past the index of the last node to evaluate
+ */
+void CompiledCircuit::EvaluateLevel(int firstBucket, int lastBucket, int begin, int end)
+{
+    for (int b = firstBucket; b < lastBucket; b++)
+    {
+        auto& bucket = mBuckets[b];
+        int from = std::max(begin, bucket.mFirst);
+        int to = std::min(end, bucket.mFirst + bucket.mCount);
+        if (from < to)
+        {
+            EvaluateBucket(bucket, from, to);
+        }
+    }
+}
+
+/**
+ * Evaluate some of the nodes of one bucket
+ * @param bucket The bucket
+ * @param begin Index in the evaluation order of the first node to evaluate
+ * @param end One past the index of the last node to evaluate
+ */
+void CompiledCircuit::EvaluateBucket(const Bucket& bucket, int begin, int end)
+{
+    if (bucket.mKernel != nullptr)
+    {
+        auto offset = begin - bucket.mFirst;
+        bucket.mKernel(mSignals.data(), mScheduledInputs.data() + bucket.mFirstInput + offset * bucket.mArity,
+                       mScheduledOutputs.data() + begin, mScheduledTables.data() + begin,
+                       bucket.mArity, end - begin);
+        return;
+    }
+
+    for (int k = begin; k < end; k++)
+    {
+        EvaluateNode(mNodes[mOrder[k]], mOrder[k]);
+    }
+}
+
+/**
+ * Set every sink pin from its signal
+ */
+void CompiledCircuit::StoreSinks()
+{
+    for (auto& sink : mSinks)
+    {
+        WritePin(sink.second, mSignals[sink.first]);
+    }
+}
+
+/**
+ * Read the sources, evaluate the circuit and set the sinks
+ */
+void CompiledCircuit::Run()
+{
+    LoadSources();
+    Evaluate();
+    StoreSinks();
+}
+
+/**
+ * Compute the outputs of one node.
+ *
+ * As with the gates, any unknown input makes the output of a
+ * combinational node unknown.
+ *
+ * @param node The node
+ * @param index Index of the node
+ */
+void CompiledCircuit::EvaluateNode(const Node& node, int index)
+{
+    auto inputs = mInputs.data() + node.mFirstInput;
+    auto& q = mSignals[node.mOutputs[0]];
+
+    switch (node.mType)
+    {
+    case NodeTypes::SRFlipFlop:
+        {
+            auto s = mSignals[inputs[0]];
+            auto r = mSignals[inputs[1]];
+            auto& qNot = mSignals[node.mOutputs[1]];
+            if (s == SignalOne && r == SignalOne)
+            {
+                q = qNot = SignalUnknown;
+            }
+            else if (s == SignalOne)
+            {
+                q = SignalOne;
+                qNot = SignalZero;
+            }
+            else if (r == SignalOne)
+            {
+                q = SignalZero;
+                qNot = SignalOne;
+            }
+            return;
+        }
+
+    case NodeTypes::DFlipFlop:
+        {
+            // Latch D on the rising edge of the clock
+            auto clock = mSignals[inputs[1]] == SignalOne ? SignalOne : SignalZero;
+            if (clock == SignalOne && mClocks[index] == SignalZero)
+            {
+                auto d = mSignals[inputs[0]];
+                q = d;
+                mSignals[node.mOutputs[1]] = d == SignalUnknown ? SignalUnknown : (d ^ 1);
+            }
+            mClocks[index] = clock;
+            return;
+        }
+
+    default:
+        break;
+    }
+
+    unsigned char values[64];
+    for (int i = 0; i < node.mInputCount && i < 64; i++)
+    {
+        values[i] = mSignals[inputs[i]];
+    }
+
+    q = EvaluateCombinational(node.mType, values, std::min(node.mInputCount, 64), node.mTable);
+}
+
+/**
+ * Compute the output of a node that holds no state.
+ *
+ * As with the gates, any unknown input makes the output unknown.
+ *
+ * @param type What the node computes, must not be a flip flop
+ * @param values Values of the inputs
+ * @param count Number of inputs
+ * @param table Truth table for a Lut node
+ * @return SignalZero, SignalOne or SignalUnknown
+ */
+unsigned char CompiledCircuit::EvaluateCombinational(NodeTypes type, const unsigned char* values, int count,
+                                                     uint64_t table)
+{
+    // Pack the known inputs into bits, input i in bit i
+    uint64_t bits = 0;
+    int ones = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (values[i] == SignalUnknown)
+        {
+            return SignalUnknown;
+        }
+        bits |= uint64_t(values[i]) << i;
+        ones += values[i];
+    }
+
+    bool one = false;
+    switch (type)
+    {
+    case NodeTypes::And:
+        one = ones == count;
+        break;
+
+    case NodeTypes::Or:
+        one = ones > 0;
+        break;
+
+    case NodeTypes::Xor:
+        one = (ones & 1) != 0;
+        break;
+
+    case NodeTypes::Not:
+        one = ones == 0;
+        break;
+
+    case NodeTypes::Lut:
+        one = ((table >> bits) & 1) != 0;
+        break;
+
+    default:
+        return SignalUnknown;
+    }
+
+    return one ? SignalOne : SignalZero;
+}
+
+/**
+ * Save the value of every signal and the clocks of the flip flops
+ * @param state Buffer to save into
+ */
+void CompiledCircuit::SaveState(GameState* state) const
+{
+    for (auto value : mSignals)
+    {
+        state->Put(value);
+    }
+    for (auto clock : mClocks)
+    {
+        state->Put(clock);
+    }
+}
+
+/**
+ * Restore the value of every signal and the clocks of the flip flops
+ * @param state Buffer to restore from
+ */
+void CompiledCircuit::RestoreState(GameState* state)
+{
+    for (auto& value : mSignals)
+    {
+        state->Get(value);
+    }
+    for (auto& clock : mClocks)
+    {
+        state->Get(clock);
+    }
+}
@@ -0,0 +1,280 @@
+/**
+ * @file CompiledCircuit.h
+ * @author Attulya Pratap Gupta
+ *
+ * Flat netlist of a circuit that is evaluated without visiting the gates
+ */
+
+#ifndef COMPILEDCIRCUIT_H
+#define COMPILEDCIRCUIT_H
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+#include "GameState.h"
+
+class Pin;
+
+/// Value of a signal that is zero
+const unsigned char SignalZero = 0;
+
+/// Value of a signal that is one
+const unsigned char SignalOne = 1;
+
+/// Value of a signal that is unknown
+const unsigned char SignalUnknown = 2;
+
+/**
+ * Flat netlist of a circuit.
+ *
+ * Every wire is a signal, an index into one array of values, and every
+ * gate is a node that reads its input signals and writes its output
+ * signals. The nodes are kept in dependency order, so evaluating the
+ * circuit is one pass over an array with no virtual calls or visitors.
+ *
+ * Signals can be bound to pins of the game. Source pins are read into
+ * their signals before evaluating and sink pins are set from their
+ * signals afterwards, so the pins show the same states as if each gate
+ * had updated itself.
+ */
+class CompiledCircuit
+{
+public:
+    /// The kinds of node
+    enum class NodeTypes : unsigned char {And, Or, Xor, Not, Lut, SRFlipFlop, DFlipFlop};
+
+    /// A gate in the netlist
+    struct Node
+    {
+        NodeTypes mType = NodeTypes::And; ///< What the node computes
+        int mFirstInput = 0;              ///< Index of the first input in the input array
+        int mInputCount = 0;              ///< Number of inputs
+        int mOutputs[2] = {-1, -1};       ///< Output signals, the second only for flip flops
+        uint64_t mTable = 0;              ///< Truth table of a Lut node
+    };
+
+    /// Number of nodes at which levels are evaluated in parallel by default
+    static const int ParallelThreshold = 100000;
+
+    /// Fewest nodes of a level handed to one thread at a time
+    static const int ParallelChunk = 4096;
+
+    /// Function that computes the output of a combinational node, see GateKernels
+    using Kernel = unsigned char (*)(const unsigned char* signals, const int* inputs, int count, uint64_t table);
+
+    /// Function that computes the outputs of a run of combinational nodes, see GateKernels
+    using RunKernel = void (*)(unsigned char* signals, const int* inputs, const int* outputs, const uint64_t* tables,
+                               int arity, int count);
+
+    /**
+     * Nodes of the same level, type and number of inputs, evaluated together.
+     * Their inputs, outputs and tables are stored one after another in
+     * evaluation order, so a bucket is one loop over contiguous arrays.
+     */
+    struct Bucket
+    {
+        RunKernel mKernel = nullptr; ///< Kernel for the bucket, nullptr to evaluate node by node
+        int mLevel = 0;              ///< Longest path from the sources, -1 for nodes in feedback loops
+        int mFirst = 0;              ///< Index of the first node of the bucket in the evaluation order
+        int mCount = 0;              ///< Number of nodes
+        int mArity = 0;              ///< Number of inputs of each node
+        int mFirstInput = 0;         ///< Index of the first input of the bucket in the scheduled inputs
+    };
+
+private:
+    /// The nodes, in the order they were added
+    std::vector<Node> mNodes;
+
+    /// Input signals of every node, one run per node
+    std::vector<int> mInputs;
+
+    /// Current value of every signal
+    std::vector<unsigned char> mSignals;
+
+    /// Clock seen by each node on the last evaluation, used by D flip flops
+    std::vector<unsigned char> mClocks;
+
+    /// Order to evaluate the nodes in
+    std::vector<int> mOrder;
+
+    /// Buckets of nodes evaluated together, in evaluation order
+    std::vector<Bucket> mBuckets;
+
+    /// Input signals of every node in evaluation order
+    std::vector<int> mScheduledInputs;
+
+    /// Output signal of every node in evaluation order
+    std::vector<int> mScheduledOutputs;
+
+    /// Truth table of every node in evaluation order
+    std::vector<uint64_t> mScheduledTables;
+
+    /// Index of the first bucket of each level, then one past the last bucket
+    std::vector<int> mLevelStarts;
+
+    /// Number of nodes at which levels are evaluated on the thread pool
+    int mParallelThreshold = ParallelThreshold;
+
+    static int FindComponents(const std::vector<std::vector<int>>& readers, std::vector<int>& components);
+    void Schedule(const std::vector<int>& levels, const std::vector<int>& loops);
+    void EvaluateBucket(const Bucket& bucket, int begin, int end);
+    void EvaluateLevel(int firstBucket, int lastBucket, int begin, int end);
+
+    /// Pins read into signals before evaluating
+    std::vector<std::pair<int, Pin*>> mSources;
+
+    /// Pins set from signals after evaluating
+    std::vector<std::pair<int, Pin*>> mSinks;
+
+    /// Signals whose values matter outside the circuit, such as Sparty's input
+    std::vector<int> mRoots;
+
+    void EvaluateNode(const Node& node, int index);
+
+public:
+    static unsigned char ReadPin(Pin* pin);
+    static void WritePin(Pin* pin, unsigned char value);
+
+    int AddSignal(unsigned char value = SignalUnknown);
+    int AddNode(NodeTypes type, const std::vector<int>& inputs, const std::vector<int>& outputs, uint64_t table = 0);
+    int AddNode(NodeTypes type, const std::vector<int>& inputs, uint64_t table = 0);
+
+    static int GetOutputCount(NodeTypes type);
+    static unsigned char EvaluateCombinational(NodeTypes type, const unsigned char* values, int count,
+                                               uint64_t table = 0);
+
+    /**
+     * Bind a pin to be read into a signal before each evaluation
+     * @param signal Signal to set
+     * @param pin Pin to read
+     */
+    void BindSource(int signal, Pin* pin) { mSources.emplace_back(signal, pin); }
+
+    /**
+     * Bind a pin to be set from a signal after each evaluation
+     * @param signal Signal to read
+     * @param pin Pin to set
+     */
+    void BindSink(int signal, Pin* pin) { mSinks.emplace_back(signal, pin); }
+
+    /**
+     * Mark a signal as one whose value matters outside the circuit
+     * @param signal Signal index
+     */
+    void AddRoot(int signal) { mRoots.push_back(signal); }
+
+    /**
+     * Set the clock a D flip flop node saw on its last evaluation
+     * @param node Node index
+     * @param clock SignalZero or SignalOne
+     */
+    void SetClock(int node, unsigned char clock) { mClocks[node] = clock; }
+
+    /**
+     * Get the clock a D flip flop node saw on its last evaluation
+     * @param node Node index
+     * @return SignalZero or SignalOne
+     */
+    unsigned char GetClock(int node) const { return mClocks[node]; }
+
+    void Finalize();
+    void LoadSources();
+    void Evaluate();
+    void EvaluateParallel();
+    void StoreSinks();
+    void Run();
+
+    void SaveState(GameState* state) const;
+    void RestoreState(GameState* state);
+
+    /**
+     * Get the value of a signal
+     * @param signal Signal index
+     * @return SignalZero, SignalOne or SignalUnknown
+     */
+    unsigned char GetSignal(int signal) const { return mSignals[signal]; }
+
+    /**
+     * Set the value of a signal
+     * @param signal Signal index
+     * @param value SignalZero, SignalOne or SignalUnknown
+     */
+    void SetSignal(int signal, unsigned char value) { mSignals[signal] = value; }
+
+    /**
+     * Get an output signal of a node
+     * @param node Node index
+     * @param port 0 for the first output, 1 for the second output of a flip flop
+     * @return Signal index
+     */
+    int GetOutput(int node, int port = 0) const { return mNodes[node].mOutputs[port]; }
+
+    /**
+     * Get the number of signals
+     * @return Number of signals
+     */
+    int GetSignalCount() const { return int(mSignals.size()); }
+
+    /**
+     * Get the number of nodes
+     * @return Number of nodes
+     */
+    int GetNodeCount() const { return int(mNodes.size()); }
+
+    /**
+     * Get the nodes in the order they were added
+     * @return The nodes
+     */
+    const std::vector<Node>& GetNodes() const { return mNodes; }
+
+    /**
+     * Get the input signals of every node
+     * @return Flat array of inputs, indexed by Node::mFirstInput
+     */
+    const std::vector<int>& GetInputs() const { return mInputs; }
+
+    /**
+     * Get the order the nodes are evaluated in
+     * @return Node indices
+     */
+    const std::vector<int>& GetOrder() const { return mOrder; }
+
+    /**
+     * Get the buckets of nodes evaluated together
+     * @return Buckets in evaluation order
+     */
+    const std::vector<Bucket>& GetBuckets() const { return mBuckets; }
+
+    /**
+     * Get the number of levels, counting the nodes in feedback loops as one
+     * @return Number of levels
+     */
+    int GetLevelCount() const { return mLevelStarts.empty() ? 0 : int(mLevelStarts.size()) - 1; }
+
+    /**
+     * Set the number of nodes at which Evaluate uses the thread pool
+     * @param threshold Number of nodes, 0 to always evaluate in parallel
+     */
+    void SetParallelThreshold(int threshold) { mParallelThreshold = threshold; }
+
+    /**
+     * Get the pins read into signals
+     * @return Pairs of signal and pin
+     */
+    const std::vector<std::pair<int, Pin*>>& GetSources() const { return mSources; }
+
+    /**
+     * Get the pins set from signals
+     * @return Pairs of signal and pin
+     */
+    const std::vector<std::pair<int, Pin*>>& GetSinks() const { return mSinks; }
+
+    /**
+     * Get the signals whose values matter outside the circuit
+     * @return Signal indices
+     */
+    const std::vector<int>& GetRoots() const { return mRoots; }
+};
+
+#endif //COMPILEDCIRCUIT_H
@@ -8,7 +8,10 @@
 #include "Conveyor.h"
 #include "Game.h"
 #include "ItemFinder.h"
+#include "ScoreboardVisitor.h"
+#include "ProductParker.h"
 #include "VisitorBase.h"
+#include "TraceRecorder.h"
 
 using namespace std;
 
@@ -38,6 +41,8 @@ const wxRect StopButtonRect(35, 87, 95, 36);
  */
 Conveyor::Conveyor(Level* level) : Item(level->GetGame())
 {
+    TraceScope trace("Conveyor::DecodeImages", "asset");
+
     mBackgroundImage = make_unique<wxImage>(ConveyorBackgroundImage, wxBITMAP_TYPE_PNG);
     mBackgroundBitmap = make_unique<wxBitmap>(*mBackgroundImage);
 
@@ -64,6 +69,8 @@ Conveyor::~Conveyor()
  */
 void Conveyor::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
+    TraceScope trace("Conveyor::Draw", "paint");
+
     // Calculate width based on aspect ratio if not set
     if (GetWidth() <= 0 && mBackgroundImage && mBackgroundImage->IsOk())
     {
@@ -124,6 +131,8 @@ void Conveyor::Draw(std::shared_ptr<wxGraphicsContext> graphics)
  */
 void Conveyor::Update(double elapsed)
 {
+    TraceScope trace("Conveyor::Update", "update");
+
     if (mIsRunning)
     {
         mBeltPosition += mSpeed * elapsed;
@@ -139,8 +148,36 @@ void Conveyor::Update(double elapsed)
         auto visitor = std::make_shared<ItemFinder>();
         GetGame()->Accept(visitor.get());
         visitor->MoveProducts(elapsed, mSpeed);
+
+        // Recycle products that have left and place the ones about to arrive
+        GetGame()->GetLevel()->UpdateProductStreams(this, mSpeed * elapsed);
+
+        // Take products that are done with out of play
+        ProductParker parker;
+        GetGame()->Accept(&parker);
     }
 }
+
+/**
+ * Save the belt position and whether the belt is running
+ * @param state Buffer to save into
+ */
+void Conveyor::SaveState(GameState* state)
+{
+    state->Put(mBeltPosition);
+    state->Put(mIsRunning);
+}
+
+/**
+ * Restore the belt position and whether the belt is running
+ * @param state Buffer to restore from
+ */
+void Conveyor::RestoreState(GameState* state)
+{
+    state->Get(mBeltPosition);
+    state->Get(mIsRunning);
+}
+
 /**
  * Load the XML for the conveyor
  * @param node The XML node to load from
@@ -193,9 +230,22 @@ void Conveyor::Stop()
  */
 void Conveyor::ResetProducts()
 {
+    // Parked products go back on the belt too
     auto visitor = std::make_shared<ItemFinder>();
     GetGame()->Accept(visitor.get());
+    GetGame()->AcceptParked(visitor.get());
     visitor->ResetProducts(this);
+    GetGame()->UnparkItems();
+
+    // Products that passed the beam before the reset are no longer scored
+    ScoreboardVisitor scoreboardVisitor;
+    GetGame()->Accept(&scoreboardVisitor);
+    scoreboardVisitor.ClearPassedProducts();
+
+    // Streamed products start over from the first one
+    GetGame()->GetLevel()->ResetProductStreams();
+
+    GetGame()->GetLevel()->ResetProductsRemaining();
 }
 
 /**
@@ -223,10 +273,12 @@ void Conveyor::OnClick(int x, int y)
 
     if (StartButtonRect.Contains(testX, testY))
     {
+        TraceRecorder::Get().Instant("Conveyor::Start", "input");
         Start();
     }
     else if (StopButtonRect.Contains(testX, testY))
     {
+        TraceRecorder::Get().Instant("Conveyor::Stop", "input");
         Stop();
     }
 }
@@ -0,0 +1,105 @@
+/**
+ * @file Conveyor.h
+ * @author Attulya Pratap Gupta
+ *
+ * Class for the conveyor belt the products ride on
+ */
+
+#ifndef CONVEYOR_H
+#define CONVEYOR_H
+
+#include <memory>
+
+#include "Item.h"
+
+class Level;
+
+/**
+ * Class for the conveyor belt the products ride on
+ */
+class Conveyor : public Item
+{
+private:
+    /// Image for the background of the conveyor
+    std::unique_ptr<wxImage> mBackgroundImage;
+    /// Bitmap for the background of the conveyor
+    std::unique_ptr<wxBitmap> mBackgroundBitmap;
+
+    /// Image for the belt
+    std::unique_ptr<wxImage> mBeltImage;
+    /// Bitmap for the belt
+    std::unique_ptr<wxBitmap> mBeltBitmap;
+
+    /// Image for the control panel when stopped
+    std::unique_ptr<wxImage> mPanelStoppedImage;
+    /// Bitmap for the control panel when stopped
+    std::unique_ptr<wxBitmap> mPanelStoppedBitmap;
+
+    /// Image for the control panel when started
+    std::unique_ptr<wxImage> mPanelStartedImage;
+    /// Bitmap for the control panel when started
+    std::unique_ptr<wxBitmap> mPanelStartedBitmap;
+
+    double mInitialX = 0; ///< X location of the conveyor as loaded
+    double mInitialY = 0; ///< Y location of the conveyor as loaded
+
+    /// How far the belt has moved in pixels
+    double mBeltPosition = 0;
+
+    /// Belt position when the conveyor was loaded
+    double mInitialBeltPosition = 0;
+
+    /// Is the belt running?
+    bool mIsRunning = false;
+
+    /// Speed of the belt in pixels per second
+    double mSpeed = 0;
+
+    /// Height of the conveyor in pixels
+    double mHeight = 0;
+
+    /// Location of the control panel relative to the conveyor
+    wxPoint mPanelLocation;
+
+public:
+    /// Default constructor (disabled)
+    Conveyor() = delete;
+
+    /// Copy constructor (disabled)
+    Conveyor(const Conveyor&) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const Conveyor&) = delete;
+
+    Conveyor(Level* level);
+    virtual ~Conveyor();
+
+    void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void Update(double elapsed) override;
+    void XmlLoad(wxXmlNode* node) override;
+    bool HitTest(int x, int y) override;
+    void Accept(VisitorBase* visitor) override;
+    void SaveState(GameState* state) override;
+    void RestoreState(GameState* state) override;
+
+    void Start();
+    void Stop();
+    void ResetProducts();
+    void OnClick(int x, int y);
+    void SetPanel(double x, double y);
+    double GetProductY(double placement) const;
+
+    /**
+     * Get the speed of the belt
+     * @return Speed in pixels per second
+     */
+    double GetSpeed() const { return mSpeed; }
+
+    /**
+     * Get the location of the control panel
+     * @return Location relative to the conveyor in pixels
+     */
+    wxPoint GetPanelLocation() const { return mPanelLocation; }
+};
+
+#endif //CONVEYOR_H
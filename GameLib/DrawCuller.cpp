@@ -0,0 +1,97 @@
+/**
+ * @file DrawCuller.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "DrawCuller.h"
+#include "Item.h"
+#include "TraceRecorder.h"
+#include <cmath>
+
+/// Size assumed for an item that has not been given one yet, in virtual pixels
+const double DefaultCullSize = 100;
+
+/**
+ * Set the part of the game the window shows.
+ *
+ * Uses the same transform as Game::OnDraw, which draws at
+ * (x * scale + xOffset, y * scale + yOffset) in window pixels.
+ *
+ * @param width Width of the window in pixels
+ * @param height Height of the window in pixels
+ * @param scale Amount drawing is scaled by
+ * @param xOffset X offset of the virtual window in pixels
+ * @param yOffset Y offset of the virtual window in pixels
+ */
+void DrawCuller::SetWindow(int width, int height, double scale, double xOffset, double yOffset)
+{
+    mLeft = -xOffset / scale;
+    mTop = -yOffset / scale;
+    mRight = (width - xOffset) / scale;
+    mBottom = (height - yOffset) / scale;
+}
+
+/**
+ * Convert an area in virtual pixels to the window pixels it covers,
+ * using the same transform as SetWindow
+ * @param rect Area in virtual pixels
+ * @param scale Amount drawing is scaled by
+ * @param xOffset X offset of the virtual window in pixels
+ * @param yOffset Y offset of the virtual window in pixels
+ * @return Area in window pixels, rounded out to whole pixels
+ */
+wxRect DrawCuller::ToWindow(const wxRect2DDouble& rect, double scale, double xOffset, double yOffset)
+{
+    int left = int(std::floor(rect.m_x * scale + xOffset));
+    int top = int(std::floor(rect.m_y * scale + yOffset));
+    int right = int(std::ceil((rect.m_x + rect.m_width) * scale + xOffset));
+    int bottom = int(std::ceil((rect.m_y + rect.m_height) * scale + yOffset));
+    return wxRect(left, top, right - left, bottom - top);
+}
+
+/**
+ * Is any part of an item in the window?
+ * @param item Item to check
+ * @return True if the item should be drawn
+ */
+bool DrawCuller::IsVisible(Item* item)
+{
+    mCullable = false;
+    item->Accept(this);
+    if (!mCullable)
+    {
+        return true;
+    }
+
+    double halfWidth = (item->GetWidth() > 0 ? item->GetWidth() : DefaultCullSize) / 2;
+    double halfHeight = (item->GetHeight() > 0 ? item->GetHeight() : DefaultCullSize) / 2;
+    return item->GetX() + halfWidth >= mLeft && item->GetX() - halfWidth <= mRight &&
+           item->GetY() + halfHeight >= mTop && item->GetY() - halfHeight <= mBottom;
+}
+
+/**
+ * Choose the items to draw
+ * @param items Every item of the game, in drawing order
+ * @return The items to draw, in drawing order
+ */
+const std::vector<Item*>& DrawCuller::Cull(const std::vector<std::shared_ptr<Item>>& items)
+{
+    TraceScope trace("DrawCuller::Cull", "paint");
+
+    mVisible.clear();
+    mCulled = 0;
+    for (auto& item : items)
+    {
+        if (IsVisible(item.get()))
+        {
+            mVisible.push_back(item.get());
+        }
+        else
+        {
+            mCulled++;
+        }
+    }
+
+    return mVisible;
+}
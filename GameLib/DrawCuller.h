@@ -0,0 +1,77 @@
+/**
+ * @file DrawCuller.h
+ * @author Attulya Pratap Gupta
+ *
+ * Skips drawing items that are outside the window
+ */
+
+#ifndef DRAWCULLER_H
+#define DRAWCULLER_H
+
+#include <memory>
+#include <vector>
+#include <wx/geometry.h>
+
+#include "VisitorBase.h"
+
+class Item;
+
+/**
+ * Chooses the items worth drawing for the current window.
+ *
+ * Only products are culled. They are the only items that move out of the
+ * window in normal play, queued above the top of the conveyor or kicked
+ * off the side, and their bounds are the area they draw in. Other items
+ * draw wires and pins well outside their own bounds, so they are always
+ * drawn.
+ */
+class DrawCuller : public VisitorBase
+{
+private:
+    /// Left edge of the window in virtual pixels
+    double mLeft = 0;
+
+    /// Top edge of the window in virtual pixels
+    double mTop = 0;
+
+    /// Right edge of the window in virtual pixels
+    double mRight = 0;
+
+    /// Bottom edge of the window in virtual pixels
+    double mBottom = 0;
+
+    /// Is the item being checked one that can be culled?
+    bool mCullable = false;
+
+    /// Items to draw from the last call to Cull
+    std::vector<Item*> mVisible;
+
+    /// Number of items skipped by the last call to Cull
+    int mCulled = 0;
+
+public:
+    void SetWindow(int width, int height, double scale, double xOffset, double yOffset);
+    bool IsVisible(Item* item);
+    static wxRect ToWindow(const wxRect2DDouble& rect, double scale, double xOffset, double yOffset);
+    const std::vector<Item*>& Cull(const std::vector<std::shared_ptr<Item>>& items);
+
+    /**
+     * Visit a product, the one kind of item that is culled
+     * @param product Product being checked
+     */
+    void VisitProduct(Product* product) override { mCullable = true; }
+
+    /**
+     * Get the items to draw from the last call to Cull
+     * @return Items in drawing order
+     */
+    const std::vector<Item*>& GetVisible() const { return mVisible; }
+
+    /**
+     * Get the number of items skipped by the last call to Cull
+     * @return Number of items
+     */
+    int GetCulledCount() const { return mCulled; }
+};
+
+#endif //DRAWCULLER_H
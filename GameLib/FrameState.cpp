@@ -0,0 +1,217 @@
+/**
+ * @file FrameState.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "FrameState.h"
+#include "Game.h"
+#include "VisitorBase.h"
+#include "Gate.h"
+#include "GateOr.h"
+#include "GateAnd.h"
+#include "GateNot.h"
+#include "GateSRFlipFlop.h"
+#include "GateDFlipFlop.h"
+#include "GateMulti.h"
+#include "GateLut.h"
+#include "GateMacro.h"
+#include "Sensor.h"
+#include "SensorOutput.h"
+#include "Beam.h"
+#include "Sparty.h"
+#include "Scoreboard.h"
+#include "Conveyor.h"
+#include "Product.h"
+
+/**
+ * Visitor that collects the items of a game in visiting order,
+ * with the products and scoreboards kept apart
+ */
+class FrameVisitor : public VisitorBase
+{
+private:
+    /// The items visited, other than products and scoreboards
+    std::vector<Item*> mItems;
+
+    /// The products visited
+    std::vector<Product*> mProducts;
+
+    /// The scoreboards visited
+    std::vector<Scoreboard*> mScoreboards;
+
+public:
+    /**
+     * Get the items visited, other than products and scoreboards
+     * @return Items in visiting order
+     */
+    const std::vector<Item*>& GetItems() const { return mItems; }
+
+    /**
+     * Get the products visited
+     * @return Products in visiting order
+     */
+    const std::vector<Product*>& GetProducts() const { return mProducts; }
+
+    /**
+     * Get the scoreboards visited
+     * @return Scoreboards in visiting order
+     */
+    const std::vector<Scoreboard*>& GetScoreboards() const { return mScoreboards; }
+
+    void VisitGate(Gate* gate) override { mItems.push_back(gate); }
+    void VisitSensor(Sensor* sensor) override { mItems.push_back(sensor); }
+    void VisitBeam(Beam* beam) override { mItems.push_back(beam); }
+    void VisitSparty(Sparty* sparty) override { mItems.push_back(sparty); }
+    void VisitScoreboard(Scoreboard* scoreboard) override { mScoreboards.push_back(scoreboard); }
+    void VisitProduct(Product* product) override { mProducts.push_back(product); }
+    void VisitSensorOutput(SensorOutput* sensorOutput) override { mItems.push_back(sensorOutput); }
+    void VisitGateOr(GateOr* gateOr) override { mItems.push_back(gateOr); }
+    void VisitGateAnd(GateAnd* gateAnd) override { mItems.push_back(gateAnd); }
+    void VisitGateNot(GateNot* gateNot) override { mItems.push_back(gateNot); }
+    void VisitGateSRFlipFlop(GateSRFlipFlop* gateSRFlipFlop) override { mItems.push_back(gateSRFlipFlop); }
+    void VisitGateDFlipFlop(GateDFlipFlop* gateDFlipFlop) override { mItems.push_back(gateDFlipFlop); }
+    void VisitGateMulti(GateMulti* gateMulti) override { mItems.push_back(gateMulti); }
+    void VisitGateLut(GateLut* gateLut) override { mItems.push_back(gateLut); }
+    void VisitGateMacro(GateMacro* gateMacro) override { mItems.push_back(gateMacro); }
+    void VisitConveyor(Conveyor* conveyor) override { mItems.push_back(conveyor); }
+};
+
+/**
+ * Capture what the game looks like now. Called by the simulation thread,
+ * reusing the memory of the frame captured into before.
+ * @param game Game to capture
+ */
+void FrameState::Capture(Game* game)
+{
+    mItems.clear();
+    mProducts.clear();
+    mScores.clear();
+    mState.Clear();
+    mLevelOffset = 0;
+    mGameScore = game->GetGameScore();
+    mEndTimer = game->GetEndTimer();
+
+    auto level = game->GetLevel();
+    mLevel = level != nullptr ? level->GetLevelNumber() : 0;
+    if (level == nullptr)
+    {
+        return;
+    }
+
+    // Parked items are not drawn, so only the items in play are captured
+    FrameVisitor visitor;
+    game->Accept(&visitor);
+
+    for (auto item : visitor.GetItems())
+    {
+        mItems.push_back({item->GetX(), item->GetY(), mState.GetSize()});
+        item->SaveState(&mState);
+    }
+
+    for (auto product : visitor.GetProducts())
+    {
+        mProducts.push_back({product->GetShape(), product->GetColor(), product->GetContent(),
+                             product->GetWidth(), product->GetHeight(), mState.GetSize()});
+        product->SaveState(&mState);
+    }
+
+    // Scoreboards hold pointers to the simulation's products,
+    // so only the scores they show are captured
+    for (auto scoreboard : visitor.GetScoreboards())
+    {
+        mScores.push_back({scoreboard->GetLevelScore(), scoreboard->GetGameScore(), scoreboard->GetPerfectScore()});
+    }
+
+    mLevelOffset = mState.GetSize();
+    level->SaveState(&mState);
+}
+
+/**
+ * Make the window's game look like the captured one. Only the window calls this.
+ * @param view Game the window draws, loaded with the same level as the captured game
+ * @return False if the view does not have the same items as the captured game,
+ * such as when a gate was added and the simulation has not run a tick since
+ */
+bool FrameState::Restore(Game* view) const
+{
+    auto level = view->GetLevel();
+    if (level == nullptr || level->GetLevelNumber() != mLevel)
+    {
+        return false;
+    }
+
+    FrameVisitor visitor;
+    view->Accept(&visitor);
+
+    auto& items = visitor.GetItems();
+    auto& scoreboards = visitor.GetScoreboards();
+    if (items.size() != mItems.size() || scoreboards.size() != mScores.size())
+    {
+        return false;
+    }
+
+    // Put as many of the view's products in play as the frame has
+    auto& products = visitor.GetProducts();
+    if (products.size() != mProducts.size())
+    {
+        for (size_t i = mProducts.size(); i < products.size(); i++)
+        {
+            view->ParkItem(products[i]);
+        }
+
+        FrameVisitor parked;
+        view->AcceptParked(&parked);
+        for (size_t i = 0; i < parked.GetProducts().size() && products.size() + i < mProducts.size(); i++)
+        {
+            view->UnparkItem(parked.GetProducts()[i]);
+        }
+        view->ApplyParking();
+    }
+
+    FrameVisitor inPlay;
+    if (products.size() != mProducts.size())
+    {
+        view->Accept(&inPlay);
+    }
+    auto& slots = products.size() != mProducts.size() ? inPlay.GetProducts() : products;
+
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        auto item = items[i];
+        auto& frame = mItems[i];
+        if (item->GetX() != frame.mX || item->GetY() != frame.mY)
+        {
+            item->SetLocation(frame.mX, frame.mY);
+            item->UpdateGeometry();
+        }
+
+        mState.Seek(frame.mOffset);
+        item->RestoreState(&mState);
+    }
+
+    for (size_t i = 0; i < slots.size() && i < mProducts.size(); i++)
+    {
+        auto product = slots[i];
+        auto& frame = mProducts[i];
+        product->SetLook(frame.mShape, frame.mColor, frame.mContent);
+        product->SetWidth(frame.mWidth);
+        product->SetHeight(frame.mHeight);
+
+        mState.Seek(frame.mOffset);
+        product->RestoreState(&mState);
+    }
+
+    for (size_t i = 0; i < scoreboards.size(); i++)
+    {
+        scoreboards[i]->SetLevelScore(mScores[i].mLevelScore);
+        scoreboards[i]->SetGameScore(mScores[i].mGameScore);
+        scoreboards[i]->SetPerfectScore(mScores[i].mPerfectScore);
+    }
+
+    mState.Seek(mLevelOffset);
+    level->RestoreState(&mState);
+    view->SetGameScore(mGameScore);
+    view->SetEndTimer(mEndTimer);
+    return true;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file FrameState.h
+ * @author Attulya Pratap Gupta
+ *
+ * Everything the window needs to draw one frame of a game
+ */
+
+#ifndef FRAMESTATE_H
+#define FRAMESTATE_H
+
+#include <vector>
+
+#include "GameState.h"
+#include "Product.h"
+
+class Game;
+
+/**
+ * Everything the window needs to draw one frame of a game.
+ *
+ * The simulation thread captures where every item is, the state of its
+ * pins and the scores as plain values, and the window restores them into
+ * a game of its own that it only ever draws. That game is loaded with the
+ * same level and has the same gates added and wires connected, so its
+ * items other than products come in the same visiting order and are
+ * matched to the captured ones by their position in that order.
+ *
+ * Products are parked, returned and reused from stream pools, so their
+ * order does not match between the two games. Only the products in play
+ * are captured, with what they look like, and the window's own products
+ * are used as slots to draw them. No pointer into the simulation's game
+ * is kept.
+ */
+class FrameState
+{
+private:
+    /// Where one item is and where its state is in the buffer
+    struct ItemFrame
+    {
+        double mX;      ///< X location of the item in pixels
+        double mY;      ///< Y location of the item in pixels
+        size_t mOffset; ///< Offset of the item's state in the buffer
+    };
+
+    /// What one product in play looks like and where its state is in the buffer
+    struct ProductFrame
+    {
+        Product::Properties mShape;   ///< Product shape
+        Product::Properties mColor;   ///< Product color
+        Product::Properties mContent; ///< Product content
+        double mWidth;                ///< Width of the product in pixels
+        double mHeight;               ///< Height of the product in pixels
+        size_t mOffset;               ///< Offset of the product's state, including its location, in the buffer
+    };
+
+    /// Scores shown by one scoreboard
+    struct ScoreFrame
+    {
+        int mLevelScore;    ///< Score for the level
+        int mGameScore;     ///< Score for the game
+        bool mPerfectScore; ///< Was the level scored perfectly?
+    };
+
+    /// Every item in play other than products and scoreboards, in visiting order
+    std::vector<ItemFrame> mItems;
+
+    /// Every product in play, in visiting order
+    std::vector<ProductFrame> mProducts;
+
+    /// Every scoreboard, in visiting order
+    std::vector<ScoreFrame> mScores;
+
+    /// Pin states and other drawn state of the items, then the level state.
+    /// Only the read position changes while restoring.
+    mutable GameState mState;
+
+    /// Offset of the level state in the buffer
+    size_t mLevelOffset = 0;
+
+    /// Level the frame was captured on, 0 if none was loaded
+    int mLevel = 0;
+
+    /// Game score
+    int mGameScore = 0;
+
+    /// Time left before the next level starts in seconds
+    double mEndTimer = 0;
+
+public:
+    void Capture(Game* game);
+    bool Restore(Game* view) const;
+
+    /**
+     * Get the level the frame was captured on
+     * @return Level number, 0 if none was loaded
+     */
+    int GetLevel() const { return mLevel; }
+
+    /**
+     * Get the game score
+     * @return Game score
+     */
+    int GetGameScore() const { return mGameScore; }
+
+    /**
+     * Get the number of products in play
+     * @return Number of products
+     */
+    size_t GetProductCount() const { return mProducts.size(); }
+};
+
+#endif //FRAMESTATE_H
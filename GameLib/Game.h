@@ -15,6 +15,8 @@
 #include "Level.h"
 #include "IDraggable.h"
 #include "Pin.h"
+#include "DrawCuller.h"
+#include "ItemParking.h"
 
 class Level;
 class Item;
@@ -41,6 +43,12 @@ private:
 
     std::vector<std::shared_ptr<Item>> mItems; ///< The items in the game
     std::vector<std::shared_ptr<Item>> mProducts; ///< Temporary list for products in the game
+
+    /// Items taken out of play
+    ItemParking mParking;
+
+    /// Chooses the items worth drawing
+    DrawCuller mCuller;
     std::unique_ptr<Level> mLevel; ///< The level loader
     std::shared_ptr<IDraggable> mGrabbedItem; ///< Grabbed item in the game
 
@@ -123,6 +131,12 @@ public:
 	 */
 	double GetEndTimer() { return mEndLevelTimer; }
 
+	/**
+	 * Sets end timer
+	 * @param timer Time left until the next level in seconds
+	 */
+	void SetEndTimer(double timer) { mEndLevelTimer = timer; }
+
     /**
      * Getter for gate count
      * @return gate count
@@ -140,6 +154,92 @@ public:
     std::vector<std::shared_ptr<Gate>> TopologicalSort(std::shared_ptr<Pin> beamPin, std::vector<std::shared_ptr<Pin>> sensorPins);
 
 
+    /**
+     * Take an item out of play at the end of the update, so it is no longer
+     * updated, drawn or visited until it is returned
+     * @param item Item to park
+     */
+    void ParkItem(Item* item) { mParking.Park(item); }
+
+    /**
+     * Return a parked item to play at the end of the update
+     * @param item Item to return
+     */
+    void UnparkItem(Item* item) { mParking.Unpark(item); }
+
+    /**
+     * Return every parked item to play at the end of the update
+     */
+    void UnparkItems() { mParking.UnparkAll(); }
+
+    /**
+     * Forget every parked item, such as when a new level is loaded
+     */
+    void ClearParkedItems() { mParking.Clear(); }
+
+    /**
+     * Get the number of items out of play
+     * @return Number of parked items
+     */
+    size_t GetParkedCount() const { return mParking.GetCount(); }
+
+    /**
+     * Is an item out of play?
+     * @param item Item to look for
+     * @return True if the item is parked
+     */
+    bool IsParked(const Item* item) const { return mParking.IsParked(item); }
+
+    /**
+     * Accept a visitor for the items out of play only
+     * @param visitor The visitor
+     */
+    void AcceptParked(class VisitorBase* visitor) { mParking.Accept(visitor); }
+
+    /**
+     * Park and return the items asked for during the update, once nothing is iterating over mItems
+     */
+    void ApplyParking() { mParking.Apply(mItems); }
+
+    /**
+     * Bring the geometry of every item that moved up to date, once a tick
+     */
+    void UpdateGeometry()
+    {
+        for (auto& item : mItems)
+        {
+            item->UpdateGeometry();
+        }
+    }
+
+    /**
+     * Choose the items OnDraw should draw, once mScale and the offsets are set for the window
+     * @param width Width of the window in pixels
+     * @param height Height of the window in pixels
+     * @return Items in the window, in drawing order
+     */
+    const std::vector<Item*>& CullItems(int width, int height)
+    {
+        mCuller.SetWindow(width, height, mScale, mXOffset, mYOffset);
+        return mCuller.Cull(mItems);
+    }
+
+    /**
+     * Convert an area in virtual pixels to the window pixels it covers, for a partial refresh
+     * @param rect Area in virtual pixels
+     * @return Area in window pixels, rounded out to whole pixels
+     */
+    wxRect VirtualToWindow(const wxRect2DDouble& rect) const
+    {
+        return DrawCuller::ToWindow(rect, mScale, mXOffset, mYOffset);
+    }
+
+    /**
+     * Get the number of items skipped by the last draw
+     * @return Number of items
+     */
+    int GetCulledCount() const { return mCuller.GetCulledCount(); }
+
     bool IsLastProductReached();
     void DetermineMaxLevelNumber();
 	int CalculateBonusPoints();
@@ -0,0 +1,246 @@
+/**
+ * @file GameSnapshot.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "GameSnapshot.h"
+#include "Game.h"
+#include "VisitorBase.h"
+#include "Gate.h"
+#include "GateOr.h"
+#include "GateAnd.h"
+#include "GateNot.h"
+#include "GateSRFlipFlop.h"
+#include "GateDFlipFlop.h"
+#include "GateMulti.h"
+#include "GateLut.h"
+#include "GateMacro.h"
+#include "Sensor.h"
+#include "SensorOutput.h"
+#include "Beam.h"
+#include "Sparty.h"
+#include "Scoreboard.h"
+#include "Conveyor.h"
+#include "Product.h"
+#include <algorithm>
+
+/**
+ * Visitor that collects every item of the game in visiting order
+ */
+class SnapshotVisitor : public VisitorBase
+{
+private:
+    /// The items visited
+    std::vector<Item*> mItems;
+
+public:
+    /**
+     * Get the items visited
+     * @return Items in visiting order
+     */
+    const std::vector<Item*>& GetItems() const { return mItems; }
+
+    void VisitGate(Gate* gate) override { mItems.push_back(gate); }
+    void VisitSensor(Sensor* sensor) override { mItems.push_back(sensor); }
+    void VisitBeam(Beam* beam) override { mItems.push_back(beam); }
+    void VisitSparty(Sparty* sparty) override { mItems.push_back(sparty); }
+    void VisitScoreboard(Scoreboard* scoreboard) override { mItems.push_back(scoreboard); }
+    void VisitProduct(Product* product) override { mItems.push_back(product); }
+    void VisitSensorOutput(SensorOutput* sensorOutput) override { mItems.push_back(sensorOutput); }
+    void VisitGateOr(GateOr* gateOr) override { mItems.push_back(gateOr); }
+    void VisitGateAnd(GateAnd* gateAnd) override { mItems.push_back(gateAnd); }
+    void VisitGateNot(GateNot* gateNot) override { mItems.push_back(gateNot); }
+    void VisitGateSRFlipFlop(GateSRFlipFlop* gateSRFlipFlop) override { mItems.push_back(gateSRFlipFlop); }
+    void VisitGateDFlipFlop(GateDFlipFlop* gateDFlipFlop) override { mItems.push_back(gateDFlipFlop); }
+    void VisitGateMulti(GateMulti* gateMulti) override { mItems.push_back(gateMulti); }
+    void VisitGateLut(GateLut* gateLut) override { mItems.push_back(gateLut); }
+    void VisitGateMacro(GateMacro* gateMacro) override { mItems.push_back(gateMacro); }
+    void VisitConveyor(Conveyor* conveyor) override { mItems.push_back(conveyor); }
+};
+
+/**
+ * Save the state of every item of the game, its level and its score
+ * @param game Game to capture
+ * @param time Simulation time the snapshot is taken at in seconds
+ */
+void GameSnapshot::Capture(Game* game, double time)
+{
+    mState.Clear();
+    mRecords.clear();
+    mTime = time;
+
+    SnapshotVisitor visitor;
+    game->Accept(&visitor);
+    SnapshotVisitor parked;
+    game->AcceptParked(&parked);
+
+    for (auto item : visitor.GetItems())
+    {
+        mRecords.push_back({item, mState.GetSize(), false});
+        item->SaveState(&mState);
+    }
+    for (auto item : parked.GetItems())
+    {
+        mRecords.push_back({item, mState.GetSize(), true});
+        item->SaveState(&mState);
+    }
+
+    mGameOffset = mState.GetSize();
+    game->GetLevel()->SaveState(&mState);
+    mState.Put(game->GetGameScore());
+    mState.Put(game->GetEndTimer());
+}
+
+/**
+ * Put the game back into the state it was in when captured.
+ *
+ * Items added since the capture keep their current state and items
+ * that no longer exist are skipped.
+ *
+ * @param game Game to restore, must be the game that was captured
+ * @return False if nothing was captured from the game's current items
+ */
+bool GameSnapshot::Restore(Game* game)
+{
+    SnapshotVisitor visitor;
+    game->Accept(&visitor);
+    auto inPlay = visitor.GetItems().size();
+    game->AcceptParked(&visitor);
+    auto& items = visitor.GetItems();
+
+    // Items normally come back in the order they were saved, so only
+    // search the table when an item was added or removed in between
+    bool restored = false;
+    size_t next = 0;
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        auto item = items[i];
+        if (next >= mRecords.size() || mRecords[next].mItem != item)
+        {
+            auto found = std::find_if(mRecords.begin(), mRecords.end(),
+                                      [item](const Record& record) { return record.mItem == item; });
+            if (found == mRecords.end())
+            {
+                continue;
+            }
+            next = found - mRecords.begin();
+        }
+
+        mState.Seek(mRecords[next].mOffset);
+        item->RestoreState(&mState);
+        restored = true;
+
+        // Products parked since the capture go back on the belt, and the other way round
+        bool parked = i >= inPlay;
+        if (mRecords[next].mParked && !parked)
+        {
+            game->ParkItem(item);
+        }
+        else if (!mRecords[next].mParked && parked)
+        {
+            game->UnparkItem(item);
+        }
+        next++;
+    }
+    game->ApplyParking();
+
+    if (!restored && !mRecords.empty())
+    {
+        return false;
+    }
+
+    mState.Seek(mGameOffset);
+    game->GetLevel()->RestoreState(&mState);
+
+    int score = game->GetGameScore();
+    double endTimer = game->GetEndTimer();
+    mState.Get(score);
+    mState.Get(endTimer);
+    game->SetGameScore(score);
+    game->SetEndTimer(endTimer);
+    return true;
+}
+
+/**
+ * Constructor
+ * @param interval Seconds of simulation time between snapshots
+ * @param span Seconds of simulation time the history can rewind
+ */
+GameHistory::GameHistory(double interval, double span) : mInterval(interval), mSpan(span)
+{
+}
+
+/**
+ * Advance the history, capturing a snapshot when one is due
+ * @param game Game to capture
+ * @param elapsed Simulation time since the last call in seconds
+ */
+void GameHistory::Update(Game* game, double elapsed)
+{
+    mTime += elapsed;
+    if (mLastCapture >= 0 && mTime - mLastCapture < mInterval)
+    {
+        return;
+    }
+
+    // Reuse the buffer of the oldest snapshot once the span is full
+    GameSnapshot snapshot;
+    if (!mSnapshots.empty() && mTime - mSnapshots.front().GetTime() > mSpan)
+    {
+        snapshot = std::move(mSnapshots.front());
+        mSnapshots.pop_front();
+    }
+    else if (!mSpare.empty())
+    {
+        snapshot = std::move(mSpare.back());
+        mSpare.pop_back();
+    }
+    else
+    {
+        mAllocated++;
+    }
+
+    snapshot.Capture(game, mTime);
+    mSnapshots.push_back(std::move(snapshot));
+    mLastCapture = mTime;
+}
+
+/**
+ * Rewind the game to the newest snapshot at least seconds old
+ * @param game Game to rewind
+ * @param seconds How far back to go in seconds
+ * @return True if the game was rewound
+ */
+bool GameHistory::Rewind(Game* game, double seconds)
+{
+    double target = mTime - seconds;
+    while (mSnapshots.size() > 1 && mSnapshots.back().GetTime() > target)
+    {
+        mSpare.push_back(std::move(mSnapshots.back()));
+        mSnapshots.pop_back();
+    }
+
+    if (mSnapshots.empty() || !mSnapshots.back().Restore(game))
+    {
+        return false;
+    }
+
+    mTime = mSnapshots.back().GetTime();
+    mLastCapture = mTime;
+    return true;
+}
+
+/**
+ * Discard all snapshots, such as when a new level is loaded
+ */
+void GameHistory::Clear()
+{
+    while (!mSnapshots.empty())
+    {
+        mSpare.push_back(std::move(mSnapshots.back()));
+        mSnapshots.pop_back();
+    }
+    mTime = 0;
+    mLastCapture = -1;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file GameSnapshot.h
+ * @author Attulya Pratap Gupta
+ *
+ * Saved copy of the simulation state of a game
+ */
+
+#ifndef GAMESNAPSHOT_H
+#define GAMESNAPSHOT_H
+
+#include <vector>
+#include <deque>
+
+#include "GameState.h"
+
+class Game;
+class Item;
+
+/**
+ * Saved copy of the mutable simulation state of a game.
+ *
+ * Every item saves its own state into one flat buffer, and a table
+ * records where each item's state starts. Restoring walks the items
+ * of the game again and copies each one back from its offset, so the
+ * items themselves are never recreated. Parked items are saved too, and
+ * are parked or returned to play to match the snapshot when it is
+ * restored. A snapshot can only be restored into the same game, on the
+ * same level, it was captured from.
+ */
+class GameSnapshot
+{
+private:
+    /// Where one item's state is in the buffer
+    struct Record
+    {
+        Item* mItem;    ///< Item the state belongs to
+        size_t mOffset; ///< Offset of the state in the buffer
+        bool mParked;   ///< Was the item out of play?
+    };
+
+    /// The saved state of every item, then the level and game
+    GameState mState;
+
+    /// Offset of each item's state, in visiting order
+    std::vector<Record> mRecords;
+
+    /// Offset of the level and game state
+    size_t mGameOffset = 0;
+
+    /// Simulation time the snapshot was taken at in seconds
+    double mTime = 0;
+
+public:
+    void Capture(Game* game, double time = 0);
+    bool Restore(Game* game);
+
+    /**
+     * Get the simulation time the snapshot was taken at
+     * @return Time in seconds
+     */
+    double GetTime() const { return mTime; }
+
+    /**
+     * Get the size of the saved state
+     * @return Size in bytes
+     */
+    size_t GetSize() const { return mState.GetSize(); }
+};
+
+/**
+ * Ring of recent snapshots used to rewind a game.
+ *
+ * A snapshot is captured at a fixed interval of simulation time and
+ * the oldest is dropped once the history covers the requested span.
+ */
+class GameHistory
+{
+private:
+    /// Snapshots, oldest first
+    std::deque<GameSnapshot> mSnapshots;
+
+    /// Spare snapshots kept so capturing reuses their buffers
+    std::vector<GameSnapshot> mSpare;
+
+    /// Seconds of simulation time between snapshots
+    double mInterval;
+
+    /// Seconds of simulation time to keep
+    double mSpan;
+
+    /// Current simulation time in seconds
+    double mTime = 0;
+
+    /// Simulation time of the last snapshot in seconds
+    double mLastCapture = -1;
+
+    /// Number of snapshots captured into a new buffer rather than a reused one
+    size_t mAllocated = 0;
+
+public:
+    GameHistory(double interval = 0.25, double span = 10);
+
+    void Update(Game* game, double elapsed);
+    bool Rewind(Game* game, double seconds);
+    void Clear();
+
+    /**
+     * Get the number of snapshots held
+     * @return Number of snapshots
+     */
+    size_t GetCount() const { return mSnapshots.size(); }
+
+    /**
+     * Get the number of snapshots captured into a new buffer rather than a reused one
+     * @return Number of buffers the history has created
+     */
+    size_t GetAllocatedCount() const { return mAllocated; }
+
+    /**
+     * Get the current simulation time of the history
+     * @return Time in seconds
+     */
+    double GetTime() const { return mTime; }
+};
+
+#endif //GAMESNAPSHOT_H
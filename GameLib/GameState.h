@@ -0,0 +1,76 @@
+/**
+ * @file GameState.h
+ * @author Attulya Pratap Gupta
+ *
+ * Flat buffer that item state is saved into
+ */
+
+#ifndef GAMESTATE_H
+#define GAMESTATE_H
+
+#include <vector>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * Flat buffer that items save their mutable simulation state into.
+ *
+ * Values are copied in and out as raw bytes, so saving and restoring
+ * never allocates once the buffer has grown to size.
+ */
+class GameState
+{
+private:
+    /// The saved bytes
+    std::vector<unsigned char> mData;
+
+    /// Position the next Get reads from
+    size_t mReadPos = 0;
+
+public:
+    /**
+     * Append a value to the buffer
+     * @param value Value to save, must be trivially copyable
+     */
+    template<class T>
+    void Put(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "GameState can only save plain values");
+        auto bytes = reinterpret_cast<const unsigned char*>(&value);
+        mData.insert(mData.end(), bytes, bytes + sizeof(T));
+    }
+
+    /**
+     * Read the next value from the buffer
+     * @param value Set to the value read, unchanged if the buffer is exhausted
+     */
+    template<class T>
+    void Get(T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "GameState can only restore plain values");
+        if (mReadPos + sizeof(T) <= mData.size())
+        {
+            std::memcpy(&value, mData.data() + mReadPos, sizeof(T));
+            mReadPos += sizeof(T);
+        }
+    }
+
+    /**
+     * Empty the buffer, keeping its memory for the next save
+     */
+    void Clear() { mData.clear(); mReadPos = 0; }
+
+    /**
+     * Get the number of bytes saved
+     * @return Size in bytes
+     */
+    size_t GetSize() const { return mData.size(); }
+
+    /**
+     * Move the read position
+     * @param pos Offset in bytes from the start of the buffer
+     */
+    void Seek(size_t pos) { mReadPos = pos; }
+};
+
+#endif //GAMESTATE_H
@@ -18,13 +18,30 @@
 class Gate : public Item, public std::enable_shared_from_this<Gate>
 {
 private:
-    /// The size of the gate (maybe this should be in each class instead so I can
-    /// set the value instead of needing a default here? Some feedback would be
-    /// helpful!)
-    wxSize mSize = wxSize(0,0);
+    /// Where the gate is, kept together so reading it never recomputes anything
+    struct Transform
+    {
+        wxSize mSize = wxSize(0, 0);             ///< Size of the gate in pixels
+        wxPoint mPosition = wxPoint(550, 350);   ///< Top left of the gate on the screen
+        double mX = 550;                         ///< X location of the center in pixels
+        double mY = 350;                         ///< Y location of the center in pixels
+    };
 
-    /// Position of gate on the screen
-    wxPoint mPosition = wxPoint(550,350);
+    /// The size and location of the gate
+    Transform mTransform;
+
+    /// Have the gate's pins to be put where the gate now is?
+    bool mPinsDirty = true;
+
+    /**
+     * Work out the center from the size and position, and mark the pins for moving
+     */
+    void UpdateTransform()
+    {
+        mTransform.mX = mTransform.mPosition.x + mTransform.mSize.GetWidth() / 2.0;
+        mTransform.mY = mTransform.mPosition.y + mTransform.mSize.GetHeight() / 2.0;
+        mPinsDirty = true;
+    }
 
 public:
 
@@ -35,38 +52,42 @@ public:
    * Sets the size of the gate
    * @param size of the gate
    */
-    void SetSize(wxSize size) { mSize = size; }
+    void SetSize(wxSize size) { mTransform.mSize = size; UpdateTransform(); }
 
     /**
      * The X location of the center of the gate
      * @return X location in pixels
      */
-    double GetX() const override { return mPosition.x + GetWidth() / 2; }
+    double GetX() const override { return mTransform.mX; }
 
     /**
      * The Y location of the center of the gate
      * @return Y location in pixels
      */
-    double GetY() const override { return mPosition.y + GetHeight() / 2; }
+    double GetY() const override { return mTransform.mY; }
 
 	/**
-	 * Set location of the gate
+	 * Set location of the gate. The pins follow the next time UpdateGeometry is called.
 	 * @param x x coordinate in pixels
 	 * @param y y coordinate in pixels
 	 */
-	void SetLocation(double x, double y) override { mPosition = wxPoint(x - GetWidth() / 2,y - GetHeight() / 2); }
+	void SetLocation(double x, double y) override
+	{
+		mTransform.mPosition = wxPoint(x - GetWidth() / 2, y - GetHeight() / 2);
+		UpdateTransform();
+	}
 
     /**
      * The width of the gate
      * @return width in pixels
      */
-    double GetWidth() const override { return mSize.GetWidth(); }
+    double GetWidth() const override { return mTransform.mSize.GetWidth(); }
 
   /**
    * The height of the gate
    * @return height in pixels
    */
-    double GetHeight() const override { return mSize.GetHeight(); }
+    double GetHeight() const override { return mTransform.mSize.GetHeight(); }
 
 
 	void Update(double elapsed) override;
@@ -83,6 +104,24 @@ public:
 	 */
 	virtual void UpdatePinPositions() {}
 
+	/**
+	 * Put the pins where the gate is, only if it has moved since they were last put there
+	 */
+	void UpdateGeometry() override
+	{
+		if (mPinsDirty)
+		{
+			UpdatePinPositions();
+			mPinsDirty = false;
+		}
+	}
+
+	/**
+	 * Have the pins to be moved to where the gate now is?
+	 * @return True if the gate moved since UpdateGeometry was last called
+	 */
+	bool IsGeometryDirty() const { return mPinsDirty; }
+
 	/**
 	 * Updates the output pin
 	 */
@@ -112,6 +151,48 @@ public:
 	 */
 	virtual std::vector<std::shared_ptr<Pin>> GetInputPins() = 0;
 
+	/**
+	 * Save the states of all of the gate's pins
+	 * @param state Buffer to save into
+	 */
+	void SaveState(GameState* state) override
+	{
+		for (auto& pin : GetInputPins())
+		{
+			pin->SaveState(state);
+		}
+		auto outputs = GetOutputPins();
+		if (outputs.first)
+		{
+			outputs.first->SaveState(state);
+		}
+		if (outputs.second)
+		{
+			outputs.second->SaveState(state);
+		}
+	}
+
+	/**
+	 * Restore the states of all of the gate's pins
+	 * @param state Buffer to restore from
+	 */
+	void RestoreState(GameState* state) override
+	{
+		for (auto& pin : GetInputPins())
+		{
+			pin->RestoreState(state);
+		}
+		auto outputs = GetOutputPins();
+		if (outputs.first)
+		{
+			outputs.first->RestoreState(state);
+		}
+		if (outputs.second)
+		{
+			outputs.second->RestoreState(state);
+		}
+	}
+
 };
 
 
@@ -0,0 +1,154 @@
+/**
+ * @file GateBlock.cpp
+ * @author Rachel Jansen
+ */
+
+#include "pch.h"
+#include "GateBlock.h"
+#include <algorithm>
+
+/// Width of a block gate in pixels
+const int BlockGateWidth = 60;
+
+/// Vertical space for each input pin in pixels
+const int BlockGatePinSpacing = 20;
+
+/// Smallest height of a block gate in pixels
+const int BlockGateMinHeight = 50;
+
+/// Size of the label font in pixels
+const int BlockGateFontSize = 16;
+
+/**
+ * Constructor
+ * @param game the game this gate is in
+ * @param inputs number of input pins
+ */
+GateBlock::GateBlock(Game* game, int inputs) : Gate(game),
+	mFont(wxFontInfo(wxSize(0, BlockGateFontSize)).FaceName(L"Arial").Bold())
+{
+	SetSize(wxSize(BlockGateWidth, std::max(BlockGateMinHeight, inputs * BlockGatePinSpacing)));
+
+	for (int i = 0; i < inputs; i++)
+	{
+		mInputPins.push_back(std::make_shared<Pin>(0, 0, true, this));
+	}
+	mOutputPin = std::make_shared<Pin>(0, 0, false, this);
+
+	UpdatePinPositions();
+}
+
+/**
+ * Draws the gate as a box with its label
+ * @param graphics the graphics context used to draw the gate
+ */
+void GateBlock::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+{
+	for (auto& pin : mInputPins)
+	{
+		pin->Draw(graphics);
+	}
+	mOutputPin->Draw(graphics);
+
+	auto x = GetX();
+	auto y = GetY();
+	auto w = GetWidth();
+	auto h = GetHeight();
+
+	graphics->SetPen(*wxBLACK_PEN);
+	graphics->SetBrush(*wxWHITE_BRUSH);
+	graphics->DrawRectangle(x - w / 2, y - h / 2, w, h);
+
+	graphics->SetFont(mFont, *wxBLACK);
+
+	double textWidth, textHeight;
+	auto label = GetLabel();
+	graphics->GetTextExtent(label, &textWidth, &textHeight);
+	graphics->DrawText(label, x - textWidth / 2, y - textHeight / 2);
+}
+
+/**
+ * Updates the state of the output pin from the input pins
+ */
+void GateBlock::UpdateOutputPin()
+{
+	unsigned int inputs = 0;
+	for (size_t i = 0; i < mInputPins.size(); i++)
+	{
+		if (mInputPins[i]->IsUnknown())
+		{
+			mOutputPin->SetUnknown();
+			return;
+		}
+
+		if (mInputPins[i]->IsOne())
+		{
+			inputs |= 1u << i;
+		}
+	}
+
+	if (Evaluate(inputs))
+	{
+		mOutputPin->SetOne();
+	}
+	else
+	{
+		mOutputPin->SetZero();
+	}
+}
+
+/**
+ * Update the position of the pins relative to the gate (for dragging gate)
+ */
+void GateBlock::UpdatePinPositions()
+{
+	auto top = GetY() - GetHeight() / 2;
+	auto spacing = GetHeight() / mInputPins.size();
+	for (size_t i = 0; i < mInputPins.size(); i++)
+	{
+		mInputPins[i]->SetPosition(GetX() - GetWidth() / 2 - DefaultLineLength, top + spacing * (i + 0.5));
+	}
+	mOutputPin->SetPosition(GetX() + GetWidth() / 2 + DefaultLineLength, GetY());
+}
+
+/**
+ * Check if we clicked on the Output pin
+ * @param x x coordinate of click
+ * @param y y coordinate of click
+ * @return Pointer to output pin if we clicked it, nullptr otherwise
+ */
+std::shared_ptr<IDraggable> GateBlock::HitDraggable(int x, int y)
+{
+	if (mOutputPin->HitTest(x,y))
+	{
+		return mOutputPin;
+	}
+	return nullptr;
+}
+
+/**
+ * Try to connect the pin we are dragging from to each of the input pins on the gate
+ * @param pin The pin we are dragging from
+ * @param lineEnd The end of the line we are dragging
+ * @return True if a connection occurs, false otherwise
+ */
+bool GateBlock::Connect(Pin* pin, wxPoint lineEnd)
+{
+	for (auto& input : mInputPins)
+	{
+		if (pin->Connect(input.get(), lineEnd))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Get the output pin of the gate
+ * @return Pointer to the output pin
+ */
+std::pair<std::shared_ptr<Pin>, std::shared_ptr<Pin>> GateBlock::GetOutputPins()
+{
+	return std::make_pair(mOutputPin,nullptr);
+}
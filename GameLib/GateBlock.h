@@ -0,0 +1,75 @@
+/**
+ * @file GateBlock.h
+ * @author Rachel Jansen
+ *
+ * Base class for rectangular gates with any number of inputs
+ */
+
+#ifndef GATEBLOCK_H
+#define GATEBLOCK_H
+
+#include "Gate.h"
+
+/**
+ * Base class for rectangular gates with any number of inputs and one output.
+ *
+ * The known input states are packed into the bits of an integer, input 0
+ * in bit 0, and the derived class computes the output from those bits.
+ * As with the other gates, any unknown input makes the output unknown.
+ */
+class GateBlock : public Gate
+{
+private:
+	/// Input pins, top to bottom
+	std::vector<std::shared_ptr<Pin>> mInputPins;
+
+	/// Output pin
+	std::shared_ptr<Pin> mOutputPin;
+
+	/// Font the label is drawn in
+	wxFont mFont;
+
+protected:
+	GateBlock(Game* game, int inputs);
+
+	/**
+	 * Compute the output of the gate
+	 * @param inputs Input states, input i in bit i
+	 * @return True if the output is one
+	 */
+	virtual bool Evaluate(unsigned int inputs) const = 0;
+
+	/**
+	 * Get the label drawn in the gate
+	 * @return Label text
+	 */
+	virtual wxString GetLabel() const = 0;
+
+public:
+	void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+	void UpdateOutputPin() override;
+	void UpdatePinPositions() override;
+	std::shared_ptr<IDraggable> HitDraggable(int x, int y) override;
+	bool Connect(Pin *pin, wxPoint lineEnd) override;
+	std::pair<std::shared_ptr<Pin>, std::shared_ptr<Pin>> GetOutputPins() override;
+
+	/**
+	 * Setter for control points
+	 * @param show whether or not we should show control points
+	 * */
+	void SetShowControlPoints(bool show) override { mOutputPin->SetShowControlPoints(show);}
+
+	/**
+	 * Get the input pins for this gate
+	 * @return Vector of input pins
+	 */
+	std::vector<std::shared_ptr<Pin>> GetInputPins() override { return mInputPins; }
+
+	/**
+	 * Get the number of inputs
+	 * @return Number of input pins
+	 */
+	int GetInputCount() const { return int(mInputPins.size()); }
+};
+
+#endif //GATEBLOCK_H
@@ -40,6 +40,24 @@ public:
 
     void SetShowControlPoints(bool show) override;
 
+	/**
+	 * Save the pins and the previous clock state
+	 * @param state Buffer to save into
+	 */
+	void SaveState(GameState* state) override { Gate::SaveState(state); state->Put(mPrevState); }
+
+	/**
+	 * Restore the pins and the previous clock state
+	 * @param state Buffer to restore from
+	 */
+	void RestoreState(GameState* state) override { Gate::RestoreState(state); state->Get(mPrevState); }
+
+	/**
+	 * Get the state of the clock on the last update
+	 * @return True if the clock was high
+	 */
+	bool GetClockState() const { return mPrevState; }
+
     /**
 	 * Get the input pins for this gate
 	 * @return Vector of input pins
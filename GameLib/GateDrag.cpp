@@ -0,0 +1,135 @@
+/**
+ * @file GateDrag.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "GateDrag.h"
+#include "Gate.h"
+#include "Pin.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+
+/**
+ * Start dragging a gate
+ * @param gate Gate to drag
+ */
+void GateDrag::Begin(Gate* gate)
+{
+    mGate = gate;
+    mPending = false;
+    mDirty = wxRect2DDouble();
+    mMoves = 0;
+    mFlushes = 0;
+}
+
+/**
+ * Record where the gate is to go. The gate itself is not moved until Flush.
+ * @param x X location for the center of the gate in virtual pixels
+ * @param y Y location for the center of the gate in virtual pixels
+ */
+void GateDrag::Move(double x, double y)
+{
+    if (mGate == nullptr)
+    {
+        return;
+    }
+
+    mTarget = wxPoint2DDouble(x, y);
+    mPending = true;
+    mMoves++;
+}
+
+/**
+ * Move the gate to where it was last dragged, once a frame
+ * @return True if the gate moved and the dirty area needs drawing
+ */
+bool GateDrag::Flush()
+{
+    mDirty = wxRect2DDouble();
+    if (mGate == nullptr || !mPending)
+    {
+        return false;
+    }
+
+    TraceScope trace("GateDrag::Flush", "input");
+
+    auto before = GetBounds(mGate);
+    mGate->SetLocation(mTarget.m_x, mTarget.m_y);
+    mGate->UpdateGeometry();
+    wxRect2DDouble::Union(before, GetBounds(mGate), &mDirty);
+
+    mPending = false;
+    mFlushes++;
+    return true;
+}
+
+/**
+ * Finish the drag, putting the gate where it was last dragged
+ */
+void GateDrag::End()
+{
+    Flush();
+    mGate = nullptr;
+}
+
+/**
+ * Add the area a wire between two pins can draw in.
+ * The wire is a Bezier curve whose control points are at most
+ * BezierMaxOffset to the side of its ends, so it stays inside them.
+ * @param bounds Bounds to grow
+ * @param from Output end of the wire
+ * @param to Input end of the wire
+ */
+void GateDrag::AddWire(wxRect2DDouble& bounds, const Pin* from, const Pin* to)
+{
+    double left = std::min(from->GetX(), to->GetX()) - BezierMaxOffset - LineWidth;
+    double top = std::min(from->GetY(), to->GetY()) - LineWidth;
+    double right = std::max(from->GetX(), to->GetX()) + BezierMaxOffset + LineWidth;
+    double bottom = std::max(from->GetY(), to->GetY()) + LineWidth;
+    wxRect2DDouble::Union(bounds, wxRect2DDouble(left, top, right - left, bottom - top), &bounds);
+}
+
+/**
+ * Get the area a gate draws in, with its pins and the wires on them
+ * @param gate The gate
+ * @return Bounds in virtual pixels
+ */
+wxRect2DDouble GateDrag::GetBounds(Gate* gate)
+{
+    // Gate shapes reach past their centered box on the input side, so allow half a width all round
+    double margin = gate->GetWidth() / 2 + LineWidth;
+    wxRect2DDouble bounds(gate->GetX() - gate->GetWidth() / 2 - margin, gate->GetY() - gate->GetHeight() / 2 - margin,
+                          gate->GetWidth() + margin * 2, gate->GetHeight() + margin * 2);
+
+    auto addPin = [&bounds](const Pin* pin) {
+        wxRect2DDouble::Union(bounds, wxRect2DDouble(pin->GetX() - DefaultLineLength * 2 - PinSize, pin->GetY() - PinSize,
+                                                     DefaultLineLength * 4 + PinSize * 2, PinSize * 2), &bounds);
+    };
+
+    for (auto& input : gate->GetInputPins())
+    {
+        addPin(input.get());
+        if (input->GetConnected() != nullptr)
+        {
+            AddWire(bounds, input->GetConnected(), input.get());
+        }
+    }
+
+    auto outputs = gate->GetOutputPins();
+    for (auto& output : {outputs.first, outputs.second})
+    {
+        if (output == nullptr)
+        {
+            continue;
+        }
+
+        addPin(output.get());
+        for (auto input : output->GetPins())
+        {
+            AddWire(bounds, output.get(), input);
+        }
+    }
+
+    return bounds;
+}
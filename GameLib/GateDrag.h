@@ -0,0 +1,82 @@
+/**
+ * @file GateDrag.h
+ * @author Attulya Pratap Gupta
+ *
+ * Drags a gate one frame at a time
+ */
+
+#ifndef GATEDRAG_H
+#define GATEDRAG_H
+
+#include <wx/geometry.h>
+
+class Gate;
+class Pin;
+
+/**
+ * Drags a gate, moving it at most once a frame.
+ *
+ * Mouse motion only records where the gate should go. Once a frame
+ * Flush moves the gate, puts its pins where they belong, and works out
+ * the area that needs drawing again: where the gate and the wires on its
+ * pins were, together with where they are now. Nothing else in the
+ * circuit is touched, so the cost of a drag does not depend on how many
+ * other gates and wires there are.
+ */
+class GateDrag
+{
+private:
+    /// The gate being dragged, nullptr when nothing is
+    Gate* mGate = nullptr;
+
+    /// Where the gate is to go at the next flush
+    wxPoint2DDouble mTarget;
+
+    /// Has the gate been moved since the last flush?
+    bool mPending = false;
+
+    /// Area changed by the last flush, in virtual pixels
+    wxRect2DDouble mDirty;
+
+    /// Number of motion events since the drag began
+    int mMoves = 0;
+
+    /// Number of times the gate has been moved since the drag began
+    int mFlushes = 0;
+
+    static void AddWire(wxRect2DDouble& bounds, const Pin* from, const Pin* to);
+
+public:
+    void Begin(Gate* gate);
+    void Move(double x, double y);
+    bool Flush();
+    void End();
+
+    static wxRect2DDouble GetBounds(Gate* gate);
+
+    /**
+     * Is a gate being dragged?
+     * @return True between Begin and End
+     */
+    bool IsDragging() const { return mGate != nullptr; }
+
+    /**
+     * Get the area changed by the last flush
+     * @return Union of the old and new bounds in virtual pixels, empty if nothing moved
+     */
+    const wxRect2DDouble& GetDirty() const { return mDirty; }
+
+    /**
+     * Get the number of motion events since the drag began
+     * @return Number of moves
+     */
+    int GetMoveCount() const { return mMoves; }
+
+    /**
+     * Get the number of times the gate was moved since the drag began
+     * @return Number of flushes that moved the gate
+     */
+    int GetFlushCount() const { return mFlushes; }
+};
+
+#endif //GATEDRAG_H
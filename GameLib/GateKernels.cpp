@@ -0,0 +1,94 @@
+/**
+ * @file GateKernels.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "GateKernels.h"
+#include <utility>
+
+using NodeTypes = CompiledCircuit::NodeTypes;
+
+static_assert(Logic3<NodeTypes::And>::Table[SignalOne][SignalOne] == SignalOne, "1 AND 1 is 1");
+static_assert(Logic3<NodeTypes::And>::Table[SignalZero][SignalUnknown] == SignalUnknown, "Unknown inputs give unknown");
+static_assert(Logic3<NodeTypes::Or>::Table[SignalZero][SignalOne] == SignalOne, "0 OR 1 is 1");
+static_assert(Logic3<NodeTypes::Xor>::Table[SignalOne][SignalOne] == SignalZero, "1 XOR 1 is 0");
+
+/// Number of node types with kernels: And, Or, Xor, Not and Lut
+const int KernelTypes = 5;
+
+/**
+ * Build the row of the jump table for one operation
+ * @tparam Op What the gate computes
+ * @tparam Arities 0 to MaxArity
+ * @return Kernel for each number of inputs, index 0 for any number
+ */
+template<NodeTypes Op, int... Arities>
+static constexpr std::array<CompiledCircuit::Kernel, sizeof...(Arities)> KernelRow(std::integer_sequence<int, Arities...>)
+{
+    return {&GateKernel<Op, Arities>::Evaluate...};
+}
+
+/**
+ * Build the row of the jump table of run kernels for one operation
+ * @tparam Op What the gates compute
+ * @tparam Arities 0 to MaxArity
+ * @return Run kernel for each number of inputs, index 0 for any number
+ */
+template<NodeTypes Op, int... Arities>
+static constexpr std::array<CompiledCircuit::RunKernel, sizeof...(Arities)> RunKernelRow(std::integer_sequence<int, Arities...>)
+{
+    return {&GateKernel<Op, Arities>::EvaluateRun...};
+}
+
+/// Every kernel, indexed by node type then number of inputs
+static const std::array<std::array<CompiledCircuit::Kernel, GateKernels::MaxArity + 1>, KernelTypes> Kernels = {
+    KernelRow<NodeTypes::And>(std::make_integer_sequence<int, GateKernels::MaxArity + 1>()),
+    KernelRow<NodeTypes::Or>(std::make_integer_sequence<int, GateKernels::MaxArity + 1>()),
+    KernelRow<NodeTypes::Xor>(std::make_integer_sequence<int, GateKernels::MaxArity + 1>()),
+    KernelRow<NodeTypes::Not>(std::make_integer_sequence<int, GateKernels::MaxArity + 1>()),
+    KernelRow<NodeTypes::Lut>(std::make_integer_sequence<int, GateKernels::MaxArity + 1>()),
+};
+
+/// Every run kernel, indexed by node type then number of inputs
+static const std::array<std::array<CompiledCircuit::RunKernel, GateKernels::MaxArity + 1>, KernelTypes> RunKernels = {
+    RunKernelRow<NodeTypes::And>(std::make_integer_sequence<int, GateKernels::MaxArity + 1>()),
+    RunKernelRow<NodeTypes::Or>(std::make_integer_sequence<int, GateKernels::MaxArity + 1>()),
+    RunKernelRow<NodeTypes::Xor>(std::make_integer_sequence<int, GateKernels::MaxArity + 1>()),
+    RunKernelRow<NodeTypes::Not>(std::make_integer_sequence<int, GateKernels::MaxArity + 1>()),
+    RunKernelRow<NodeTypes::Lut>(std::make_integer_sequence<int, GateKernels::MaxArity + 1>()),
+};
+
+/**
+ * Find the kernel for a node
+ * @param type What the node computes
+ * @param arity Number of inputs
+ * @return The kernel, nullptr for flip flops and nodes without inputs
+ */
+CompiledCircuit::Kernel GateKernels::Find(NodeTypes type, int arity)
+{
+    auto row = static_cast<int>(type);
+    if (row >= KernelTypes || arity < 1)
+    {
+        return nullptr;
+    }
+
+    return Kernels[row][arity <= MaxArity ? arity : 0];
+}
+
+/**
+ * Find the kernel for a run of nodes of the same type and number of inputs
+ * @param type What the nodes compute
+ * @param arity Number of inputs of each node
+ * @return The kernel, nullptr for flip flops and nodes without inputs
+ */
+CompiledCircuit::RunKernel GateKernels::FindRun(NodeTypes type, int arity)
+{
+    auto row = static_cast<int>(type);
+    if (row >= KernelTypes || arity < 1)
+    {
+        return nullptr;
+    }
+
+    return RunKernels[row][arity <= MaxArity ? arity : 0];
+}
@@ -0,0 +1,147 @@
+/**
+ * @file GateKernels.h
+ * @author Attulya Pratap Gupta
+ *
+ * Gate evaluation specialized at compile time by operation and number of inputs
+ */
+
+#ifndef GATEKERNELS_H
+#define GATEKERNELS_H
+
+#include <array>
+
+#include "CompiledCircuit.h"
+
+/**
+ * Three-valued truth table of a two-input operation, built at compile time.
+ *
+ * Row a, column b is the output for inputs a and b, each SignalZero,
+ * SignalOne or SignalUnknown. As with the gates, an unknown input makes
+ * the output unknown, so folding the table over any number of inputs
+ * gives the output of a gate with that many inputs.
+ *
+ * @tparam Op And, Or or Xor
+ */
+template<CompiledCircuit::NodeTypes Op>
+struct Logic3
+{
+    /**
+     * Compute the table
+     * @return Outputs indexed by [a][b]
+     */
+    static constexpr std::array<std::array<unsigned char, 3>, 3> Build()
+    {
+        std::array<std::array<unsigned char, 3>, 3> table{};
+        for (int a = 0; a < 3; a++)
+        {
+            for (int b = 0; b < 3; b++)
+            {
+                bool one = Op == CompiledCircuit::NodeTypes::And ? (a & b) != 0 :
+                           Op == CompiledCircuit::NodeTypes::Or ? (a | b) != 0 : (a ^ b) != 0;
+                table[a][b] = a == SignalUnknown || b == SignalUnknown ? SignalUnknown :
+                              one ? SignalOne : SignalZero;
+            }
+        }
+        return table;
+    }
+
+    /// The table, indexed by [a][b]
+    static constexpr std::array<std::array<unsigned char, 3>, 3> Table = Build();
+};
+
+/// Three-valued NOT, indexed by the input
+constexpr std::array<unsigned char, 3> Not3 = {SignalOne, SignalZero, SignalUnknown};
+
+/**
+ * Evaluates one gate of a fixed operation and number of inputs.
+ *
+ * With the number of inputs known when compiling, the loop over them is
+ * unrolled, and the operation is a table lookup with no branches on the
+ * gate type.
+ *
+ * @tparam Op What the gate computes, not a flip flop
+ * @tparam Arity Number of inputs, 0 if only known when running
+ */
+template<CompiledCircuit::NodeTypes Op, int Arity>
+struct GateKernel
+{
+    /**
+     * Compute the output of the gate
+     * @param signals Value of every signal
+     * @param inputs Input signals of the gate
+     * @param count Number of inputs, used only when Arity is 0
+     * @param table Truth table of a Lut gate
+     * @return SignalZero, SignalOne or SignalUnknown
+     */
+    static unsigned char Evaluate(const unsigned char* signals, const int* inputs, int count, uint64_t table)
+    {
+        const int n = Arity > 0 ? Arity : count;
+
+        if constexpr (Op == CompiledCircuit::NodeTypes::Not)
+        {
+            // With more than one input this is NOR, as in EvaluateCombinational
+            auto value = signals[inputs[0]];
+            for (int i = 1; i < n; i++)
+            {
+                value = Logic3<CompiledCircuit::NodeTypes::Or>::Table[value][signals[inputs[i]]];
+            }
+            return Not3[value];
+        }
+        else if constexpr (Op == CompiledCircuit::NodeTypes::Lut)
+        {
+            // Input i is bit i of the row of the table
+            uint64_t row = 0;
+            unsigned char unknown = 0;
+            for (int i = 0; i < n; i++)
+            {
+                auto value = signals[inputs[i]];
+                unknown |= value >> 1;
+                row |= uint64_t(value & 1) << i;
+            }
+            return unknown ? SignalUnknown : ((table >> row) & 1) ? SignalOne : SignalZero;
+        }
+        else
+        {
+            auto value = signals[inputs[0]];
+            for (int i = 1; i < n; i++)
+            {
+                value = Logic3<Op>::Table[value][signals[inputs[i]]];
+            }
+            return value;
+        }
+    }
+
+    /**
+     * Compute the outputs of a run of gates, stored one after another
+     * @param signals Value of every signal
+     * @param inputs Input signals of the gates, arity for each gate
+     * @param outputs Output signal of each gate
+     * @param tables Truth table of each gate
+     * @param arity Number of inputs of each gate, used only when Arity is 0
+     * @param count Number of gates
+     */
+    static void EvaluateRun(unsigned char* signals, const int* inputs, const int* outputs, const uint64_t* tables,
+                            int arity, int count)
+    {
+        const int n = Arity > 0 ? Arity : arity;
+        for (int k = 0; k < count; k++)
+        {
+            signals[outputs[k]] = Evaluate(signals, inputs + k * n, n, tables[k]);
+        }
+    }
+};
+
+/**
+ * Chooses the kernel that evaluates a node
+ */
+class GateKernels
+{
+public:
+    /// Largest number of inputs with a kernel of its own, more use the general one
+    static const int MaxArity = 8;
+
+    static CompiledCircuit::Kernel Find(CompiledCircuit::NodeTypes type, int arity);
+    static CompiledCircuit::RunKernel FindRun(CompiledCircuit::NodeTypes type, int arity);
+};
+
+#endif //GATEKERNELS_H
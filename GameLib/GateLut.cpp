@@ -0,0 +1,76 @@
+/**
+ * @file GateLut.cpp
+ * @author Rachel Jansen
+ */
+
+#include "pch.h"
+#include "GateLut.h"
+
+#include "VisitorBase.h"
+#include <algorithm>
+
+/**
+ * Constructor
+ * @param game the game this gate is in
+ * @param inputs number of inputs, 1 to MaxLutInputs
+ * @param table the truth table
+ */
+GateLut::GateLut(Game* game, int inputs, uint64_t table) :
+	GateBlock(game, std::clamp(inputs, 1, MaxLutInputs))
+{
+	SetTable(table);
+}
+
+/**
+ * Set the truth table, ignoring bits past the last combination of inputs
+ * @param table Truth table, bit n is the output for inputs n
+ */
+void GateLut::SetTable(uint64_t table)
+{
+	auto entries = 1u << GetInputCount();
+	mTable = entries < 64 ? table & ((uint64_t(1) << entries) - 1) : table;
+}
+
+/**
+ * Compute the output by looking up the packed input bits in the table
+ * @param inputs Input states, input i in bit i
+ * @return True if the output is one
+ */
+bool GateLut::Evaluate(unsigned int inputs) const
+{
+	return ((mTable >> inputs) & 1) != 0;
+}
+
+/**
+ * Get the label drawn in the gate
+ * @return Label text
+ */
+wxString GateLut::GetLabel() const
+{
+	return L"LUT";
+}
+
+/**
+ * Accept a visitor
+ * @param visitor the visitor we are accepting
+ */
+void GateLut::Accept(VisitorBase* visitor)
+{
+	visitor->VisitGateLut(this);
+}
+
+/**
+ * Load the truth table from the XML for the gate
+ * @param node The XML node to load from
+ */
+void GateLut::XmlLoad(wxXmlNode* node)
+{
+	Gate::XmlLoad(node);
+
+	// Accepts decimal or 0x hexadecimal
+	wxULongLong_t table = 0;
+	if (node->GetAttribute(L"table", L"0").ToULongLong(&table, 0))
+	{
+		SetTable(table);
+	}
+}
@@ -0,0 +1,49 @@
+/**
+ * @file GateLut.h
+ * @author Rachel Jansen
+ *
+ * Class to represent a lookup table gate
+ */
+
+#ifndef GATELUT_H
+#define GATELUT_H
+
+#include <cstdint>
+
+#include "GateBlock.h"
+
+/// Most inputs a lookup table gate can have, so the table fits in 64 bits
+const int MaxLutInputs = 6;
+
+/**
+ * Class to represent a lookup table gate.
+ *
+ * The gate computes any function of up to six inputs. Bit n of the
+ * truth table is the output when the inputs, read as a binary number
+ * with input 0 as the lowest bit, equal n.
+ */
+class GateLut : public GateBlock
+{
+private:
+	/// The truth table
+	uint64_t mTable;
+
+protected:
+	bool Evaluate(unsigned int inputs) const override;
+	wxString GetLabel() const override;
+
+public:
+	GateLut(Game* game, int inputs, uint64_t table = 0);
+	void Accept(VisitorBase *visitor) override;
+	void XmlLoad(wxXmlNode* node) override;
+
+	/**
+	 * Get the truth table
+	 * @return Truth table, bit n is the output for inputs n
+	 */
+	uint64_t GetTable() const { return mTable; }
+
+	void SetTable(uint64_t table);
+};
+
+#endif //GATELUT_H
@@ -0,0 +1,203 @@
+/**
+ * @file GateMacro.cpp
+ * @author Rachel Jansen
+ */
+
+#include "pch.h"
+#include "GateMacro.h"
+
+#include "VisitorBase.h"
+#include <algorithm>
+
+/// Width of a macro gate in pixels
+const int MacroGateWidth = 80;
+
+/// Vertical space for each pin in pixels
+const int MacroGatePinSpacing = 20;
+
+/// Smallest height of a macro gate in pixels
+const int MacroGateMinHeight = 50;
+
+/// Size of the name font in pixels
+const int MacroGateFontSize = 13;
+
+/**
+ * Constructor
+ * @param game the game this gate is in
+ * @param definition the sub-circuit this gate places
+ */
+GateMacro::GateMacro(Game* game, std::shared_ptr<const MacroDefinition> definition) :
+	Gate(game), mDefinition(definition)
+{
+	auto pinCount = std::max(definition->GetInputCount(), definition->GetOutputCount());
+	SetSize(wxSize(MacroGateWidth, std::max(MacroGateMinHeight, pinCount * MacroGatePinSpacing)));
+
+	std::vector<int> inputs;
+	for (int i = 0; i < definition->GetInputCount(); i++)
+	{
+		mInputPins.push_back(std::make_shared<Pin>(0, 0, true, this));
+		inputs.push_back(mCircuit.AddSignal());
+		mCircuit.BindSource(inputs.back(), mInputPins.back().get());
+	}
+
+	std::vector<int> outputs;
+	for (int o = 0; o < definition->GetOutputCount(); o++)
+	{
+		auto pin = std::make_shared<Pin>(0, 0, false, this);
+		(o == 0 ? mOutputPins.first : mOutputPins.second) = pin;
+		outputs.push_back(mCircuit.AddSignal());
+		mCircuit.BindSink(outputs.back(), pin.get());
+	}
+
+	definition->Instantiate(&mCircuit, inputs, outputs);
+	mCircuit.Finalize();
+
+	UpdatePinPositions();
+}
+
+/**
+ * Draws the gate as a box with the name of the macro
+ * @param graphics the graphics context used to draw the gate
+ */
+void GateMacro::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+{
+	for (auto& pin : mInputPins)
+	{
+		pin->Draw(graphics);
+	}
+	for (auto& pin : {mOutputPins.first, mOutputPins.second})
+	{
+		if (pin != nullptr)
+		{
+			pin->Draw(graphics);
+		}
+	}
+
+	auto x = GetX();
+	auto y = GetY();
+	auto w = GetWidth();
+	auto h = GetHeight();
+
+	graphics->SetPen(*wxBLACK_PEN);
+	graphics->SetBrush(*wxWHITE_BRUSH);
+	graphics->DrawRectangle(x - w / 2, y - h / 2, w, h);
+
+	auto font = graphics->CreateFont(MacroGateFontSize, L"Arial", wxFONTFLAG_BOLD, *wxBLACK);
+	graphics->SetFont(font);
+
+	double textWidth, textHeight;
+	graphics->GetTextExtent(mDefinition->GetName(), &textWidth, &textHeight);
+	graphics->DrawText(mDefinition->GetName(), x - textWidth / 2, y - textHeight / 2);
+}
+
+/**
+ * Updates the output pins by evaluating the sub-circuit
+ */
+void GateMacro::UpdateOutputPin()
+{
+	mCircuit.Run();
+}
+
+/**
+ * Update the position of the pins relative to the gate (for dragging gate)
+ */
+void GateMacro::UpdatePinPositions()
+{
+	auto top = GetY() - GetHeight() / 2;
+
+	auto spacing = GetHeight() / std::max<size_t>(mInputPins.size(), 1);
+	for (size_t i = 0; i < mInputPins.size(); i++)
+	{
+		mInputPins[i]->SetPosition(GetX() - GetWidth() / 2 - DefaultLineLength, top + spacing * (i + 0.5));
+	}
+
+	spacing = GetHeight() / std::max(mDefinition->GetOutputCount(), 1);
+	if (mOutputPins.first != nullptr)
+	{
+		mOutputPins.first->SetPosition(GetX() + GetWidth() / 2 + DefaultLineLength, top + spacing * 0.5);
+	}
+	if (mOutputPins.second != nullptr)
+	{
+		mOutputPins.second->SetPosition(GetX() + GetWidth() / 2 + DefaultLineLength, top + spacing * 1.5);
+	}
+}
+
+/**
+ * Accept a visitor
+ * @param visitor the visitor we are accepting
+ */
+void GateMacro::Accept(VisitorBase* visitor)
+{
+	visitor->VisitGateMacro(this);
+}
+
+/**
+ * Check if we clicked on an output pin
+ * @param x x coordinate of click
+ * @param y y coordinate of click
+ * @return Pointer to the output pin if we clicked it, nullptr otherwise
+ */
+std::shared_ptr<IDraggable> GateMacro::HitDraggable(int x, int y)
+{
+	for (auto& pin : {mOutputPins.first, mOutputPins.second})
+	{
+		if (pin != nullptr && pin->HitTest(x, y))
+		{
+			return pin;
+		}
+	}
+	return nullptr;
+}
+
+/**
+ * Try to connect the pin we are dragging from to each of the input pins on the gate
+ * @param pin The pin we are dragging from
+ * @param lineEnd The end of the line we are dragging
+ * @return True if a connection occurs, false otherwise
+ */
+bool GateMacro::Connect(Pin* pin, wxPoint lineEnd)
+{
+	for (auto& input : mInputPins)
+	{
+		if (pin->Connect(input.get(), lineEnd))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Setter for control points
+ * @param show whether or not we should show control points
+ */
+void GateMacro::SetShowControlPoints(bool show)
+{
+	for (auto& pin : {mOutputPins.first, mOutputPins.second})
+	{
+		if (pin != nullptr)
+		{
+			pin->SetShowControlPoints(show);
+		}
+	}
+}
+
+/**
+ * Save the pins and the state of the sub-circuit
+ * @param state Buffer to save into
+ */
+void GateMacro::SaveState(GameState* state)
+{
+	Gate::SaveState(state);
+	mCircuit.SaveState(state);
+}
+
+/**
+ * Restore the pins and the state of the sub-circuit
+ * @param state Buffer to restore from
+ */
+void GateMacro::RestoreState(GameState* state)
+{
+	Gate::RestoreState(state);
+	mCircuit.RestoreState(state);
+}
@@ -0,0 +1,67 @@
+/**
+ * @file GateMacro.h
+ * @author Rachel Jansen
+ *
+ * Class to represent a gate made from a saved sub-circuit
+ */
+
+#ifndef GATEMACRO_H
+#define GATEMACRO_H
+
+#include "Gate.h"
+#include "MacroDefinition.h"
+
+/**
+ * Class to represent a gate made from a saved sub-circuit.
+ *
+ * On its own the gate evaluates a private copy of the sub-circuit.
+ * CircuitCompiler instead copies the sub-circuit's gates into the
+ * compiled netlist, so the gate adds no cost of its own there.
+ */
+class GateMacro : public Gate
+{
+private:
+	/// The sub-circuit this gate places
+	std::shared_ptr<const MacroDefinition> mDefinition;
+
+	/// Input pins, top to bottom
+	std::vector<std::shared_ptr<Pin>> mInputPins;
+
+	/// Output pins, the second may be nullptr
+	std::pair<std::shared_ptr<Pin>, std::shared_ptr<Pin>> mOutputPins;
+
+	/// Copy of the sub-circuit used when the gate updates itself
+	CompiledCircuit mCircuit;
+
+public:
+	GateMacro(Game* game, std::shared_ptr<const MacroDefinition> definition);
+	void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+	void UpdateOutputPin() override;
+	void UpdatePinPositions() override;
+	void Accept(VisitorBase *visitor) override;
+	std::shared_ptr<IDraggable> HitDraggable(int x, int y) override;
+	bool Connect(Pin *pin, wxPoint lineEnd) override;
+	void SetShowControlPoints(bool show) override;
+	void SaveState(GameState* state) override;
+	void RestoreState(GameState* state) override;
+
+	/**
+	 * Get the output pins of the gate
+	 * @return a pair containing pointers to the pins, the second is nullptr for a single output
+	 */
+	std::pair<std::shared_ptr<Pin>, std::shared_ptr<Pin>> GetOutputPins() override { return mOutputPins; }
+
+	/**
+	 * Get the input pins for this gate
+	 * @return Vector of input pins
+	 */
+	std::vector<std::shared_ptr<Pin>> GetInputPins() override { return mInputPins; }
+
+	/**
+	 * Get the sub-circuit this gate places
+	 * @return The definition
+	 */
+	std::shared_ptr<const MacroDefinition> GetDefinition() const { return mDefinition; }
+};
+
+#endif //GATEMACRO_H
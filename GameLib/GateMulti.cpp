@@ -0,0 +1,79 @@
+/**
+ * @file GateMulti.cpp
+ * @author Rachel Jansen
+ */
+
+#include "pch.h"
+#include "GateMulti.h"
+
+#include "VisitorBase.h"
+#include <algorithm>
+
+/**
+ * Constructor
+ * @param game the game this gate is in
+ * @param operation the operation the gate computes
+ * @param inputs number of inputs, 2 to MaxMultiGateInputs
+ */
+GateMulti::GateMulti(Game* game, Operations operation, int inputs) :
+	GateBlock(game, std::clamp(inputs, 2, MaxMultiGateInputs)), mOperation(operation)
+{
+}
+
+/**
+ * Compute the output from the packed input bits
+ * @param inputs Input states, input i in bit i
+ * @return True if the output is one
+ */
+bool GateMulti::Evaluate(unsigned int inputs) const
+{
+	switch (mOperation)
+	{
+	case Operations::And:
+		return inputs == (1u << GetInputCount()) - 1;
+
+	case Operations::Or:
+		return inputs != 0;
+
+	case Operations::Xor:
+		{
+			// Fold the bits together to get the parity
+			inputs ^= inputs >> 4;
+			inputs ^= inputs >> 2;
+			inputs ^= inputs >> 1;
+			return (inputs & 1) != 0;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Get the label drawn in the gate, in the style of the IEC gate symbols
+ * @return Label text
+ */
+wxString GateMulti::GetLabel() const
+{
+	switch (mOperation)
+	{
+	case Operations::And:
+		return L"&";
+
+	case Operations::Or:
+		return L"\u22651";
+
+	case Operations::Xor:
+		return L"=1";
+	}
+
+	return L"";
+}
+
+/**
+ * Accept a visitor
+ * @param visitor the visitor we are accepting
+ */
+void GateMulti::Accept(VisitorBase* visitor)
+{
+	visitor->VisitGateMulti(this);
+}
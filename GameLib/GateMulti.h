@@ -0,0 +1,44 @@
+/**
+ * @file GateMulti.h
+ * @author Rachel Jansen
+ *
+ * Class to represent And, Or and Xor gates with any number of inputs
+ */
+
+#ifndef GATEMULTI_H
+#define GATEMULTI_H
+
+#include "GateBlock.h"
+
+/// Most inputs a multi-input gate can have
+const int MaxMultiGateInputs = 8;
+
+/**
+ * Class to represent And, Or and Xor gates with any number of inputs
+ */
+class GateMulti : public GateBlock
+{
+public:
+	/// The operation the gate computes
+	enum class Operations {And, Or, Xor};
+
+private:
+	/// The operation the gate computes
+	Operations mOperation;
+
+protected:
+	bool Evaluate(unsigned int inputs) const override;
+	wxString GetLabel() const override;
+
+public:
+	GateMulti(Game* game, Operations operation, int inputs);
+	void Accept(VisitorBase *visitor) override;
+
+	/**
+	 * Get the operation the gate computes
+	 * @return The operation
+	 */
+	Operations GetOperation() const { return mOperation; }
+};
+
+#endif //GATEMULTI_H
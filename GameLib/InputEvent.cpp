@@ -0,0 +1,176 @@
+/**
+ * @file InputEvent.cpp
+ * @author Navanidhiy Achuthan Kumaraguru
+ */
+
+#include "pch.h"
+#include "InputEvent.h"
+#include "Game.h"
+#include "Gate.h"
+#include "ItemFactory.h"
+
+/// Gate type names, the index is stored in the event value
+const std::wstring GateTypeNames[] = {L"and", L"or", L"not", L"sr-flipflop", L"d-flipflop"};
+
+/// Number of gate type names
+const int GateTypeCount = sizeof(GateTypeNames) / sizeof(GateTypeNames[0]);
+
+/**
+ * Create an event for one simulation tick
+ * @param elapsed Time passed to Game::Update in seconds
+ * @return The event
+ */
+InputEvent InputEvent::Tick(double elapsed)
+{
+    InputEvent event;
+    event.mType = Types::Tick;
+    event.mElapsed = elapsed;
+    return event;
+}
+
+/**
+ * Create an event for a mouse button press
+ * @param x X location passed to Game::OnLeftDown
+ * @param y Y location passed to Game::OnLeftDown
+ * @return The event
+ */
+InputEvent InputEvent::LeftDown(int x, int y)
+{
+    InputEvent event;
+    event.mType = Types::LeftDown;
+    event.mX = x;
+    event.mY = y;
+    return event;
+}
+
+/**
+ * Create an event for a mouse move
+ * @param x X location of the mouse
+ * @param y Y location of the mouse
+ * @param leftDown True if the left button is down
+ * @return The event
+ */
+InputEvent InputEvent::MouseMove(int x, int y, bool leftDown)
+{
+    InputEvent event;
+    event.mType = Types::MouseMove;
+    event.mX = x;
+    event.mY = y;
+    event.mValue = leftDown ? 1 : 0;
+    return event;
+}
+
+/**
+ * Create an event for adding a gate
+ * @param type Gate type name, as used by ItemFactory::CreateGate
+ * @param x X location of the center of the new gate
+ * @param y Y location of the center of the new gate
+ * @return The event
+ */
+InputEvent InputEvent::AddGate(const std::wstring& type, int x, int y)
+{
+    InputEvent event;
+    event.mType = Types::AddGate;
+    event.mX = x;
+    event.mY = y;
+
+    // An unknown type stays -1 and adds no gate when applied
+    event.mValue = -1;
+    for (int i = 0; i < GateTypeCount; i++)
+    {
+        if (GateTypeNames[i] == type)
+        {
+            event.mValue = i;
+            break;
+        }
+    }
+    return event;
+}
+
+/**
+ * Create an event for dropping a wire dragged from a pin
+ * @param pinX X location of the pin the wire was dragged from
+ * @param pinY Y location of the pin the wire was dragged from
+ * @param lineEnd Location the wire was dropped
+ * @return The event
+ */
+InputEvent InputEvent::Connect(int pinX, int pinY, wxPoint lineEnd)
+{
+    InputEvent event;
+    event.mType = Types::Connect;
+    event.mX = pinX;
+    event.mY = pinY;
+    event.mEndX = lineEnd.x;
+    event.mEndY = lineEnd.y;
+    return event;
+}
+
+/**
+ * Create an event for selecting a level
+ * @param level Level number
+ * @return The event
+ */
+InputEvent InputEvent::SelectLevel(int level)
+{
+    InputEvent event;
+    event.mType = Types::SelectLevel;
+    event.mValue = level;
+    return event;
+}
+
+/**
+ * Apply this event to a game, the same way the view does
+ * @param game Game to apply the event to
+ */
+void InputEvent::Apply(Game* game) const
+{
+    switch (mType)
+    {
+        case Types::Tick:
+            game->Update(mElapsed);
+            break;
+
+        case Types::LeftDown:
+            game->OnLeftDown(mX, mY);
+            break;
+
+        case Types::MouseMove:
+        {
+            wxMouseEvent event(wxEVT_MOTION);
+            event.SetPosition(wxPoint(mX, mY));
+            event.SetLeftDown(mValue != 0);
+            game->OnMouseMove(event);
+            break;
+        }
+
+        case Types::AddGate:
+        {
+            if (mValue < 0 || mValue >= GateTypeCount)
+            {
+                break;
+            }
+
+            auto gate = ItemFactory::CreateGate(GateTypeNames[mValue], game);
+            gate->SetLocation(mX, mY);
+            gate->UpdateGeometry();
+            game->AddItem(gate);
+            game->UpdateGateCount();
+            break;
+        }
+
+        case Types::Connect:
+        {
+            // The pin is found again by its location, pointers do not survive a replay
+            auto pin = std::dynamic_pointer_cast<Pin>(game->HitTest(mX, mY));
+            if (pin != nullptr)
+            {
+                game->TryToConnect(pin.get(), wxPoint(mEndX, mEndY));
+            }
+            break;
+        }
+
+        case Types::SelectLevel:
+            game->LoadLevel(mValue);
+            break;
+    }
+}
@@ -0,0 +1,121 @@
+/**
+ * @file InputEvent.h
+ * @author Navanidhiy Achuthan Kumaraguru
+ *
+ * A single user action that can be recorded and applied to a game
+ */
+
+#ifndef INPUTEVENT_H
+#define INPUTEVENT_H
+
+#include <string>
+
+class Game;
+
+/**
+ * A single user action, or the passing of one simulation tick.
+ *
+ * Events carry everything needed to apply them to a Game again, so
+ * a recorded sequence of events reproduces a session exactly.
+ */
+class InputEvent
+{
+public:
+    /// The kinds of events
+    enum class Types : unsigned char
+    {
+        Tick,        ///< One call to Game::Update
+        LeftDown,    ///< Mouse button pressed, this also clicks the conveyor panel
+        MouseMove,   ///< Mouse moved, with or without the button down
+        AddGate,     ///< Gate added from the gate menu
+        Connect,     ///< Wire dragged from a pin and dropped
+        SelectLevel  ///< Level chosen from the level menu
+    };
+
+private:
+    /// The kind of event
+    Types mType = Types::Tick;
+
+    /// Simulation tick the event happened on
+    unsigned int mTick = 0;
+
+    int mX = 0;       ///< X location of the event in pixels
+    int mY = 0;       ///< Y location of the event in pixels
+    int mEndX = 0;    ///< X location of the end of a dragged wire
+    int mEndY = 0;    ///< Y location of the end of a dragged wire
+
+    /// Button state, gate type or level number, depending on the type
+    int mValue = 0;
+
+    /// Time elapsed for a tick in seconds
+    double mElapsed = 0;
+
+public:
+    static InputEvent Tick(double elapsed);
+    static InputEvent LeftDown(int x, int y);
+    static InputEvent MouseMove(int x, int y, bool leftDown);
+    static InputEvent AddGate(const std::wstring& type, int x, int y);
+    static InputEvent Connect(int pinX, int pinY, wxPoint lineEnd);
+    static InputEvent SelectLevel(int level);
+
+    void Apply(Game* game) const;
+
+    /**
+     * Get the kind of event
+     * @return Event type
+     */
+    Types GetType() const { return mType; }
+
+    /**
+     * Get the simulation tick the event happened on
+     * @return Tick number
+     */
+    unsigned int GetTick() const { return mTick; }
+
+    /**
+     * Set the simulation tick the event happened on
+     * @param tick Tick number
+     */
+    void SetTick(unsigned int tick) { mTick = tick; }
+
+    /**
+     * Get the X location of the event
+     * @return X location in pixels
+     */
+    int GetX() const { return mX; }
+
+    /**
+     * Get the Y location of the event
+     * @return Y location in pixels
+     */
+    int GetY() const { return mY; }
+
+    /**
+     * Set the location of the event
+     * @param x X location in pixels
+     * @param y Y location in pixels
+     */
+    void SetLocation(int x, int y) { mX = x; mY = y; }
+
+    /**
+     * Get the end of a dragged wire
+     * @return Wire end in pixels
+     */
+    wxPoint GetLineEnd() const { return wxPoint(mEndX, mEndY); }
+
+    /**
+     * Get the button state, gate type or level number
+     * @return Value for this event type
+     */
+    int GetValue() const { return mValue; }
+
+    /**
+     * Get the time elapsed for a tick
+     * @return Elapsed time in seconds
+     */
+    double GetElapsed() const { return mElapsed; }
+
+    friend class InputLog;
+};
+
+#endif //INPUTEVENT_H
@@ -0,0 +1,303 @@
+/**
+ * @file InputLog.cpp
+ * @author Navanidhiy Achuthan Kumaraguru
+ */
+
+#include "pch.h"
+#include "InputLog.h"
+#include "TraceRecorder.h"
+#include <wx/ffile.h>
+#include <cstring>
+
+/// Bytes at the start of every input log file
+const unsigned char InputLogMagic[] = {'S', 'B', 'I', 'L'};
+
+/// Version of the input log format
+const unsigned char InputLogVersion = 1;
+
+/**
+ * Append an unsigned integer using 7 bits per byte
+ * @param data Buffer to append to
+ * @param value Value to append
+ */
+static void PutVarint(std::vector<unsigned char>& data, unsigned int value)
+{
+    while (value >= 0x80)
+    {
+        data.push_back((unsigned char)(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back((unsigned char)value);
+}
+
+/**
+ * Append a signed integer, small negative numbers stay short
+ * @param data Buffer to append to
+ * @param value Value to append
+ */
+static void PutSigned(std::vector<unsigned char>& data, int value)
+{
+    PutVarint(data, ((unsigned int)value << 1) ^ (unsigned int)(value >> 31));
+}
+
+/**
+ * Read an unsigned integer written by PutVarint
+ * @param data Buffer to read from
+ * @param pos Read position, advanced past the value
+ * @param value Set to the value read
+ * @return False if the buffer ended early
+ */
+static bool GetVarint(const std::vector<unsigned char>& data, size_t& pos, unsigned int& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 35; shift += 7)
+    {
+        if (pos >= data.size())
+        {
+            return false;
+        }
+
+        auto byte = data[pos++];
+        value |= (unsigned int)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Read a signed integer written by PutSigned
+ * @param data Buffer to read from
+ * @param pos Read position, advanced past the value
+ * @param value Set to the value read
+ * @return False if the buffer ended early
+ */
+static bool GetSigned(const std::vector<unsigned char>& data, size_t& pos, int& value)
+{
+    unsigned int raw;
+    if (!GetVarint(data, pos, raw))
+    {
+        return false;
+    }
+    value = int(raw >> 1) ^ -int(raw & 1);
+    return true;
+}
+
+/**
+ * Start a new recording, discarding any previous events
+ */
+void InputLog::Start()
+{
+    mEvents.clear();
+    mTick = 0;
+    mRecording = true;
+}
+
+/**
+ * Record an event if we are recording
+ * @param event The event, it is stamped with the current tick
+ */
+void InputLog::Record(InputEvent event)
+{
+    if (!mRecording)
+    {
+        return;
+    }
+
+    event.SetTick(mTick);
+    mEvents.push_back(event);
+
+    if (event.GetType() == InputEvent::Types::Tick)
+    {
+        ++mTick;
+    }
+}
+
+/**
+ * Encode the events into the binary log format.
+ *
+ * Every event is its type, the number of ticks since the previous
+ * event and the fields that type uses, all as variable length integers
+ * except the tick time which is stored exactly.
+ *
+ * @return The encoded log
+ */
+std::vector<unsigned char> InputLog::Encode() const
+{
+    std::vector<unsigned char> data(std::begin(InputLogMagic), std::end(InputLogMagic));
+    data.push_back(InputLogVersion);
+
+    unsigned int tick = 0;
+    for (auto& event : mEvents)
+    {
+        data.push_back((unsigned char)event.mType);
+        PutVarint(data, event.mTick - tick);
+        tick = event.mTick;
+
+        switch (event.mType)
+        {
+            case InputEvent::Types::Tick:
+            {
+                unsigned char bytes[sizeof(double)];
+                std::memcpy(bytes, &event.mElapsed, sizeof(double));
+                data.insert(data.end(), std::begin(bytes), std::end(bytes));
+                break;
+            }
+
+            case InputEvent::Types::Connect:
+                PutSigned(data, event.mX);
+                PutSigned(data, event.mY);
+                PutSigned(data, event.mEndX);
+                PutSigned(data, event.mEndY);
+                break;
+
+            case InputEvent::Types::SelectLevel:
+                PutSigned(data, event.mValue);
+                break;
+
+            default:
+                PutSigned(data, event.mX);
+                PutSigned(data, event.mY);
+                PutSigned(data, event.mValue);
+                break;
+        }
+    }
+
+    return data;
+}
+
+/**
+ * Decode events from the binary log format
+ * @param data The encoded log
+ * @return False if the data is not a valid log, the events are then empty
+ */
+bool InputLog::Decode(const std::vector<unsigned char>& data)
+{
+    mEvents.clear();
+    mRecording = false;
+
+    if (data.size() < sizeof(InputLogMagic) + 1 ||
+        std::memcmp(data.data(), InputLogMagic, sizeof(InputLogMagic)) != 0 ||
+        data[sizeof(InputLogMagic)] != InputLogVersion)
+    {
+        return false;
+    }
+
+    size_t pos = sizeof(InputLogMagic) + 1;
+    unsigned int tick = 0;
+    unsigned int ticks = 0;
+    while (pos < data.size())
+    {
+        InputEvent event;
+        event.mType = InputEvent::Types(data[pos++]);
+
+        unsigned int delta;
+        bool ok = GetVarint(data, pos, delta);
+        tick += delta;
+        event.mTick = tick;
+
+        switch (event.mType)
+        {
+            case InputEvent::Types::Tick:
+                ok = ok && pos + sizeof(double) <= data.size();
+                if (ok)
+                {
+                    std::memcpy(&event.mElapsed, &data[pos], sizeof(double));
+                    pos += sizeof(double);
+                }
+                break;
+
+            case InputEvent::Types::Connect:
+                ok = ok && GetSigned(data, pos, event.mX) && GetSigned(data, pos, event.mY) &&
+                     GetSigned(data, pos, event.mEndX) && GetSigned(data, pos, event.mEndY);
+                break;
+
+            case InputEvent::Types::SelectLevel:
+                ok = ok && GetSigned(data, pos, event.mValue);
+                break;
+
+            case InputEvent::Types::LeftDown:
+            case InputEvent::Types::MouseMove:
+            case InputEvent::Types::AddGate:
+                ok = ok && GetSigned(data, pos, event.mX) && GetSigned(data, pos, event.mY) &&
+                     GetSigned(data, pos, event.mValue);
+                break;
+
+            default:
+                ok = false;
+                break;
+        }
+
+        if (!ok)
+        {
+            mEvents.clear();
+            return false;
+        }
+
+        if (event.mType == InputEvent::Types::Tick)
+        {
+            ++ticks;
+        }
+        mEvents.push_back(event);
+    }
+
+    // Each tick is stamped with the number of ticks before it, so recording
+    // resumes counting after the last one
+    mTick = ticks;
+    return true;
+}
+
+/**
+ * Save the events to a file
+ * @param filename File to write
+ * @return True if the file was written
+ */
+bool InputLog::Save(const wxString& filename) const
+{
+    wxFFile file(filename, L"wb");
+    if (!file.IsOpened())
+    {
+        return false;
+    }
+
+    auto data = Encode();
+    return file.Write(data.data(), data.size()) == data.size() && file.Close();
+}
+
+/**
+ * Load events from a file
+ * @param filename File to read
+ * @return True if the file is a valid input log
+ */
+bool InputLog::Load(const wxString& filename)
+{
+    wxFFile file(filename, L"rb");
+    if (!file.IsOpened())
+    {
+        return false;
+    }
+
+    std::vector<unsigned char> data(size_t(file.Length()));
+    if (file.Read(data.data(), data.size()) != data.size())
+    {
+        return false;
+    }
+
+    return Decode(data);
+}
+
+/**
+ * Replay the events against a game as fast as possible
+ * @param game Game to drive, usually one that is not attached to a view
+ */
+void InputLog::Replay(Game* game) const
+{
+    TraceScope trace("InputLog::Replay", "input");
+
+    for (auto& event : mEvents)
+    {
+        event.Apply(game);
+    }
+}
@@ -0,0 +1,71 @@
+/**
+ * @file InputLog.h
+ * @author Navanidhiy Achuthan Kumaraguru
+ *
+ * Records user actions and replays them against a game
+ */
+
+#ifndef INPUTLOG_H
+#define INPUTLOG_H
+
+#include <vector>
+#include "InputEvent.h"
+
+class Game;
+
+/**
+ * Class that records user actions with the simulation tick they
+ * happened on, saves them in a compact binary file, and replays them.
+ *
+ * Replaying drives Game directly as fast as it can run, with the same
+ * elapsed time for every tick as the recording, so the results are
+ * the same as the recorded session.
+ */
+class InputLog
+{
+private:
+    /// The recorded events in order
+    std::vector<InputEvent> mEvents;
+
+    /// Number of ticks recorded so far
+    unsigned int mTick = 0;
+
+    /// Are we recording?
+    bool mRecording = false;
+
+public:
+    void Start();
+
+    /**
+     * Stop recording, the events are kept
+     */
+    void Stop() { mRecording = false; }
+
+    /**
+     * Are we recording?
+     * @return True if events passed to Record are kept
+     */
+    bool IsRecording() const { return mRecording; }
+
+    void Record(InputEvent event);
+
+    /**
+     * Get the recorded events
+     * @return Events in the order they happened
+     */
+    const std::vector<InputEvent>& GetEvents() const { return mEvents; }
+
+    /**
+     * Get the number of ticks recorded or decoded
+     * @return Number of tick events
+     */
+    unsigned int GetTickCount() const { return mTick; }
+
+    std::vector<unsigned char> Encode() const;
+    bool Decode(const std::vector<unsigned char>& data);
+    bool Save(const wxString& filename) const;
+    bool Load(const wxString& filename);
+    void Replay(Game* game) const;
+};
+
+#endif //INPUTLOG_H
@@ -42,5 +42,9 @@ void Item::XmlLoad(wxXmlNode* node)
      node->GetAttribute(L"x", L"0").ToDouble(&mX);
      node->GetAttribute(L"y", L"0").ToDouble(&mY);
 
+     long lane;
+     node->GetAttribute(L"lane", L"0").ToLong(&lane);
+     mLane = int(lane);
+
 }
 
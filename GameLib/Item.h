@@ -13,8 +13,12 @@ class Level;
 class Pin;
 #include "VisitorBase.h"
 #include "IDraggable.h"
+#include "GameState.h"
 
 
+/// Lane filter for visitors that matches items on every lane
+const int AllLanes = -1;
+
 /**
  * Class representing an item in the game
  */
@@ -33,6 +37,9 @@ private:
     double mHeight = 0; ///< Height of the item
     double mAspectRatio = 1.00; ///< default aspect ratio
 
+    /// Conveyor lane this item belongs to
+    int mLane = 0;
+
 public:
     virtual ~Item();
 
@@ -114,6 +121,12 @@ public:
      */
     virtual void Update(double elapsed) {}
 
+    /**
+     * Bring geometry that follows the item's location, such as pin
+     * positions, up to date, so drawing and hit testing only read it
+     */
+    virtual void UpdateGeometry() {}
+
     /**
      * Get the level this item is contained in
      * @return Pointer to the Level object
@@ -126,6 +139,18 @@ public:
      */
     void SetLevel(Level* level) { mLevel = level; }
 
+    /**
+     * Get the conveyor lane this item belongs to
+     * @return Lane number, 0 for levels with one conveyor
+     */
+    int GetLane() const { return mLane; }
+
+    /**
+     * Set the conveyor lane this item belongs to
+     * @param lane Lane number
+     */
+    void SetLane(int lane) { mLane = lane; }
+
 	/**
 	 * Sets the aspect ratio of the item
 	 * @param aspectRatio the aspect ratio of the item
@@ -165,6 +190,18 @@ public:
      * */
     virtual void SetShowControlPoints(bool show) {}
 
+    /**
+     * Save the mutable simulation state of this item
+     * @param state Buffer to save into
+     */
+    virtual void SaveState(GameState* state) {}
+
+    /**
+     * Restore state saved by SaveState
+     * @param state Buffer positioned where this item's state starts
+     */
+    virtual void RestoreState(GameState* state) {}
+
 
 protected:
     Item(Game* game);
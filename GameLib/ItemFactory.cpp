@@ -12,6 +12,14 @@
 #include "Scoreboard.h"
 #include "Product.h"
 #include "Game.h"
+#include "GateAnd.h"
+#include "GateOr.h"
+#include "GateNot.h"
+#include "GateSRFlipFlop.h"
+#include "GateDFlipFlop.h"
+#include "GateMulti.h"
+#include "GateLut.h"
+#include <cwchar>
 
 /**
  *
@@ -47,4 +55,61 @@ std::shared_ptr<Item> ItemFactory::CreateItem(const std::wstring& name, Game* ga
      }
 
      return nullptr;
-}
\ No newline at end of file
+}
+
+/**
+ * Create a gate from the name used for it in level files
+ * @param name the name of the gate type to add
+ * @param game the game this gate is in
+ * @return pointer to the gate or nullptr if the name is not the name of a gate
+ */
+std::shared_ptr<Gate> ItemFactory::CreateGate(const std::wstring& name, Game* game)
+{
+     if (name == L"and")
+     {
+         return std::make_shared<GateAnd>(game);
+     }
+     else if (name == L"or")
+     {
+         return std::make_shared<GateOr>(game);
+     }
+     else if (name == L"not")
+     {
+         return std::make_shared<GateNot>(game);
+     }
+     else if (name == L"sr-flipflop")
+     {
+         return std::make_shared<GateSRFlipFlop>(game);
+     }
+     else if (name == L"d-flipflop")
+     {
+         return std::make_shared<GateDFlipFlop>(game);
+     }
+
+     // Multi-input and lookup table gates carry their input count, as in "and-4" or "lut-3"
+     auto dash = name.find(L'-');
+     if (dash != std::wstring::npos)
+     {
+         auto prefix = name.substr(0, dash);
+         int inputs = std::wcstol(name.c_str() + dash + 1, nullptr, 10);
+
+         if (prefix == L"and" && inputs >= 2 && inputs <= MaxMultiGateInputs)
+         {
+             return std::make_shared<GateMulti>(game, GateMulti::Operations::And, inputs);
+         }
+         else if (prefix == L"or" && inputs >= 2 && inputs <= MaxMultiGateInputs)
+         {
+             return std::make_shared<GateMulti>(game, GateMulti::Operations::Or, inputs);
+         }
+         else if (prefix == L"xor" && inputs >= 2 && inputs <= MaxMultiGateInputs)
+         {
+             return std::make_shared<GateMulti>(game, GateMulti::Operations::Xor, inputs);
+         }
+         else if (prefix == L"lut" && inputs >= 1 && inputs <= MaxLutInputs)
+         {
+             return std::make_shared<GateLut>(game, inputs);
+         }
+     }
+
+     return nullptr;
+}
@@ -13,6 +13,7 @@
 
 class Item;
 class Game;
+class Gate;
 
 /**
  * Class to create items in the Level Class
@@ -21,6 +22,7 @@ class ItemFactory
 {
 public:
  static std::shared_ptr<Item> CreateItem(const std::wstring& name, Game* game);
+ static std::shared_ptr<Gate> CreateGate(const std::wstring& name, Game* game);
 };
 
 #endif // ITEMFACTORY_H
\ No newline at end of file
@@ -0,0 +1,111 @@
+/**
+ * @file ItemParking.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "ItemParking.h"
+#include "Item.h"
+#include <algorithm>
+
+/**
+ * Return every parked item to play on the next Apply
+ */
+void ItemParking::UnparkAll()
+{
+    mChanges.clear();
+    mUnparkAll = true;
+}
+
+/**
+ * Forget every parked item, such as when a new level is loaded
+ */
+void ItemParking::Clear()
+{
+    mParked.clear();
+    mChanges.clear();
+    mUnparkAll = false;
+}
+
+/**
+ * Is an item out of play?
+ * @param item Item to look for
+ * @return True if the item is parked
+ */
+bool ItemParking::IsParked(const Item* item) const
+{
+    return std::any_of(mParked.begin(), mParked.end(),
+                       [item](const std::pair<size_t, std::shared_ptr<Item>>& parked) {
+                           return parked.second.get() == item;
+                       });
+}
+
+/**
+ * Accept a visitor for the parked items only
+ * @param visitor The visitor
+ */
+void ItemParking::Accept(VisitorBase* visitor)
+{
+    for (auto& parked : mParked)
+    {
+        parked.second->Accept(visitor);
+    }
+}
+
+/**
+ * Put every parked item back into the item list at the index it was taken from.
+ *
+ * Each index is relative to the list as it was after the items parked
+ * before it, so the items go back newest first to undo the parking in order.
+ *
+ * @param items The game's items
+ */
+void ItemParking::UnparkAll(std::vector<std::shared_ptr<Item>>& items)
+{
+    items.reserve(items.size() + mParked.size());
+    for (auto parked = mParked.rbegin(); parked != mParked.rend(); ++parked)
+    {
+        items.insert(items.begin() + std::min(parked->first, items.size()), parked->second);
+    }
+    mParked.clear();
+}
+
+/**
+ * Park and return the items asked for since the last call
+ * @param items The game's items, which parked items are taken from and returned to
+ */
+void ItemParking::Apply(std::vector<std::shared_ptr<Item>>& items)
+{
+    if (mUnparkAll)
+    {
+        UnparkAll(items);
+        mUnparkAll = false;
+    }
+
+    for (auto& change : mChanges)
+    {
+        if (change.second)
+        {
+            auto found = std::find_if(items.begin(), items.end(),
+                                      [&change](const std::shared_ptr<Item>& item) { return item.get() == change.first; });
+            if (found != items.end())
+            {
+                mParked.emplace_back(size_t(found - items.begin()), *found);
+                items.erase(found);
+            }
+        }
+        else
+        {
+            auto found = std::find_if(mParked.begin(), mParked.end(),
+                                      [&change](const std::pair<size_t, std::shared_ptr<Item>>& parked) {
+                                          return parked.second.get() == change.first;
+                                      });
+            if (found != mParked.end())
+            {
+                items.insert(items.begin() + std::min(found->first, items.size()), found->second);
+                mParked.erase(found);
+            }
+        }
+    }
+    mChanges.clear();
+}
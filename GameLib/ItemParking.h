@@ -0,0 +1,67 @@
+/**
+ * @file ItemParking.h
+ * @author Attulya Pratap Gupta
+ *
+ * Items taken out of play, with the changes asked for during an update
+ */
+
+#ifndef ITEMPARKING_H
+#define ITEMPARKING_H
+
+#include <memory>
+#include <vector>
+#include <utility>
+
+class Item;
+class VisitorBase;
+
+/**
+ * Items taken out of play.
+ *
+ * Parking and returning items is only asked for while the game updates,
+ * and the items are only moved between the game's item list and the
+ * parked list by Apply, once nothing is iterating over the items.
+ * Returned items go back to the index they were taken from so they draw
+ * in the same order.
+ */
+class ItemParking
+{
+private:
+    /// Items taken out of play, with the index in the item list they were taken from
+    std::vector<std::pair<size_t, std::shared_ptr<Item>>> mParked;
+
+    /// Items to park (true) or return to play (false) on the next Apply
+    std::vector<std::pair<Item*, bool>> mChanges;
+
+    /// Return every parked item to play before making the changes in mChanges?
+    bool mUnparkAll = false;
+
+    void UnparkAll(std::vector<std::shared_ptr<Item>>& items);
+
+public:
+    /**
+     * Take an item out of play on the next Apply
+     * @param item Item to park
+     */
+    void Park(Item* item) { mChanges.emplace_back(item, true); }
+
+    /**
+     * Return a parked item to play on the next Apply
+     * @param item Item to return
+     */
+    void Unpark(Item* item) { mChanges.emplace_back(item, false); }
+
+    void UnparkAll();
+    void Clear();
+    void Apply(std::vector<std::shared_ptr<Item>>& items);
+    void Accept(VisitorBase* visitor);
+    bool IsParked(const Item* item) const;
+
+    /**
+     * Get the number of items out of play
+     * @return Number of parked items
+     */
+    size_t GetCount() const { return mParked.size(); }
+};
+
+#endif //ITEMPARKING_H
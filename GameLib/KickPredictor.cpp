@@ -0,0 +1,368 @@
+/**
+ * @file KickPredictor.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "KickPredictor.h"
+#include "CircuitCompiler.h"
+#include "CircuitOptimizer.h"
+#include "Game.h"
+#include "Product.h"
+#include "SensorOutput.h"
+#include "Beam.h"
+#include "Scoreboard.h"
+#include "Sparty.h"
+#include "VisitorBase.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <map>
+
+using NodeTypes = CompiledCircuit::NodeTypes;
+
+/// Number of products evaluated together in one word
+const int PredictorLanes = 64;
+
+/**
+ * Visitor that collects what the predictor needs from a game
+ */
+class PredictorVisitor : public VisitorBase
+{
+public:
+    int mLane = 0;                                  ///< Lane being predicted
+    Pin* mBeamPin = nullptr;                        ///< Output pin of the beam
+    Pin* mSpartyPin = nullptr;                      ///< Input pin of Sparty
+    std::map<Pin*, int> mSensorPins;                ///< Sensor output pins and the property each shows
+    std::vector<Product*> mProducts;                ///< Products on the belt
+    Scoreboard* mScoreboard = nullptr;              ///< Scoreboard with the good and bad points
+
+    /**
+     * Constructor
+     * @param lane Lane being predicted
+     */
+    explicit PredictorVisitor(int lane) : mLane(lane) {}
+
+    void VisitBeam(Beam* beam) override { if (beam->GetLane() == mLane) mBeamPin = beam->GetOutputPin().get(); }
+    void VisitSparty(Sparty* sparty) override { if (sparty->GetLane() == mLane) mSpartyPin = sparty->GetInputPin().get(); }
+    void VisitProduct(Product* product) override { if (product->GetLane() == mLane) mProducts.push_back(product); }
+    void VisitScoreboard(Scoreboard* scoreboard) override { mScoreboard = scoreboard; }
+
+    /**
+     * Visit a sensor output and remember the property it shows
+     * @param sensorOutput The sensor output
+     */
+    void VisitSensorOutput(SensorOutput* sensorOutput) override
+    {
+        if (sensorOutput->GetLane() == mLane)
+        {
+            mSensorPins[sensorOutput->GetOutputPin().get()] = static_cast<int>(sensorOutput->GetProperty());
+        }
+    }
+};
+
+/// A signal for every lane of a word, one bit per product
+struct LaneSignal
+{
+    uint64_t mOnes = 0;    ///< Lanes where the signal is one
+    uint64_t mUnknown = 0; ///< Lanes where the signal is unknown
+};
+
+/**
+ * Constructor
+ * @param circuit Circuit to predict with, read only through signals so no pins are touched
+ * @param root Signal read by Sparty
+ */
+KickPredictor::KickPredictor(std::unique_ptr<CompiledCircuit> circuit, int root) :
+    mCircuit(std::move(circuit)), mRoot(root)
+{
+    for (auto& node : mCircuit->GetNodes())
+    {
+        mStateful = mStateful || node.mType == NodeTypes::SRFlipFlop || node.mType == NodeTypes::DFlipFlop;
+    }
+}
+
+/**
+ * Build a predictor for the circuit and sensors of one lane of a game
+ * @param game Game to predict
+ * @param lane Lane to predict
+ * @return The predictor, or nullptr if nothing drives the lane's Sparty
+ */
+std::unique_ptr<KickPredictor> KickPredictor::Create(Game* game, int lane)
+{
+    PredictorVisitor visitor(lane);
+    game->Accept(&visitor);
+
+    auto compiled = CircuitCompiler::Compile(game);
+    CircuitOptimizer optimizer;
+    auto circuit = optimizer.Optimize(*compiled);
+
+    // The root is the signal the circuit sets this lane's Sparty from
+    int root = -1;
+    for (auto& sink : circuit->GetSinks())
+    {
+        if (sink.second == visitor.mSpartyPin)
+        {
+            root = sink.first;
+        }
+    }
+    if (root < 0)
+    {
+        return nullptr;
+    }
+
+    auto predictor = std::make_unique<KickPredictor>(std::move(circuit), root);
+    for (auto& source : predictor->mCircuit->GetSources())
+    {
+        if (source.second == visitor.mBeamPin)
+        {
+            predictor->SetBeamSignal(source.first);
+        }
+
+        auto sensor = visitor.mSensorPins.find(source.second);
+        if (sensor != visitor.mSensorPins.end())
+        {
+            predictor->AddPropertySignal(source.first, sensor->second);
+        }
+    }
+
+    return predictor;
+}
+
+/**
+ * Predict the score a game's circuit would earn for the products on one lane
+ * @param game Game to predict
+ * @param correct If not null, set to the number of products handled correctly
+ * @param lane Lane to predict
+ * @return Predicted score for the lane
+ */
+int KickPredictor::PredictScore(Game* game, int* correct, int lane)
+{
+    TraceScope trace("KickPredictor::PredictScore", "circuit");
+
+    PredictorVisitor visitor(lane);
+    game->Accept(&visitor);
+
+    // Products further down the belt reach the sensor first
+    std::stable_sort(visitor.mProducts.begin(), visitor.mProducts.end(),
+                     [](Product* a, Product* b) { return a->GetY() > b->GetY(); });
+
+    std::vector<unsigned int> properties;
+    for (auto product : visitor.mProducts)
+    {
+        properties.push_back((1u << static_cast<int>(product->GetColor())) |
+                             (1u << static_cast<int>(product->GetShape())) |
+                             (1u << static_cast<int>(product->GetContent())));
+    }
+
+    // Without a circuit Sparty never kicks
+    std::vector<bool> kicked(properties.size(), false);
+    auto predictor = Create(game, lane);
+    if (predictor != nullptr)
+    {
+        kicked = predictor->Predict(properties);
+    }
+
+    int good = visitor.mScoreboard != nullptr ? visitor.mScoreboard->GetGood() : 10;
+    int bad = visitor.mScoreboard != nullptr ? visitor.mScoreboard->GetBad() : 0;
+
+    int score = 0;
+    int right = 0;
+    for (size_t p = 0; p < visitor.mProducts.size(); p++)
+    {
+        bool isRight = kicked[p] == visitor.mProducts[p]->ShouldKick();
+        score += isRight ? good : bad;
+        right += isRight ? 1 : 0;
+    }
+
+    if (correct != nullptr)
+    {
+        *correct = right;
+    }
+    return score;
+}
+
+/**
+ * Predict which products Sparty kicks
+ * @param products Properties of each product in belt order, bit p set for each Product::Properties p it has
+ * @return Whether each product is kicked
+ */
+const std::vector<bool>& KickPredictor::Predict(const std::vector<unsigned int>& products)
+{
+    mKicked.assign(products.size(), false);
+    if (mStateful)
+    {
+        PredictSequential(products);
+    }
+    else
+    {
+        PredictParallel(products);
+    }
+    return mKicked;
+}
+
+/**
+ * Set the beam and sensor signals for one phase of a product
+ * @param circuit Circuit to set the signals of
+ * @param properties Properties in front of the sensor, 0 for none
+ * @param beam Is the product in front of the beam?
+ */
+void KickPredictor::SetInputs(CompiledCircuit* circuit, unsigned int properties, bool beam) const
+{
+    if (mBeam >= 0)
+    {
+        circuit->SetSignal(mBeam, beam ? SignalOne : SignalZero);
+    }
+
+    for (auto& property : mProperties)
+    {
+        circuit->SetSignal(property.first, (properties >> property.second) & 1 ? SignalOne : SignalZero);
+    }
+}
+
+/**
+ * Run the products one at a time so flip flops carry state between them
+ * @param products Properties of each product
+ */
+void KickPredictor::PredictSequential(const std::vector<unsigned int>& products)
+{
+    // Work on a copy so predicting never disturbs the circuit's own state
+    CompiledCircuit circuit = *mCircuit;
+
+    SetInputs(&circuit, 0, false);
+    circuit.Evaluate();
+    bool previous = circuit.GetSignal(mRoot) == SignalOne;
+
+    for (size_t p = 0; p < products.size(); p++)
+    {
+        for (int phase = 0; phase < 3; phase++)
+        {
+            // Sensor, then sensor and beam, then the gap
+            SetInputs(&circuit, phase < 2 ? products[p] : 0, phase == 1);
+            circuit.Evaluate();
+
+            bool current = circuit.GetSignal(mRoot) == SignalOne;
+            if (phase < 2 && current && !previous)
+            {
+                mKicked[p] = true;
+            }
+            previous = current;
+        }
+    }
+}
+
+/**
+ * Run 64 products at a time, one per bit, through a circuit without state
+ * @param products Properties of each product
+ */
+void KickPredictor::PredictParallel(const std::vector<unsigned int>& products)
+{
+    auto& nodes = mCircuit->GetNodes();
+    auto& nodeInputs = mCircuit->GetInputs();
+    auto& order = mCircuit->GetOrder();
+
+    // Signals nothing sets keep their value in every lane
+    std::vector<LaneSignal> initial(mCircuit->GetSignalCount());
+    for (int s = 0; s < mCircuit->GetSignalCount(); s++)
+    {
+        initial[s].mOnes = mCircuit->GetSignal(s) == SignalOne ? ~uint64_t(0) : 0;
+        initial[s].mUnknown = mCircuit->GetSignal(s) == SignalUnknown ? ~uint64_t(0) : 0;
+    }
+
+    std::vector<LaneSignal> signals;
+    auto evaluate = [&](size_t first, bool beam, bool sensor) {
+        signals = initial;
+        if (mBeam >= 0)
+        {
+            signals[mBeam] = {beam ? ~uint64_t(0) : 0, 0};
+        }
+        for (auto& property : mProperties)
+        {
+            uint64_t ones = 0;
+            for (size_t lane = 0; sensor && lane < PredictorLanes && first + lane < products.size(); lane++)
+            {
+                ones |= uint64_t((products[first + lane] >> property.second) & 1) << lane;
+            }
+            signals[property.first] = {ones, 0};
+        }
+
+        for (auto n : order)
+        {
+            auto& node = nodes[n];
+            auto inputs = nodeInputs.data() + node.mFirstInput;
+
+            uint64_t unknown = 0;
+            for (int i = 0; i < node.mInputCount; i++)
+            {
+                unknown |= signals[inputs[i]].mUnknown;
+            }
+
+            uint64_t ones = 0;
+            switch (node.mType)
+            {
+            case NodeTypes::And:
+                ones = ~uint64_t(0);
+                for (int i = 0; i < node.mInputCount; i++)
+                {
+                    ones &= signals[inputs[i]].mOnes;
+                }
+                break;
+
+            case NodeTypes::Or:
+                for (int i = 0; i < node.mInputCount; i++)
+                {
+                    ones |= signals[inputs[i]].mOnes;
+                }
+                break;
+
+            case NodeTypes::Xor:
+                for (int i = 0; i < node.mInputCount; i++)
+                {
+                    ones ^= signals[inputs[i]].mOnes;
+                }
+                break;
+
+            case NodeTypes::Not:
+                ones = ~signals[inputs[0]].mOnes;
+                break;
+
+            case NodeTypes::Lut:
+                // Sum of the table's minterms
+                for (int entry = 0; entry < (1 << node.mInputCount); entry++)
+                {
+                    if ((node.mTable >> entry) & 1)
+                    {
+                        uint64_t match = ~uint64_t(0);
+                        for (int i = 0; i < node.mInputCount; i++)
+                        {
+                            auto bit = signals[inputs[i]].mOnes;
+                            match &= (entry >> i) & 1 ? bit : ~bit;
+                        }
+                        ones |= match;
+                    }
+                }
+                break;
+
+            default:
+                break;
+            }
+
+            signals[node.mOutputs[0]] = {ones & ~unknown, unknown};
+        }
+
+        return signals[mRoot].mOnes;
+    };
+
+    // The gap between products is the same for every lane
+    auto gap = evaluate(0, false, false);
+    for (size_t first = 0; first < products.size(); first += PredictorLanes)
+    {
+        auto sensor = evaluate(first, false, true);
+        auto beam = evaluate(first, true, true);
+        auto rising = (sensor & ~gap) | (beam & ~sensor);
+
+        for (size_t lane = 0; lane < PredictorLanes && first + lane < products.size(); lane++)
+        {
+            mKicked[first + lane] = ((rising >> lane) & 1) != 0;
+        }
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * @file KickPredictor.h
+ * @author Attulya Pratap Gupta
+ *
+ * Predicts which products Sparty will kick without running the conveyor
+ */
+
+#ifndef KICKPREDICTOR_H
+#define KICKPREDICTOR_H
+
+#include <vector>
+#include <memory>
+
+#include "CompiledCircuit.h"
+
+class Game;
+
+/**
+ * Predicts which products Sparty will kick, and the score, straight from
+ * the compiled circuit.
+ *
+ * Each product is run through the phases it goes through on the belt:
+ * in front of the sensor, in front of the sensor and the beam together,
+ * then the gap before the next product. Sparty kicks a product when his
+ * input rises during its first two phases.
+ *
+ * Circuits without flip flops give the same answer for a product
+ * whatever came before it, so 64 products are evaluated at once with
+ * one bit of a word per product. Circuits with flip flops are run one
+ * product after another so the state they hold carries between products.
+ */
+class KickPredictor
+{
+private:
+    /// The circuit, optimized down to Sparty's input
+    std::unique_ptr<CompiledCircuit> mCircuit;
+
+    /// Signal read by Sparty
+    int mRoot = -1;
+
+    /// Signal set by the beam, -1 if the circuit does not read it
+    int mBeam = -1;
+
+    /// Signals set by sensor outputs, with the property each one shows
+    std::vector<std::pair<int, int>> mProperties;
+
+    /// Did Sparty kick each product?
+    std::vector<bool> mKicked;
+
+    /// Does the circuit hold state between products?
+    bool mStateful = false;
+
+    void PredictParallel(const std::vector<unsigned int>& products);
+    void PredictSequential(const std::vector<unsigned int>& products);
+    void SetInputs(CompiledCircuit* circuit, unsigned int properties, bool beam) const;
+
+public:
+    KickPredictor(std::unique_ptr<CompiledCircuit> circuit, int root);
+
+    /**
+     * Set which signal is set by the beam
+     * @param signal Signal index
+     */
+    void SetBeamSignal(int signal) { mBeam = signal; }
+
+    /**
+     * Set a signal that is set by a sensor output
+     * @param signal Signal index
+     * @param property Product::Properties value the output shows, as an int
+     */
+    void AddPropertySignal(int signal, int property) { mProperties.emplace_back(signal, property); }
+
+    const std::vector<bool>& Predict(const std::vector<unsigned int>& products);
+
+    /**
+     * Does the circuit hold state between products?
+     * @return True if products are evaluated one at a time
+     */
+    bool IsStateful() const { return mStateful; }
+
+    /**
+     * Get whether Sparty kicks each product of the last prediction
+     * @return One entry for each product, in belt order
+     */
+    const std::vector<bool>& GetKicked() const { return mKicked; }
+
+    static std::unique_ptr<KickPredictor> Create(Game* game, int lane = 0);
+    static int PredictScore(Game* game, int* correct = nullptr, int lane = 0);
+};
+
+#endif //KICKPREDICTOR_H
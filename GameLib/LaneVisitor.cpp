@@ -0,0 +1,40 @@
+/**
+ * @file LaneVisitor.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "LaneVisitor.h"
+
+/**
+ * Get the detector for a lane, creating it the first time the lane is seen
+ * @param lane Lane number
+ * @return The lane's detector
+ */
+ProductDetector* LaneVisitor::GetDetector(int lane)
+{
+    auto& detector = mDetectors[lane];
+    if (detector == nullptr)
+    {
+        detector = std::make_unique<ProductDetector>(lane);
+    }
+    return detector.get();
+}
+
+/**
+ * Get the detector of every lane seen, each given the scoreboard
+ * @return Detectors in lane order, owned by this visitor
+ */
+std::vector<ProductDetector*> LaneVisitor::GetDetectors()
+{
+    std::vector<ProductDetector*> detectors;
+    for (auto& detector : mDetectors)
+    {
+        if (mScoreboard != nullptr)
+        {
+            detector.second->VisitScoreboard(mScoreboard);
+        }
+        detectors.push_back(detector.second.get());
+    }
+    return detectors;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file LaneVisitor.h
+ * @author Attulya Pratap Gupta
+ *
+ * Visitor that sorts the items of a game into a product detector per lane
+ */
+
+#ifndef LANEVISITOR_H
+#define LANEVISITOR_H
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "ProductDetector.h"
+#include "Product.h"
+
+/**
+ * Visitor that sorts the items of a game into a product detector per lane.
+ *
+ * One pass over the items fills the detector of every lane, so the
+ * detectors can then run without visiting the game again.
+ */
+class LaneVisitor : public VisitorBase
+{
+private:
+    /// Detector for each lane, by lane number
+    std::map<int, std::unique_ptr<ProductDetector>> mDetectors;
+
+    /// The scoreboard, shared by every lane
+    Scoreboard* mScoreboard = nullptr;
+
+    ProductDetector* GetDetector(int lane);
+
+public:
+    /**
+     * Visit a product
+     * @param product The product
+     */
+    void VisitProduct(Product* product) override { GetDetector(product->GetLane())->VisitProduct(product); }
+
+    /**
+     * Visit a beam
+     * @param beam The beam
+     */
+    void VisitBeam(Beam* beam) override { GetDetector(beam->GetLane())->VisitBeam(beam); }
+
+    /**
+     * Visit a sensor
+     * @param sensor The sensor
+     */
+    void VisitSensor(Sensor* sensor) override { GetDetector(sensor->GetLane())->VisitSensor(sensor); }
+
+    /**
+     * Visit a sensor output
+     * @param output The sensor output
+     */
+    void VisitSensorOutput(SensorOutput* output) override { GetDetector(output->GetLane())->VisitSensorOutput(output); }
+
+    /**
+     * Visit the scoreboard
+     * @param scoreboard The scoreboard
+     */
+    void VisitScoreboard(Scoreboard* scoreboard) override { mScoreboard = scoreboard; }
+
+    std::vector<ProductDetector*> GetDetectors();
+};
+
+#endif //LANEVISITOR_H
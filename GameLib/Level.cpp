@@ -7,7 +7,16 @@
 #include "Product.h"
 #include "Game.h"
 #include "ItemFactory.h"
+#include "TraceRecorder.h"
+#include "Gate.h"
+#include "BeamVisitor.h"
+#include "SensorOutputVisitor.h"
+#include "SpartyVisitor.h"
+#include "Conveyor.h"
+#include "ProductDetector.h"
 #include <wx/tokenzr.h>
+#include <map>
+#include <limits>
 
 /**
  * Level Constructor
@@ -22,6 +31,8 @@ Level::Level(Game* game) : mGame(game) {}
  */
 bool Level::Load(wxXmlNode* node)
 {
+    TraceScope trace("Level::Load", "load");
+
     // Load level size
     wxString size;
     if (node->GetAttribute(L"size", &size))
@@ -31,6 +42,14 @@ bool Level::Load(wxXmlNode* node)
         tokenizer.GetNextToken().ToLong(&mHeight);
     }
 
+    // A saved circuit is wired up once every item it connects to exists
+    wxXmlNode* circuitNode = nullptr;
+
+    // Counted by LoadProducts as the conveyor's products are loaded
+    mProductCount = 0;
+    mProductStreams.clear();
+    mGame->ClearParkedItems();
+
     // Load items
     auto itemsNode = node->GetChildren();
     while (itemsNode)
@@ -52,20 +71,32 @@ bool Level::Load(wxXmlNode* node)
                 itemNode = itemNode->GetNext();
             }
         }
+        else if (itemsNode->GetName() == L"circuit")
+        {
+            circuitNode = itemsNode;
+        }
         itemsNode = itemsNode->GetNext();
     }
 	mGame->ProductClear();
+
+	if (circuitNode != nullptr)
+	{
+		LoadCircuit(circuitNode);
+	}
 	// Reset member variables for each load
 	mLevelTime = 0;
 	mCompletionBonus = MaxCompletionBonus;
 	mBonusDecrement = BonusDecrementStart;
 	mLastBonusDecrement = 0;
+	mProductsRemaining = mProductCount;
     return true;
 }
 
 
 void Level::LoadItem(wxXmlNode* node)
 {
+    TraceScope trace("Level::LoadItem", "load");
+
     auto item = ItemFactory::CreateItem(node->GetName().ToStdWstring(), mGame);
     if (item != nullptr)
     {
@@ -76,11 +107,34 @@ void Level::LoadItem(wxXmlNode* node)
 
 void Level::LoadProducts(wxXmlNode* conveyorNode)
 {
+    TraceScope trace("Level::LoadProducts", "load");
+
     double conveyorX, conveyorY, conveyorHeight;
     conveyorNode->GetAttribute("x", "0").ToDouble(&conveyorX);
     conveyorNode->GetAttribute("y", "0").ToDouble(&conveyorY);
     conveyorNode->GetAttribute("height", "0").ToDouble(&conveyorHeight);
 
+    long lane;
+    conveyorNode->GetAttribute(L"lane", L"0").ToLong(&lane);
+
+    // A streaming conveyor gets a fixed pool of products instead of its whole list
+    auto source = ProductSource::Create(conveyorNode);
+    if (source != nullptr)
+    {
+        long pool;
+        conveyorNode->GetAttribute(L"pool", L"0").ToLong(&pool);
+
+        auto stream = std::make_unique<ProductStream>(std::move(source), int(lane));
+        stream->CreatePool(this, int(pool), conveyorHeight);
+
+        // A stream that never ends never reaches its last product. The count stops at the largest int
+        auto count = stream->GetCount();
+        const int most = std::numeric_limits<int>::max();
+        mProductCount = count < 0 || mProductCount > most - count ? most : mProductCount + count;
+        mProductStreams.push_back(std::move(stream));
+        return;
+    }
+
     double currentPlacement = 0;
     for (auto productNode = conveyorNode->GetChildren(); productNode; productNode = productNode->GetNext())
     {
@@ -108,7 +162,169 @@ void Level::LoadProducts(wxXmlNode* conveyorNode)
 
             product->SetLocation(productX, productY);
             product->SetInitialPosition(productX, productY, conveyorHeight);
+            product->SetLane(int(lane));
             mGame->AddProduct(product);
+            if (mProductCount < std::numeric_limits<int>::max())
+            {
+                ++mProductCount;
+            }
+        }
+    }
+}
+
+/**
+ * Move the products of the streams feeding a conveyor
+ * @param conveyor The conveyor that moved
+ * @param distance Distance the belt moved in virtual pixels
+ */
+void Level::UpdateProductStreams(Conveyor* conveyor, double distance)
+{
+    for (auto& stream : mProductStreams)
+    {
+        if (stream->GetLane() == conveyor->GetLane())
+        {
+            stream->Update(conveyor, distance);
+        }
+    }
+}
+
+/**
+ * Start every product stream again from its first product
+ */
+void Level::ResetProductStreams()
+{
+    for (auto& stream : mProductStreams)
+    {
+        stream->Reset();
+    }
+}
+
+/**
+ * Find the output pin a circuit wire comes from.
+ *
+ * Sources are written as "beam" or "beam:L" for the beam across lane L,
+ * "sensor:N" for the Nth sensor output in the level, or "gate:N" and
+ * "gate:N:1" for the first and second output of the gate with id N.
+ *
+ * @param from The source attribute of the wire
+ * @param beams Visitor holding the output pins of the beams
+ * @param sensorPins Output pins of the sensor outputs
+ * @param gates Gates loaded so far, by id
+ * @return The output pin, nullptr if the source does not exist
+ */
+static std::shared_ptr<Pin> FindCircuitSource(const wxString& from, BeamVisitor& beams,
+                                              const std::vector<std::shared_ptr<Pin>>& sensorPins,
+                                              const std::map<long, std::shared_ptr<Gate>>& gates)
+{
+    wxStringTokenizer tokenizer(from, L":");
+    auto kind = tokenizer.GetNextToken();
+    long index = 0;
+    long output = 0;
+    tokenizer.GetNextToken().ToLong(&index);
+    tokenizer.GetNextToken().ToLong(&output);
+
+    if (kind == L"beam")
+    {
+        return beams.GetOutputPin(int(index));
+    }
+    else if (kind == L"sensor" && index >= 0 && index < long(sensorPins.size()))
+    {
+        return sensorPins[index];
+    }
+    else if (kind == L"gate" && gates.find(index) != gates.end())
+    {
+        auto pins = gates.at(index)->GetOutputPins();
+        return output == 1 ? pins.second : pins.first;
+    }
+
+    return nullptr;
+}
+
+/**
+ * Load a saved circuit of gates and wires from the XML file
+ * @param circuitNode The circuit XML node
+ */
+void Level::LoadCircuit(wxXmlNode* circuitNode)
+{
+    TraceScope trace("Level::LoadCircuit", "load");
+
+    BeamVisitor beamVisitor;
+    mGame->Accept(&beamVisitor);
+    SensorOutputVisitor sensorVisitor;
+    mGame->Accept(&sensorVisitor);
+    SpartyVisitor spartyVisitor;
+    mGame->Accept(&spartyVisitor);
+
+    auto sensorPins = sensorVisitor.GetOutput();
+
+    // Create all of the gates first so wires can refer to any of them
+    std::map<long, std::shared_ptr<Gate>> gates;
+    for (auto gateNode = circuitNode->GetChildren(); gateNode; gateNode = gateNode->GetNext())
+    {
+        if (gateNode->GetName() == L"gate")
+        {
+            auto gate = ItemFactory::CreateGate(gateNode->GetAttribute(L"type").ToStdWstring(), mGame);
+            if (gate == nullptr)
+            {
+                continue;
+            }
+
+            long id;
+            double x, y;
+            gateNode->GetAttribute(L"id", L"0").ToLong(&id);
+            gateNode->GetAttribute(L"x", L"0").ToDouble(&x);
+            gateNode->GetAttribute(L"y", L"0").ToDouble(&y);
+
+            // Lets gates such as lookup tables read their own attributes
+            gate->XmlLoad(gateNode);
+            gate->SetLocation(x, y);
+            gate->UpdatePinPositions();
+            mGame->AddItem(gate);
+            gates[id] = gate;
+        }
+    }
+
+    // Connect the wires the same way dragging them does
+    for (auto gateNode = circuitNode->GetChildren(); gateNode; gateNode = gateNode->GetNext())
+    {
+        std::vector<std::shared_ptr<Pin>> inputs;
+        if (gateNode->GetName() == L"gate")
+        {
+            long id;
+            gateNode->GetAttribute(L"id", L"0").ToLong(&id);
+            if (gates.find(id) == gates.end())
+            {
+                continue;
+            }
+            inputs = gates[id]->GetInputPins();
+        }
+        else if (gateNode->GetName() == L"sparty")
+        {
+            // Each lane's Sparty has its own wires
+            long lane;
+            gateNode->GetAttribute(L"lane", L"0").ToLong(&lane);
+            auto sparty = spartyVisitor.GetSparty(int(lane));
+            if (sparty != nullptr)
+            {
+                inputs = {sparty->GetInputPin()};
+            }
+        }
+
+        for (auto wireNode = gateNode->GetChildren(); wireNode; wireNode = wireNode->GetNext())
+        {
+            if (wireNode->GetName() != L"wire")
+            {
+                continue;
+            }
+
+            long input;
+            wireNode->GetAttribute(L"input", L"0").ToLong(&input);
+            auto source = FindCircuitSource(wireNode->GetAttribute(L"from"), beamVisitor, sensorPins, gates);
+            if (source != nullptr && input >= 0 && input < long(inputs.size()))
+            {
+                auto target = inputs[input];
+                source->Connect(target.get(), wxPoint(int(target->GetX()), int(target->GetY())));
+            }
         }
     }
 }
@@ -240,6 +456,15 @@ void Level::DrawLevel(std::shared_ptr<wxGraphicsContext> gc, bool levelEnd)
 void Level::Update(double elapsed)
 {
 	mLevelTime += elapsed;
+
+	// Every lane's beam and sensor sees the products where the conveyors left them
+	ProductDetector::UpdateLanes(mGame);
+
+	// Items are parked during the item updates but only moved once they are done
+	mGame->ApplyParking();
+
+	// Gates moved during the update put their pins in place once, not on every move
+	mGame->UpdateGeometry();
 }
 
 /**
@@ -255,4 +480,32 @@ void Level::UpdateCompletionBonus()
 		mLastBonusDecrement = mDisplayTime;
 		mBonusDecrement *= 2;
 	}
-}
\ No newline at end of file
+}
+
+/**
+ * Save the level timer and completion bonus
+ * @param state Buffer to save into
+ */
+void Level::SaveState(GameState* state) const
+{
+	state->Put(mLevelTime);
+	state->Put(mDisplayTime);
+	state->Put(mCompletionBonus);
+	state->Put(mLastBonusDecrement);
+	state->Put(mBonusDecrement);
+	state->Put(mProductsRemaining);
+}
+
+/**
+ * Restore the level timer and completion bonus
+ * @param state Buffer to restore from
+ */
+void Level::RestoreState(GameState* state)
+{
+	state->Get(mLevelTime);
+	state->Get(mDisplayTime);
+	state->Get(mCompletionBonus);
+	state->Get(mLastBonusDecrement);
+	state->Get(mBonusDecrement);
+	state->Get(mProductsRemaining);
+}
@@ -11,9 +11,12 @@
 #include <memory>
 
 #include "Item.h"
+#include "GameState.h"
+#include "ProductStream.h"
 
 class Item;
 class Game;
+class Conveyor;
 
 /// Size of notices displayed on screen in virtual pixels
 const int NoticeSize = 100;
@@ -82,6 +85,15 @@ private:
 	/// The decrement amount
 	int mBonusDecrement = 5;
 
+	/// Number of products loaded onto the conveyor
+	int mProductCount = 0;
+
+	/// Number of products that have not passed the beam yet
+	int mProductsRemaining = 0;
+
+	/// Streams feeding conveyors that do not list their products
+	std::vector<std::unique_ptr<ProductStream>> mProductStreams;
+
 
 
 
@@ -120,10 +132,13 @@ private:
       *
       */
      void LoadProducts(wxXmlNode* conveyornode);
+     void LoadCircuit(wxXmlNode* circuitNode);
 
      void DrawLevel(std::shared_ptr<wxGraphicsContext> gc, bool levelEnd);
 	 void Update(double elapsed);
 	 void UpdateCompletionBonus();
+	 void SaveState(GameState* state) const;
+	 void RestoreState(GameState* state);
 
 	 /**
 	  * Getter for the level number
@@ -149,6 +164,31 @@ private:
 	 */
 	int GetCompletionBonus() const { return mCompletionBonus; }
 
+	/**
+	 * Record that a product has just passed the beam
+	 */
+	void ProductPassedBeam() { if (mProductsRemaining > 0) --mProductsRemaining; }
+
+	/**
+	 * Start counting again from every product, such as when the products are reset
+	 */
+	void ResetProductsRemaining() { mProductsRemaining = mProductCount; }
+
+	/**
+	 * Get the number of products that have not passed the beam yet
+	 * @return Number of products
+	 */
+	int GetProductsRemaining() const { return mProductsRemaining; }
+
+	/**
+	 * Have all of the products passed the beam?
+	 * @return True once the last product has passed the beam
+	 */
+	bool IsLastProductReached() const { return mProductsRemaining == 0; }
+
+	void UpdateProductStreams(Conveyor* conveyor, double distance);
+	void ResetProductStreams();
+
 };
 
 #endif // LEVEL_H
\ No newline at end of file
@@ -0,0 +1,341 @@
+/**
+ * @file LevelGenerator.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "LevelGenerator.h"
+#include "Product.h"
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+/// X location of the conveyor, matching the shipped levels
+const int GeneratedConveyorX = 205;
+
+/// Y location of the top sensor, matching the shipped levels
+const int GeneratedSensorY = 430;
+
+/// Vertical distance between generated sensors in virtual pixels
+const int GeneratedSensorSpacing = 120;
+
+/// Minimum distance between generated products in virtual pixels
+const int GeneratedMinSpacing = 100;
+
+/// Maximum distance between generated products in virtual pixels
+const int GeneratedMaxSpacing = 200;
+
+/// Area to the right of the conveyor the circuit is laid out in
+/// @return rectangle the gates are placed in
+const wxRect GeneratedCircuitArea(450, 180, 600, 580);
+
+/// Chance a gate input comes from any earlier signal instead of the previous layer
+const double GeneratedSkipChance = 0.25;
+
+/// Gate types used in the generated circuits
+const std::wstring GeneratedGateTypes[] = {L"and", L"or", L"not"};
+
+/**
+ * Constructor
+ * @param seed Seed for the random number generator
+ */
+LevelGenerator::LevelGenerator(unsigned int seed) : mRandom(seed)
+{
+    // std::map keeps the names in a fixed order, so the seed alone decides the level
+    for (auto& name : Product::NamesToProperties)
+    {
+        auto type = Product::PropertiesToTypes.find(name.second);
+        if (name.second == Product::Properties::None || type == Product::PropertiesToTypes.end())
+        {
+            continue;
+        }
+
+        switch (type->second)
+        {
+            case Product::Types::Color:
+                mColors.push_back(name.first);
+                break;
+
+            case Product::Types::Shape:
+                mShapes.push_back(name.first);
+                break;
+
+            case Product::Types::Content:
+                mContents.push_back(name.first);
+                break;
+        }
+    }
+}
+
+/**
+ * Choose one of a list of names at random
+ * @param names Names to choose from
+ * @return The chosen name
+ */
+const std::wstring& LevelGenerator::Choose(const std::vector<std::wstring>& names)
+{
+    return names[RandomIndex(names.size())];
+}
+
+/**
+ * Choose an index at random with every index equally likely
+ * @param count Number of indices to choose from, at least one
+ * @return Index from 0 to count - 1
+ */
+size_t LevelGenerator::RandomIndex(size_t count)
+{
+    // Reject the values at the bottom of the range that would favor the
+    // low indices, so what is left is a whole number of copies of count
+    auto span = std::uint32_t(count);
+    auto threshold = std::uint32_t(0u - span) % span;
+    for (;;)
+    {
+        auto value = std::uint32_t(mRandom());
+        if (value >= threshold)
+        {
+            return value % span;
+        }
+    }
+}
+
+/**
+ * Choose a number at random with every number equally likely
+ * @param low Smallest number
+ * @param high Largest number
+ * @return Number from low to high inclusive
+ */
+int LevelGenerator::RandomRange(int low, int high)
+{
+    return low + int(RandomIndex(size_t(high - low) + 1));
+}
+
+/**
+ * Decide something at random
+ * @param chance Chance of returning true, from 0 to 1
+ * @return True with the given chance
+ */
+bool LevelGenerator::RandomChance(double chance)
+{
+    // Every 32 bit value is exact as a double, so this is the same everywhere
+    return double(std::uint32_t(mRandom())) / 4294967296.0 < chance;
+}
+
+/**
+ * Put names in a random order with a Fisher-Yates shuffle
+ * @param names Names to shuffle
+ */
+void LevelGenerator::Shuffle(std::vector<std::wstring>& names)
+{
+    for (size_t i = names.size(); i > 1; i--)
+    {
+        std::swap(names[i - 1], names[RandomIndex(i)]);
+    }
+}
+
+/**
+ * Generate a level
+ * @return Root node of the level, owned by the caller
+ */
+wxXmlNode* LevelGenerator::Generate()
+{
+    auto root = new wxXmlNode(wxXML_ELEMENT_NODE, L"level");
+    root->AddAttribute(L"size", L"1150,800");
+
+    auto items = new wxXmlNode(wxXML_ELEMENT_NODE, L"items");
+    root->AddChild(items);
+
+    int outputCount = CreateSensors(items);
+    items->AddChild(CreateConveyor());
+
+    auto beam = new wxXmlNode(wxXML_ELEMENT_NODE, L"beam");
+    beam->AddAttribute(L"x", wxString::Format(L"%d", GeneratedConveyorX + 92));
+    beam->AddAttribute(L"y", L"437");
+    beam->AddAttribute(L"sender", L"-185");
+    items->AddChild(beam);
+
+    auto sparty = new wxXmlNode(wxXML_ELEMENT_NODE, L"sparty");
+    sparty->AddAttribute(L"x", wxString::Format(L"%d", GeneratedConveyorX + 140));
+    sparty->AddAttribute(L"y", L"340");
+    sparty->AddAttribute(L"height", L"300");
+    sparty->AddAttribute(L"pin", L"1100, 400");
+    sparty->AddAttribute(L"kick-duration", L"0.25");
+    sparty->AddAttribute(L"kick-speed", L"1000");
+    items->AddChild(sparty);
+
+    auto scoreboard = new wxXmlNode(wxXML_ELEMENT_NODE, L"scoreboard");
+    scoreboard->AddAttribute(L"x", L"700");
+    scoreboard->AddAttribute(L"y", L"40");
+    scoreboard->AddAttribute(L"good", L"10");
+    scoreboard->AddAttribute(L"bad", L"-5");
+    scoreboard->AddChild(new wxXmlNode(wxXML_TEXT_NODE, L"", wxString::Format(
+        L"Generated level: %d products, %d sensors, %d gates", mProductCount, mSensorCount, mGateCount)));
+    items->AddChild(scoreboard);
+
+    if (mGateCount > 0)
+    {
+        // The beam is the last source, after every sensor output
+        root->AddChild(CreateCircuit(outputCount + 1));
+    }
+
+    return root;
+}
+
+/**
+ * Create the sensors, each with a random selection of outputs
+ * @param items The items node to add the sensors to
+ * @return The total number of sensor outputs
+ */
+int LevelGenerator::CreateSensors(wxXmlNode* items)
+{
+    std::vector<std::wstring> names = mColors;
+    names.insert(names.end(), mShapes.begin(), mShapes.end());
+    names.insert(names.end(), mContents.begin(), mContents.end());
+
+    int outputCount = 0;
+    for (int i = 0; i < mSensorCount; i++)
+    {
+        auto sensor = new wxXmlNode(wxXML_ELEMENT_NODE, L"sensor");
+        sensor->AddAttribute(L"x", wxString::Format(L"%d", GeneratedConveyorX - 50));
+        sensor->AddAttribute(L"y", wxString::Format(L"%d", GeneratedSensorY - i * GeneratedSensorSpacing));
+
+        Shuffle(names);
+        auto outputs = size_t(RandomRange(3, int(std::min<size_t>(6, names.size()))));
+        for (size_t j = 0; j < outputs; j++)
+        {
+            sensor->AddChild(new wxXmlNode(wxXML_ELEMENT_NODE, names[j]));
+            ++outputCount;
+        }
+
+        items->AddChild(sensor);
+    }
+
+    return outputCount;
+}
+
+/**
+ * Create the conveyor with randomly chosen products
+ * @return The conveyor node
+ */
+wxXmlNode* LevelGenerator::CreateConveyor()
+{
+    auto conveyor = new wxXmlNode(wxXML_ELEMENT_NODE, L"conveyor");
+    conveyor->AddAttribute(L"x", wxString::Format(L"%d", GeneratedConveyorX));
+    conveyor->AddAttribute(L"y", L"400");
+    conveyor->AddAttribute(L"speed", L"100");
+    conveyor->AddAttribute(L"height", L"800");
+    conveyor->AddAttribute(L"panel", L"60,-390");
+
+    for (int i = 0; i < mProductCount; i++)
+    {
+        conveyor->AddChild(CreateProduct(i == 0));
+    }
+
+    return conveyor;
+}
+
+/**
+ * Create one randomly chosen product
+ * @param first True for the first product on the conveyor, which is placed absolutely
+ * @return The product node, owned by the caller
+ */
+wxXmlNode* LevelGenerator::CreateProduct(bool first)
+{
+    auto product = new wxXmlNode(wxXML_ELEMENT_NODE, L"product");
+    product->AddAttribute(L"placement", first ? wxString(L"100") : wxString::Format(L"+%d", RandomRange(GeneratedMinSpacing, GeneratedMaxSpacing)));
+    product->AddAttribute(L"shape", Choose(mShapes));
+    product->AddAttribute(L"color", Choose(mColors));
+    if (RandomChance(0.5))
+    {
+        product->AddAttribute(L"content", Choose(mContents));
+    }
+    product->AddAttribute(L"kick", RandomChance(0.5) ? L"yes" : L"no");
+    return product;
+}
+
+/**
+ * Create a random layered circuit.
+ *
+ * Gates in each layer read signals from the layer before, with some
+ * reaching further back. The final gate ANDs the circuit with the beam
+ * and drives Sparty.
+ *
+ * @param sourceCount Number of sensor outputs plus the beam
+ * @return The circuit node
+ */
+wxXmlNode* LevelGenerator::CreateCircuit(int sourceCount)
+{
+    auto circuit = new wxXmlNode(wxXML_ELEMENT_NODE, L"circuit");
+
+    int layers = std::max(1, int(std::lround(std::sqrt(double(mGateCount)))));
+    int perLayer = (mGateCount + layers - 1) / layers;
+
+    // Signals available to each layer, starting with the sources
+    std::vector<wxString> signals;
+    for (int i = 0; i < sourceCount - 1; i++)
+    {
+        signals.push_back(wxString::Format(L"sensor:%d", i));
+    }
+    signals.push_back(L"beam");
+
+    size_t layerStart = 0;
+
+    int id = 0;
+    for (int layer = 0; layer < layers && id < mGateCount; layer++)
+    {
+        size_t layerEnd = signals.size();
+        std::vector<wxString> layerOutputs;
+
+        for (int i = 0; i < perLayer && id < mGateCount; i++, id++)
+        {
+            bool last = id == mGateCount - 1;
+            auto type = last ? std::wstring(L"and") : GeneratedGateTypes[RandomIndex(3)];
+
+            auto gate = new wxXmlNode(wxXML_ELEMENT_NODE, L"gate");
+            gate->AddAttribute(L"id", wxString::Format(L"%d", id));
+            gate->AddAttribute(L"type", type);
+            gate->AddAttribute(L"x", wxString::Format(L"%d", GeneratedCircuitArea.GetLeft() +
+                GeneratedCircuitArea.GetWidth() * layer / layers));
+            gate->AddAttribute(L"y", wxString::Format(L"%d", GeneratedCircuitArea.GetTop() +
+                GeneratedCircuitArea.GetHeight() * i / perLayer));
+
+            int inputs = type == L"not" ? 1 : 2;
+            for (int input = 0; input < inputs; input++)
+            {
+                size_t low = RandomChance(GeneratedSkipChance) ? 0 : layerStart;
+                auto source = last && input == 1 ? wxString(L"beam") : signals[low + RandomIndex(layerEnd - low)];
+
+                auto wire = new wxXmlNode(wxXML_ELEMENT_NODE, L"wire");
+                wire->AddAttribute(L"input", wxString::Format(L"%d", input));
+                wire->AddAttribute(L"from", source);
+                gate->AddChild(wire);
+            }
+
+            circuit->AddChild(gate);
+            layerOutputs.push_back(wxString::Format(L"gate:%d", id));
+        }
+
+        layerStart = layerEnd;
+        signals.insert(signals.end(), layerOutputs.begin(), layerOutputs.end());
+    }
+
+    auto sparty = new wxXmlNode(wxXML_ELEMENT_NODE, L"sparty");
+    auto wire = new wxXmlNode(wxXML_ELEMENT_NODE, L"wire");
+    wire->AddAttribute(L"input", L"0");
+    wire->AddAttribute(L"from", wxString::Format(L"gate:%d", mGateCount - 1));
+    sparty->AddChild(wire);
+    circuit->AddChild(sparty);
+
+    return circuit;
+}
+
+/**
+ * Generate a level and save it to a file
+ * @param filename File to save the level to
+ * @return True if the file was written
+ */
+bool LevelGenerator::Save(const wxString& filename)
+{
+    wxXmlDocument xmlDoc;
+    xmlDoc.SetRoot(Generate());
+    return xmlDoc.Save(filename);
+}
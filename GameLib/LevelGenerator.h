@@ -0,0 +1,84 @@
+/**
+ * @file LevelGenerator.h
+ * @author Attulya Pratap Gupta
+ *
+ * Class that generates large levels for scaling work
+ */
+
+#ifndef LEVELGENERATOR_H
+#define LEVELGENERATOR_H
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Class that generates level XML with many products, several sensors
+ * and a random layered circuit of gates.
+ *
+ * The same seed and settings always produce the same level, so
+ * benchmarks run against generated levels are reproducible.
+ */
+class LevelGenerator
+{
+private:
+    /// Random number generator for everything in the level. Only its raw
+    /// output is used, which the standard fixes for a seed, unlike the
+    /// distributions and std::shuffle that differ between libraries.
+    std::mt19937 mRandom;
+
+    /// Number of products on the conveyor
+    int mProductCount = 6;
+
+    /// Number of sensors along the conveyor
+    int mSensorCount = 1;
+
+    /// Number of gates in the circuit
+    int mGateCount = 0;
+
+    /// Names of the color properties
+    std::vector<std::wstring> mColors;
+
+    /// Names of the shape properties
+    std::vector<std::wstring> mShapes;
+
+    /// Names of the content properties
+    std::vector<std::wstring> mContents;
+
+    int CreateSensors(wxXmlNode* items);
+    wxXmlNode* CreateConveyor();
+    wxXmlNode* CreateCircuit(int sourceCount);
+    const std::wstring& Choose(const std::vector<std::wstring>& names);
+    size_t RandomIndex(size_t count);
+    int RandomRange(int low, int high);
+    bool RandomChance(double chance);
+    void Shuffle(std::vector<std::wstring>& names);
+
+public:
+    LevelGenerator(unsigned int seed);
+
+    /**
+     * Set the number of products on the conveyor
+     * @param count Number of products
+     */
+    void SetProductCount(int count) { mProductCount = count; }
+
+    /**
+     * Set the number of sensors along the conveyor
+     * @param count Number of sensors, at least one
+     */
+    void SetSensorCount(int count) { mSensorCount = std::max(1, count); }
+
+    /**
+     * Set the number of gates in the generated circuit
+     * @param count Number of gates, zero for no circuit
+     */
+    void SetGateCount(int count) { mGateCount = count; }
+
+    wxXmlNode* Generate();
+    wxXmlNode* CreateProduct(bool first);
+    bool Save(const wxString& filename);
+};
+
+#endif //LEVELGENERATOR_H
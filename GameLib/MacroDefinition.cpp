@@ -0,0 +1,187 @@
+/**
+ * @file MacroDefinition.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "MacroDefinition.h"
+#include "CircuitCompiler.h"
+#include "PinVisitor.h"
+#include "Gate.h"
+#include <map>
+#include <set>
+
+/**
+ * Create a macro from a selection of gates.
+ *
+ * Every input pin that is not wired to another selected gate becomes an
+ * input of the macro. The outputs are the selected outputs that are wired
+ * to something outside the selection, or the unwired outputs if none are.
+ *
+ * @param name Name shown on the gate
+ * @param gates The selected gates
+ * @return The new definition
+ */
+std::shared_ptr<MacroDefinition> MacroDefinition::Create(const std::wstring& name,
+                                                         const std::vector<std::shared_ptr<Gate>>& gates)
+{
+    auto definition = std::make_shared<MacroDefinition>(name);
+    auto& circuit = definition->mCircuit;
+
+    std::set<Item*> selected;
+    for (auto& gate : gates)
+    {
+        selected.insert(gate.get());
+    }
+
+    // The inputs come first so they are signals 0 to mInputCount - 1
+    std::map<Pin*, int> inputSignals;
+    for (auto& gate : gates)
+    {
+        for (auto& pin : gate->GetInputPins())
+        {
+            auto source = pin->GetConnected();
+            if (source == nullptr || selected.find(source->GetOwner()) == selected.end())
+            {
+                inputSignals[pin.get()] = circuit.AddSignal();
+            }
+        }
+    }
+    definition->mInputCount = circuit.GetSignalCount();
+
+    // Give every output pin a signal before adding any gate, so wires can go either way.
+    // Each starts from its pin, so flip flops keep the state they hold
+    std::map<Pin*, int> outputSignals;
+    std::vector<std::shared_ptr<Pin>> outputPins;
+    for (auto& gate : gates)
+    {
+        auto pins = gate->GetOutputPins();
+        for (auto& pin : {pins.first, pins.second})
+        {
+            if (pin != nullptr)
+            {
+                outputSignals[pin.get()] = circuit.AddSignal(CompiledCircuit::ReadPin(pin.get()));
+                outputPins.push_back(pin);
+            }
+        }
+    }
+
+    for (auto& gate : gates)
+    {
+        std::vector<int> inputs;
+        for (auto& pin : gate->GetInputPins())
+        {
+            auto found = outputSignals.find(pin->GetConnected());
+            inputs.push_back(found != outputSignals.end() ? found->second : inputSignals[pin.get()]);
+        }
+
+        std::vector<int> outputs;
+        auto pins = gate->GetOutputPins();
+        for (auto& pin : {pins.first, pins.second})
+        {
+            if (pin != nullptr)
+            {
+                outputs.push_back(outputSignals[pin.get()]);
+            }
+        }
+
+        CircuitCompiler::AddGate(&circuit, gate.get(), inputs, outputs);
+    }
+
+    // Outputs wired out of the selection, otherwise the unwired ones
+    std::vector<int> unwired;
+    for (auto& pin : outputPins)
+    {
+        PinVisitor visitor;
+        pin->Accept(&visitor);
+
+        bool external = false;
+        for (auto connected : visitor.GetCollectedPins())
+        {
+            external = external || selected.find(connected->GetOwner()) == selected.end();
+        }
+
+        if (external && int(definition->mOutputs.size()) < MaxMacroOutputs)
+        {
+            definition->mOutputs.push_back(outputSignals[pin.get()]);
+        }
+        else if (visitor.GetCollectedPins().empty())
+        {
+            unwired.push_back(outputSignals[pin.get()]);
+        }
+    }
+
+    for (size_t i = 0; definition->mOutputs.empty() && i < unwired.size() && int(i) < MaxMacroOutputs; i++)
+    {
+        definition->mOutputs.push_back(unwired[i]);
+    }
+
+    circuit.Finalize();
+    return definition;
+}
+
+/**
+ * Copy the gates of the macro into a circuit
+ *
+ * Inputs left off the end of the list are given a new unknown signal.
+ *
+ * @param target Circuit to add the gates to
+ * @param inputs Signals of the target that drive the inputs of the macro
+ * @param outputs Signals of the target the outputs of the macro drive
+ */
+void MacroDefinition::Instantiate(CompiledCircuit* target, const std::vector<int>& inputs,
+                                  const std::vector<int>& outputs) const
+{
+    // Where each of our signals ends up in the target. Inputs not given are unknown
+    std::vector<int> signals(mCircuit.GetSignalCount(), -1);
+    for (int i = 0; i < mInputCount; i++)
+    {
+        signals[i] = i < int(inputs.size()) ? inputs[i] : target->AddSignal();
+    }
+
+    for (int o = 0; o < int(mOutputs.size()) && o < int(outputs.size()); o++)
+    {
+        auto signal = mOutputs[o];
+        if (signal < mInputCount)
+        {
+            // An input wired straight to an output needs a node to copy it
+            target->AddNode(CompiledCircuit::NodeTypes::Lut, {signals[signal]}, {outputs[o]}, 0x2);
+        }
+        else
+        {
+            signals[signal] = outputs[o];
+        }
+    }
+
+    for (int s = 0; s < int(signals.size()); s++)
+    {
+        if (signals[s] < 0)
+        {
+            signals[s] = target->AddSignal(mCircuit.GetSignal(s));
+        }
+    }
+
+    auto& nodeInputs = mCircuit.GetInputs();
+    auto& nodes = mCircuit.GetNodes();
+    for (int n = 0; n < int(nodes.size()); n++)
+    {
+        auto& node = nodes[n];
+        std::vector<int> mappedInputs;
+        for (int i = 0; i < node.mInputCount; i++)
+        {
+            mappedInputs.push_back(signals[nodeInputs[node.mFirstInput + i]]);
+        }
+
+        std::vector<int> mappedOutputs;
+        for (auto output : node.mOutputs)
+        {
+            if (output >= 0)
+            {
+                mappedOutputs.push_back(signals[output]);
+            }
+        }
+
+        int added = target->AddNode(node.mType, mappedInputs, mappedOutputs, node.mTable);
+        target->SetClock(added, mCircuit.GetClock(n));
+    }
+}
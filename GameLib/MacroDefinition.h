@@ -0,0 +1,82 @@
+/**
+ * @file MacroDefinition.h
+ * @author Attulya Pratap Gupta
+ *
+ * A saved sub-circuit that can be placed as a single gate
+ */
+
+#ifndef MACRODEFINITION_H
+#define MACRODEFINITION_H
+
+#include <string>
+#include <memory>
+#include <vector>
+
+#include "CompiledCircuit.h"
+
+class Gate;
+
+/// Most outputs a macro can have, the same as any other gate
+const int MaxMacroOutputs = 2;
+
+/**
+ * A saved sub-circuit that can be placed as a single gate.
+ *
+ * The definition keeps the gates as a small netlist whose first signals
+ * are the inputs of the macro. Placing a macro in a compiled circuit
+ * copies those nodes in, so a macro costs the same as the gates it was
+ * made from and nested macros are flattened all the way down.
+ */
+class MacroDefinition
+{
+private:
+    /// Name shown on the gate
+    std::wstring mName;
+
+    /// The gates of the macro, signals 0 to mInputCount - 1 are its inputs
+    CompiledCircuit mCircuit;
+
+    /// Number of inputs
+    int mInputCount = 0;
+
+    /// Signals that are the outputs of the macro
+    std::vector<int> mOutputs;
+
+public:
+    /**
+     * Constructor
+     * @param name Name shown on the gate
+     */
+    MacroDefinition(const std::wstring& name) : mName(name) {}
+
+    static std::shared_ptr<MacroDefinition> Create(const std::wstring& name,
+                                                   const std::vector<std::shared_ptr<Gate>>& gates);
+
+    void Instantiate(CompiledCircuit* target, const std::vector<int>& inputs, const std::vector<int>& outputs) const;
+
+    /**
+     * Get the name shown on the gate
+     * @return Name of the macro
+     */
+    const std::wstring& GetName() const { return mName; }
+
+    /**
+     * Get the number of inputs
+     * @return Number of inputs
+     */
+    int GetInputCount() const { return mInputCount; }
+
+    /**
+     * Get the number of outputs
+     * @return Number of outputs, at most MaxMacroOutputs
+     */
+    int GetOutputCount() const { return int(mOutputs.size()); }
+
+    /**
+     * Get the number of gates the macro flattens into
+     * @return Number of nodes
+     */
+    int GetNodeCount() const { return mCircuit.GetNodeCount(); }
+};
+
+#endif //MACRODEFINITION_H
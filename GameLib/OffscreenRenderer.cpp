@@ -0,0 +1,102 @@
+/**
+ * @file OffscreenRenderer.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "OffscreenRenderer.h"
+#include "Game.h"
+#include "TraceRecorder.h"
+#include <cstdlib>
+
+/**
+ * Constructor
+ * @param width Width of the image in pixels
+ * @param height Height of the image in pixels
+ * @param tickTime Simulated time for one tick in seconds
+ */
+OffscreenRenderer::OffscreenRenderer(int width, int height, double tickTime) :
+    mWidth(width), mHeight(height), mTickTime(tickTime)
+{
+}
+
+/**
+ * Draw the game as it is now
+ * @param game Game to draw
+ * @return The image
+ */
+wxImage OffscreenRenderer::Render(Game* game)
+{
+    TraceScope trace("OffscreenRenderer::Render", "paint");
+
+    wxImage image(mWidth, mHeight);
+    image.SetRGB(wxRect(0, 0, mWidth, mHeight), 255, 255, 255);
+
+    // The image is only written when the context is destroyed, which
+    // is once the shared pointer passed to OnDraw is released
+    {
+        std::shared_ptr<wxGraphicsContext> graphics(wxGraphicsContext::Create(image));
+        game->OnDraw(graphics, mWidth, mHeight);
+    }
+
+    return image;
+}
+
+/**
+ * Advance the game to a simulation time, then draw it
+ * @param game Game to draw
+ * @param time Simulation time in seconds
+ * @return The image
+ */
+wxImage OffscreenRenderer::RenderAt(Game* game, double time)
+{
+    Advance(game, time);
+    return Render(game);
+}
+
+/**
+ * Run the game with fixed ticks until it reaches a simulation time.
+ * A time already passed leaves the game as it is.
+ * @param game Game to advance
+ * @param time Simulation time in seconds
+ */
+void OffscreenRenderer::Advance(Game* game, double time)
+{
+    // Count ticks rather than adding up times so rounding never adds an extra tick
+    auto ticks = (long)((time - mTime) / mTickTime + 0.5);
+    for (long tick = 0; tick < ticks; tick++)
+    {
+        game->Update(mTickTime);
+    }
+    mTime += ticks * mTickTime;
+}
+
+/**
+ * Compare an image with the one it is expected to match
+ * @param image Image to check
+ * @param expected Expected image, such as a golden image from a file
+ * @param tolerance Largest difference in any channel that still counts as the same
+ * @return Fraction of pixels that differ, 1 if the sizes differ
+ */
+double OffscreenRenderer::Compare(const wxImage& image, const wxImage& expected, int tolerance)
+{
+    if (!image.IsOk() || !expected.IsOk() || image.GetSize() != expected.GetSize())
+    {
+        return 1;
+    }
+
+    auto a = image.GetData();
+    auto b = expected.GetData();
+    int count = image.GetWidth() * image.GetHeight();
+    int different = 0;
+    for (int p = 0; p < count * 3; p += 3)
+    {
+        if (std::abs(a[p] - b[p]) > tolerance || std::abs(a[p + 1] - b[p + 1]) > tolerance ||
+            std::abs(a[p + 2] - b[p + 2]) > tolerance)
+        {
+            different++;
+        }
+    }
+
+    return double(different) / count;
+}
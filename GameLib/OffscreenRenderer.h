@@ -0,0 +1,60 @@
+/**
+ * @file OffscreenRenderer.h
+ * @author Attulya Pratap Gupta
+ *
+ * Draws a game into an image without a window
+ */
+
+#ifndef OFFSCREENRENDERER_H
+#define OFFSCREENRENDERER_H
+
+class Game;
+
+/**
+ * Draws a game into an image of any size without a GameView.
+ *
+ * The game is advanced with fixed ticks to the simulation time asked for
+ * and drawn with Game::OnDraw exactly as the window draws it, so the same
+ * level at the same time always gives the same image. Used for golden
+ * image tests, level thumbnails and measuring drawing on its own.
+ */
+class OffscreenRenderer
+{
+private:
+    /// Width of the image in pixels
+    int mWidth;
+
+    /// Height of the image in pixels
+    int mHeight;
+
+    /// Simulated time for one tick in seconds
+    double mTickTime;
+
+    /// Simulation time the game has been advanced to
+    double mTime = 0;
+
+public:
+    /// Simulated time for one tick when none is given, 60 ticks a second
+    static constexpr double DefaultTickTime = 1.0 / 60.0;
+
+    OffscreenRenderer(int width, int height, double tickTime = DefaultTickTime);
+
+    wxImage Render(Game* game);
+    wxImage RenderAt(Game* game, double time);
+    void Advance(Game* game, double time);
+
+    /**
+     * Start counting simulation time again, such as when a new level is loaded
+     */
+    void Reset() { mTime = 0; }
+
+    /**
+     * Get the simulation time the game has been advanced to
+     * @return Time in seconds
+     */
+    double GetTime() const { return mTime; }
+
+    static double Compare(const wxImage& image, const wxImage& expected, int tolerance = 0);
+};
+
+#endif //OFFSCREENRENDERER_H
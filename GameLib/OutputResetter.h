@@ -17,17 +17,31 @@
 class OutputResetter : public VisitorBase
 {
 private:
+    /// Lane whose sensor outputs are reset, AllLanes for every lane
+    int mLane = AllLanes;
 
 public:
     /** Default constructor */
     OutputResetter() = default;
 
+    /**
+     * Constructor
+     * @param lane Lane whose sensor outputs are reset
+     */
+    explicit OutputResetter(int lane) : mLane(lane) {}
+
     /**
      * @brief Visit SensorOutput object
      * @param sensorOutput Pointer to SensorOutput object
      *
      */
-    void VisitSensorOutput(SensorOutput* sensorOutput) override { sensorOutput->ResetOutput(); }
+    void VisitSensorOutput(SensorOutput* sensorOutput) override
+    {
+        if(mLane == AllLanes || sensorOutput->GetLane() == mLane)
+        {
+            sensorOutput->ResetOutput();
+        }
+    }
 
 };
 
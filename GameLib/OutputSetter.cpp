@@ -13,6 +13,11 @@
  */
 void OutputSetter::VisitSensorOutput(SensorOutput *sensorOutput)
 {
+    if(mLane != AllLanes && sensorOutput->GetLane() != mLane)
+    {
+        return;
+    }
+
     sensorOutput->SetOutput(mColor);
     sensorOutput->SetOutput(mShape);
     sensorOutput->SetOutput(mContent);
@@ -26,11 +26,20 @@ private:
     /// Integer representing content of product detected
     int mContent = 0;
 
+    /// Lane whose sensor outputs are set, AllLanes for every lane
+    int mLane = AllLanes;
+
 public:
 
     /** Default constructor */
     OutputSetter() = default;
 
+    /**
+     * Constructor
+     * @param lane Lane whose sensor outputs are set
+     */
+    explicit OutputSetter(int lane) : mLane(lane) {}
+
     void VisitSensorOutput(SensorOutput* sensorOutput) override;
 
     void SetProductProperties(int color, int shape, int content);
@@ -160,6 +160,18 @@ public:
 	void AddPin(Pin *pin);
 	void Accept(VisitorBase *visitor);
 
+	/**
+	 * Save the state of the pin
+	 * @param state Buffer to save into
+	 */
+	void SaveState(GameState* state) const { state->Put(mState); }
+
+	/**
+	 * Restore the state of the pin
+	 * @param state Buffer to restore from
+	 */
+	void RestoreState(GameState* state) { state->Get(mState); }
+
 	/**
 	 * The getX constant
 	 * @return the X position in pixels
@@ -184,6 +196,12 @@ public:
 	 */
 	Pin* GetConnected() const { return mConnected; }
 
+	/**
+	 * Get the input pins this output pin is wired to
+	 * @return The connected pins
+	 */
+	const std::set<Pin *>& GetPins() const { return mPins; }
+
     /**
 	 * Get the owner this pin belongs to
 	 * @return pointer to the owner it belongs to
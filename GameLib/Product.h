@@ -19,7 +19,7 @@
  */
 class Product : public Item
 {
-private:
+public:
 	/// The possible product properties
 	enum class Properties
 	{
@@ -30,6 +30,7 @@ private:
 	/// The property types
 	enum class Types { Color, Shape, Content };
 
+private:
 	/// The color of the product
 	Properties mColor = Properties::None;
 
@@ -110,6 +111,19 @@ public:
 	 * */
 	Properties GetContent() const { return mContent; }
 
+	/**
+	 * Set what the product looks like, such as for a window drawing a frame captured from another game
+	 * @param shape Product shape
+	 * @param color Product color
+	 * @param content Product content
+	 */
+	void SetLook(Properties shape, Properties color, Properties content)
+	{
+		mShape = shape;
+		mColor = color;
+		mContent = content;
+	}
+
 	/**
 	*  Getter for product kick state
 	*  @return bool whether or not the product should be kicked
@@ -196,6 +210,42 @@ public:
 	 */
 	bool GetPassedBeam() const { return mPassedBeam; }
 
+	/**
+	 * Save the position and kick/scoring flags of the product
+	 * @param state Buffer to save into
+	 */
+	void SaveState(GameState* state) override
+	{
+		state->Put(GetX());
+		state->Put(GetY());
+		state->Put(mKicked);
+		state->Put(mDetected);
+		state->Put(mWasDetected);
+		state->Put(mPassedBeam);
+		state->Put(mScored);
+		state->Put(mSpeed);
+		state->Put(mKickSpeed);
+	}
+
+	/**
+	 * Restore the position and kick/scoring flags of the product
+	 * @param state Buffer to restore from
+	 */
+	void RestoreState(GameState* state) override
+	{
+		double x = GetX(), y = GetY();
+		state->Get(x);
+		state->Get(y);
+		SetLocation(x, y);
+		state->Get(mKicked);
+		state->Get(mDetected);
+		state->Get(mWasDetected);
+		state->Get(mPassedBeam);
+		state->Get(mScored);
+		state->Get(mSpeed);
+		state->Get(mKickSpeed);
+	}
+
 };
 
 #endif // PRODUCT_H
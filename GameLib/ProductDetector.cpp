@@ -6,6 +6,10 @@
 #include "pch.h"
 #include "ProductDetector.h"
 #include "OutputSetter.h"
+#include "OutputResetter.h"
+#include "Game.h"
+#include "LaneVisitor.h"
+#include "TraceRecorder.h"
 
 /**
  * @brief Visit Product object
@@ -15,36 +19,70 @@
  */
 void ProductDetector::VisitProduct(Product *product)
 {
-    mProducts.push_back(product);
+    if(OnLane(product))
+    {
+        mProducts.push_back(product);
+    }
 }
 
 /**
- * Function to update the beam using the list of products
- * */
-void ProductDetector::UpdateBeam()
+ * Update the beam and remember the products that pass it.
+ *
+ * Only touches items on this detector's lane, so detectors for
+ * different lanes can run at the same time.
+ */
+void ProductDetector::DetectBeam()
 {
+    mPassed.clear();
     for(auto product: mProducts)
     {
-        if(mBeam->DetectProduct(product->GetYRange()) && !product->GetKicked())
+        bool passed = product->GetPassedBeam();
+        bool detected = mBeam->DetectProduct(product->GetYRange()) && !product->GetKicked();
+
+        mBeam->SetOutput(detected);
+        product->SetDetected(detected);
+
+        if(!passed && product->GetPassedBeam())
+        {
+            mPassed.push_back(product);
+        }
+
+        if(detected)
         {
-            mBeam->SetOutput(true);
-            product->SetDetected(true);
             break;
         }
-        else
+    }
+}
+
+/**
+ * Count the products found by DetectBeam and queue them for scoring
+ */
+void ProductDetector::PostPassedProducts()
+{
+    for(auto product : mPassed)
+    {
+        mBeam->GetGame()->GetLevel()->ProductPassedBeam();
+        if(mScoreboard != nullptr)
         {
-            mBeam->SetOutput(false);
-        	product->SetDetected(false);
+            mScoreboard->PostPassedBeam(product);
         }
     }
+    mPassed.clear();
 }
 
 /**
- * Function to update the sensor using the list of products
+ * Function to update the sensor using the list of products.
+ * Only the sensor outputs this detector visited are reset and set
  * */
 void ProductDetector::UpdateSensor()
 {
-    OutputSetter setter;
+    OutputResetter resetter(mLane);
+    for(auto output : mOutputs)
+    {
+        output->Accept(&resetter);
+    }
+
+    OutputSetter setter(mLane);
     for(auto product: mProducts)
     {
         int color = static_cast<int>(product->GetColor());
@@ -55,7 +93,10 @@ void ProductDetector::UpdateSensor()
 
         if(mSensor->DetectProduct(product->GetYRange(), product->GetY()) && !product->GetKicked())
         {
-            mSensor->GetGame()->Accept(&setter);
+            for(auto output : mOutputs)
+            {
+                output->Accept(&setter);
+            }
             break;
         }
     }
@@ -79,40 +120,60 @@ void ProductDetector::UpdateSparty()
 }
 
 /**
- * Function to update Scoreboard using the list of products
+ * Function to update Scoreboard with the products that have passed the beam
  */
 void ProductDetector::UpdateScoreboard()
 {
-    if(mSparty->IsConnected())
+    if(mScoreboard != nullptr)
     {
-        // temp variable for score
-        int nextLevelScore = mScoreboard->GetLevelScore();
-        for(auto product : mProducts)
+        mScoreboard->ScorePassedProducts();
+    }
+}
+
+/**
+ * Detect the products passing the beam and sensor of this detector's lane
+ */
+void ProductDetector::UpdateLane()
+{
+    if(mBeam != nullptr)
+    {
+        DetectBeam();
+    }
+
+    if(mSensor != nullptr)
+    {
+        UpdateSensor();
+    }
+}
+
+/**
+ * Update the beam and sensor of every lane.
+ *
+ * One pass over the items sorts them into a detector per lane, then the
+ * lanes are detected on the thread pool. A lane only touches its own
+ * items, and the products found passing a beam are posted to the level
+ * and scoreboard once every lane has finished, in lane order.
+ *
+ * @param game Game to update
+ * @param pool Threads to detect the lanes on
+ */
+void ProductDetector::UpdateLanes(Game* game, ThreadPool& pool)
+{
+    TraceScope trace("ProductDetector::UpdateLanes", "update");
+
+    LaneVisitor visitor;
+    game->Accept(&visitor);
+    auto detectors = visitor.GetDetectors();
+
+    pool.ParallelFor(int(detectors.size()), 1, [&detectors](int begin, int end) {
+        for(int lane = begin; lane < end; lane++)
         {
-            if(!product->GetScored() && product->GetPassedBeam())
-            {
-                if(product->GetKicked() == product->ShouldKick())
-                {
-                    // Adds to level score if kicked correctly
-                    nextLevelScore += mScoreboard->GetGood();
-
-                    // Marks product as scored
-                    product->SetScored(true);
-                }
-                else
-                {
-                    // Subtract from level score if kicked incorrectly
-                    nextLevelScore += mScoreboard->GetBad();
-
-                    // Marks product as scored
-                    product->SetScored(true);
-                }
-                break;
-            }
+            detectors[lane]->UpdateLane();
         }
+    });
 
-
-        // Update scoreboard with new score
-        mScoreboard->SetLevelScore(nextLevelScore);
+    for(auto detector : detectors)
+    {
+        detector->PostPassedProducts();
     }
-}
\ No newline at end of file
+}
@@ -14,6 +14,7 @@
 #include "Sensor.h"
 #include "OutputSetter.h"
 #include "Scoreboard.h"
+#include "ThreadPool.h"
 
 /**
  * @class ProductDetector
@@ -21,6 +22,10 @@
  *
  * This class inherits from VisitorBase and implements visitor methods for various game objects.
  * It is used to find Sparty, Sensor, and Beam, as well as to detect products and update each of them.
+ *
+ * A detector made for one lane only sees the items on that lane, so the
+ * detectors for different lanes share nothing but the level and
+ * scoreboard, which they only touch in PostPassedProducts.
  */
 class ProductDetector : public VisitorBase
 {
@@ -30,25 +35,54 @@ private:
     Sensor* mSensor = nullptr;         ///< Pointer to the Sensor object
 	Scoreboard* mScoreboard = nullptr;	///< Pointer to the Scoreboard object
     std::vector<Product*> mProducts;   ///< Vector of pointers to Product objects
+    std::vector<Product*> mPassed;     ///< Products that passed the beam in the last DetectBeam
+    std::vector<SensorOutput*> mOutputs; ///< Sensor outputs the sensor sets
+    int mLane = AllLanes;              ///< Lane this detector sees, AllLanes for every lane
+
+    /**
+     * Is an item on the lane this detector sees?
+     * @param item Item to check
+     * @return True if the detector should keep the item
+     */
+    bool OnLane(Item* item) const { return mLane == AllLanes || item->GetLane() == mLane; }
+
+    void UpdateLane();
+    void DetectBeam();
+    void PostPassedProducts();
 
 public:
+    /** Default constructor, sees every lane */
+    ProductDetector() = default;
+
+    /**
+     * Constructor
+     * @param lane Lane this detector sees
+     */
+    explicit ProductDetector(int lane) : mLane(lane) {}
+
     /**
      * @brief Visit Sparty object
      * @param sparty Pointer to Sparty object
      */
-    void VisitSparty(Sparty* sparty) override { mSparty = sparty; }
+    void VisitSparty(Sparty* sparty) override { if (OnLane(sparty)) mSparty = sparty; }
 
     /**
      * @brief Visit Sensor object
      * @param sensor Pointer to Sensor object
      */
-    void VisitSensor(Sensor* sensor) override { mSensor = sensor; }
+    void VisitSensor(Sensor* sensor) override { if (OnLane(sensor)) mSensor = sensor; }
 
     /**
      * @brief Visit Beam object
      * @param beam Pointer to Beam object
      */
-    void VisitBeam(Beam * beam) override { mBeam = beam; }
+    void VisitBeam(Beam * beam) override { if (OnLane(beam)) mBeam = beam; }
+
+    /**
+     * @brief Visit SensorOutput object
+     * @param output Pointer to SensorOutput object
+     */
+    void VisitSensorOutput(SensorOutput* output) override { if (OnLane(output)) mOutputs.push_back(output); }
 
     /**
      * @brief Visit Scorboard object
@@ -58,14 +92,14 @@ public:
 
     void VisitProduct(Product* product) override;
 
-    void UpdateBeam();
-
     void UpdateSensor();
 
     void UpdateSparty();
 
     void UpdateScoreboard();
 
+    static void UpdateLanes(Game* game, ThreadPool& pool = ThreadPool::Get());
+
 };
 
 #endif //PROJECT1_GAMELIB_PRODUCTDETECTOR_H
@@ -0,0 +1,33 @@
+/**
+ * @file ProductParker.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "ProductParker.h"
+#include "Product.h"
+#include "Game.h"
+
+/**
+ * Is a product finished with, so it can be taken out of play?
+ * @param product Product to check
+ * @return True once the product is scored, has left the belt and is out of sight
+ */
+bool ProductParker::IsFinished(Product* product)
+{
+    return product->GetScored() && (product->GetKicked() || product->GetPassedBeam()) &&
+           !product->GetGame()->IsItemVisible(product);
+}
+
+/**
+ * Park a product if it is finished with
+ * @param product Product we are visiting
+ */
+void ProductParker::VisitProduct(Product* product)
+{
+    if (IsFinished(product))
+    {
+        product->GetGame()->ParkItem(product);
+        mParked++;
+    }
+}
@@ -0,0 +1,41 @@
+/**
+ * @file ProductParker.h
+ * @author Attulya Pratap Gupta
+ *
+ * Visitor that takes finished products out of play
+ */
+
+#ifndef PRODUCTPARKER_H
+#define PRODUCTPARKER_H
+
+#include "VisitorBase.h"
+
+class Product;
+
+/**
+ * Visitor that parks products that are finished with.
+ *
+ * A product is finished once it has been scored, has been kicked or has
+ * passed the beam, and is out of sight. Parked products are no longer
+ * updated, drawn or visited, so the cost of a frame follows the products
+ * on screen rather than every product seen since the level started.
+ */
+class ProductParker : public VisitorBase
+{
+private:
+    /// Number of products parked by this visitor
+    int mParked = 0;
+
+public:
+    void VisitProduct(Product* product) override;
+
+    /**
+     * Get the number of products parked by this visitor
+     * @return Number of products
+     */
+    int GetParkedCount() const { return mParked; }
+
+    static bool IsFinished(Product* product);
+};
+
+#endif //PRODUCTPARKER_H
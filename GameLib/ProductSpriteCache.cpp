@@ -0,0 +1,167 @@
+/**
+ * @file ProductSpriteCache.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "ProductSpriteCache.h"
+#include "SpriteAtlas.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <cmath>
+
+using Properties = Product::Properties;
+
+/**
+ * Get the colour a product is filled with
+ * @param color Colour property of the product
+ * @return The fill colour
+ */
+static wxColour FillColour(Properties color)
+{
+    switch (color)
+    {
+    case Properties::Red:
+        return wxColour(187, 0, 0);
+
+    case Properties::Green:
+        return wxColour(24, 69, 59);
+
+    case Properties::Blue:
+        return wxColour(0, 39, 76);
+
+    default:
+        return *wxWHITE;
+    }
+}
+
+/**
+ * Get the cache the game draws products from
+ * @return The one cache for the process
+ */
+ProductSpriteCache& ProductSpriteCache::Get()
+{
+    static ProductSpriteCache cache;
+    return cache;
+}
+
+/**
+ * Render what a product looks like
+ * @param key Shape, colour and content of the product
+ * @param size Width and height of the image in pixels
+ * @return The image, transparent outside the shape
+ */
+wxImage ProductSpriteCache::Render(const Key& key, int size)
+{
+    TraceScope trace("ProductSpriteCache::Render", "paint");
+
+    wxImage image(size, size);
+    image.InitAlpha();
+    memset(image.GetAlpha(), 0, size * size);
+
+    std::unique_ptr<wxGraphicsContext> graphics(wxGraphicsContext::Create(image));
+    graphics->SetBrush(wxBrush(FillColour(std::get<1>(key))));
+    graphics->SetPen(*wxBLACK_PEN);
+
+    // Keep the outline inside the image
+    double inner = size - 2;
+    switch (std::get<0>(key))
+    {
+    case Properties::Circle:
+        graphics->DrawEllipse(1, 1, inner, inner);
+        break;
+
+    case Properties::Diamond:
+    {
+        double half = size / 2.0;
+        const wxPoint2DDouble points[5] = {
+            wxPoint2DDouble(half, 1),
+            wxPoint2DDouble(size - 1, half),
+            wxPoint2DDouble(half, size - 1),
+            wxPoint2DDouble(1, half),
+            wxPoint2DDouble(half, 1)
+        };
+        graphics->DrawLines(5, points);
+        break;
+    }
+
+    default:
+        graphics->DrawRectangle(1, 1, inner, inner);
+        break;
+    }
+
+    auto content = Product::PropertiesToContentImages.find(std::get<2>(key));
+    if (content != Product::PropertiesToContentImages.end())
+    {
+        // The content image is loaded once into the atlas and shared with the sensor panel
+        auto& atlas = SpriteAtlas::Get();
+        atlas.Load(content->second);
+        auto contentImage = atlas.GetImage(content->second);
+        if (contentImage != nullptr && contentImage->IsOk())
+        {
+            double contentSize = size * ContentScale;
+            auto bitmap = graphics->CreateBitmapFromImage(*contentImage);
+            graphics->DrawBitmap(bitmap, (size - contentSize) / 2, (size - contentSize) / 2, contentSize, contentSize);
+        }
+    }
+
+    // The image is only written when the context is done with it
+    graphics.reset();
+    return image;
+}
+
+/**
+ * Draw a product from its sprite, rendering the sprite if this is the
+ * first time a product like it has been drawn at this size
+ * @param graphics Graphics context to draw on
+ * @param key Shape, colour and content of the product
+ * @param x Left of where to draw
+ * @param y Top of where to draw
+ * @param width Width to draw
+ * @param height Height to draw
+ * @return True if the product was drawn
+ */
+bool ProductSpriteCache::Draw(wxGraphicsContext* graphics, const Key& key,
+                              double x, double y, double width, double height)
+{
+    if (width <= 0 || height <= 0)
+    {
+        return false;
+    }
+
+    // Render at the size the product covers on the screen so the copy is never blurred
+    double a, b, c, d, tx, ty;
+    graphics->GetTransform().Get(&a, &b, &c, &d, &tx, &ty);
+    int pixelSize = int(std::ceil(std::max(width, height) * std::sqrt(a * a + b * b)));
+    if (pixelSize < 1)
+    {
+        return false;
+    }
+
+    if (pixelSize != mPixelSize || graphics->GetRenderer() != mRenderer)
+    {
+        mSprites.clear();
+        mPixelSize = pixelSize;
+        mRenderer = graphics->GetRenderer();
+    }
+
+    auto found = mSprites.find(key);
+    if (found == mSprites.end())
+    {
+        found = mSprites.emplace(key, graphics->CreateBitmapFromImage(Render(key, pixelSize))).first;
+        mRendered++;
+    }
+
+    graphics->DrawBitmap(found->second, x, y, width, height);
+    return true;
+}
+
+/**
+ * Remove every sprite so they are rendered again
+ */
+void ProductSpriteCache::Clear()
+{
+    mSprites.clear();
+    mPixelSize = 0;
+    mRenderer = nullptr;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file ProductSpriteCache.h
+ * @author Attulya Pratap Gupta
+ *
+ * Draws products from sprites rendered once for each appearance
+ */
+
+#ifndef PRODUCTSPRITECACHE_H
+#define PRODUCTSPRITECACHE_H
+
+#include <map>
+#include <memory>
+#include <tuple>
+
+#include "Product.h"
+
+/**
+ * Draws products from pre-rendered sprites.
+ *
+ * A product looks the same as any other with the same shape, colour and
+ * content, so there are only 60 different products to draw. Each one is
+ * rendered the first time it is needed, at the size in pixels it is drawn
+ * at, and every product after that is drawn by copying the sprite.
+ * When the window is resized the sprites are rendered again at the new size.
+ */
+class ProductSpriteCache
+{
+public:
+    /// What a product looks like: shape, colour and content
+    using Key = std::tuple<Product::Properties, Product::Properties, Product::Properties>;
+
+    /// Fraction of the product the content image covers
+    static constexpr double ContentScale = 0.8;
+
+private:
+    /// Sprites rendered so far
+    std::map<Key, wxGraphicsBitmap> mSprites;
+
+    /// Size in pixels the sprites were rendered at
+    int mPixelSize = 0;
+
+    /// Renderer the sprites were made for
+    wxGraphicsRenderer* mRenderer = nullptr;
+
+    /// Number of sprites rendered since the cache was created
+    int mRendered = 0;
+
+public:
+    static ProductSpriteCache& Get();
+
+    static wxImage Render(const Key& key, int size);
+
+    bool Draw(wxGraphicsContext* graphics, const Key& key, double x, double y, double width, double height);
+
+    /**
+     * Draw a product
+     * @param graphics Graphics context to draw on
+     * @param product Product to draw, centred on its location
+     * @return True if the product was drawn
+     */
+    bool Draw(std::shared_ptr<wxGraphicsContext> graphics, Product* product)
+    {
+        return Draw(graphics.get(), Key(product->GetShape(), product->GetColor(), product->GetContent()),
+                    product->GetX() - product->GetWidth() / 2, product->GetY() - product->GetHeight() / 2,
+                    product->GetWidth(), product->GetHeight());
+    }
+
+    void Clear();
+
+    /**
+     * Get the number of sprites in the cache
+     * @return Number of sprites
+     */
+    int GetCount() const { return int(mSprites.size()); }
+
+    /**
+     * Get the number of sprites rendered since the cache was created
+     * @return Number of renders, which only grows when the size or renderer changes
+     */
+    int GetRenderedCount() const { return mRendered; }
+};
+
+#endif //PRODUCTSPRITECACHE_H
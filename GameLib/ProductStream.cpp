@@ -0,0 +1,315 @@
+/**
+ * @file ProductStream.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "ProductStream.h"
+#include "Product.h"
+#include "Conveyor.h"
+#include "Game.h"
+#include "Level.h"
+#include "ProductParker.h"
+#include "TraceRecorder.h"
+#include <wx/sstream.h>
+
+/// X location products in the pool are parked at, well left of the window
+const double ParkedX = -10000;
+
+/// Y location products in the pool are parked at, well above the window
+const double ParkedY = -10000;
+
+/// Distance beyond the ends of the belt a product is placed or removed at, in virtual pixels
+const double StreamMargin = 100;
+
+/// Number of products in a pool when the conveyor does not say
+const int DefaultPoolSize = 16;
+
+/**
+ * Create the product source a conveyor asks for.
+ *
+ * A conveyor with stream="seed" gets generated products from its seed
+ * attribute, stopping after count products if it has one. A conveyor
+ * with stream="file" reads products from its file attribute, starting
+ * over when the file ends if loop="yes".
+ *
+ * @param conveyorNode The conveyor XML node
+ * @return The source, nullptr if the conveyor does not stream its products
+ */
+std::unique_ptr<ProductSource> ProductSource::Create(wxXmlNode* conveyorNode)
+{
+    auto stream = conveyorNode->GetAttribute(L"stream", L"");
+    if (stream == L"seed")
+    {
+        unsigned long seed;
+        long count;
+        conveyorNode->GetAttribute(L"seed", L"0").ToULong(&seed);
+        conveyorNode->GetAttribute(L"count", L"-1").ToLong(&count);
+        return std::make_unique<GeneratedProductSource>((unsigned int)seed, int(count));
+    }
+    else if (stream == L"file")
+    {
+        auto filename = conveyorNode->GetAttribute(L"file", L"");
+        bool loop = conveyorNode->GetAttribute(L"loop", L"no") == L"yes";
+        return std::make_unique<FileProductSource>(filename.ToStdString(), loop);
+    }
+
+    return nullptr;
+}
+
+/**
+ * Constructor
+ * @param seed Seed the products are generated from
+ * @param count Number of products to give, -1 for no end
+ */
+GeneratedProductSource::GeneratedProductSource(unsigned int seed, int count) : mSeed(seed), mCount(count)
+{
+    Rewind();
+}
+
+/**
+ * Get the next product
+ * @return The product node, owned by the caller, nullptr once the count is reached
+ */
+wxXmlNode* GeneratedProductSource::Next()
+{
+    if (mCount >= 0 && mGiven >= mCount)
+    {
+        return nullptr;
+    }
+
+    return mGenerator->CreateProduct(mGiven++ == 0);
+}
+
+/**
+ * Start again from the first product
+ */
+void GeneratedProductSource::Rewind()
+{
+    mGenerator = std::make_unique<LevelGenerator>(mSeed);
+    mGiven = 0;
+}
+
+/**
+ * Constructor
+ * @param filename File with one product element on each line
+ * @param loop Start again from the top once the file runs out?
+ */
+FileProductSource::FileProductSource(const std::string& filename, bool loop) :
+    mFilename(filename), mFile(filename), mLoop(loop)
+{
+    std::string line;
+    while (std::getline(mFile, line))
+    {
+        mCount += line.find("<product") != std::string::npos ? 1 : 0;
+    }
+
+    Rewind();
+}
+
+/**
+ * Get the next product.
+ *
+ * A looping file that goes a whole pass without a product that loads
+ * is treated as used up, rather than read over and over.
+ *
+ * @return The product node, owned by the caller, nullptr once the file is used up
+ */
+wxXmlNode* FileProductSource::Next()
+{
+    if (mCount == 0)
+    {
+        return nullptr;
+    }
+
+    std::string line;
+    bool rewound = false;
+    while (true)
+    {
+        if (!std::getline(mFile, line))
+        {
+            if (!mLoop || rewound)
+            {
+                return nullptr;
+            }
+
+            Rewind();
+            rewound = true;
+            continue;
+        }
+
+        if (line.find("<product") == std::string::npos)
+        {
+            continue;
+        }
+
+        wxStringInputStream input(wxString::FromUTF8(line.c_str()));
+        wxXmlDocument xmlDoc;
+        if (xmlDoc.Load(input) && xmlDoc.GetRoot() != nullptr)
+        {
+            return xmlDoc.DetachRoot();
+        }
+    }
+}
+
+/**
+ * Start again from the first product
+ */
+void FileProductSource::Rewind()
+{
+    mFile.clear();
+    mFile.seekg(0);
+}
+
+/**
+ * Constructor
+ * @param source Where the products come from
+ * @param lane Lane of the conveyor this stream feeds
+ */
+ProductStream::ProductStream(std::unique_ptr<ProductSource> source, int lane) :
+    mSource(std::move(source)), mLane(lane)
+{
+    ReadNext();
+}
+
+/**
+ * Create the products the stream uses and add them to the game
+ * @param level Level the products belong to
+ * @param size Number of products, 0 for the default
+ * @param conveyorHeight Height of the conveyor in virtual pixels
+ */
+void ProductStream::CreatePool(Level* level, int size, double conveyorHeight)
+{
+    TraceScope trace("ProductStream::CreatePool", "load");
+
+    wxXmlNode blank(wxXML_ELEMENT_NODE, L"product");
+    for (int i = 0; i < (size > 0 ? size : DefaultPoolSize); i++)
+    {
+        auto product = std::make_shared<Product>(level);
+        product->XmlLoad(&blank);
+        product->SetLane(mLane);
+
+        // Resetting the conveyor puts pooled products back where they are parked
+        product->SetInitialPosition(ParkedX, ParkedY, conveyorHeight);
+        level->GetGame()->AddProduct(product);
+
+        Park(product.get());
+        mPool.push_back(product);
+        mFree.push_back(product.get());
+    }
+}
+
+/**
+ * Read the next product from the source and work out where it goes
+ */
+void ProductStream::ReadNext()
+{
+    mNext.reset(mSource->Next());
+    if (mNext == nullptr)
+    {
+        return;
+    }
+
+    // Placements work the same way as in a level file
+    wxString placementStr = mNext->GetAttribute(L"placement", L"0");
+    double placement = 0;
+    if (placementStr.StartsWith(L"+"))
+    {
+        placementStr.Mid(1).ToDouble(&placement);
+        mNextPlacement = mLastPlacement + placement;
+    }
+    else
+    {
+        placementStr.ToDouble(&mNextPlacement);
+    }
+    mLastPlacement = mNextPlacement;
+}
+
+/**
+ * Put a product back in the pool, out of sight and out of the way of the detectors
+ * @param product Product to park
+ */
+void ProductStream::Park(Product* product)
+{
+    product->SetKicked(true);
+    product->SetKickSpeed(0);
+    product->SetScored(true);
+    product->SetLocation(ParkedX, ParkedY);
+    product->GetGame()->ParkItem(product);
+}
+
+/**
+ * Return products that have left the belt to the pool and place the
+ * products that are about to come into view.
+ *
+ * @param conveyor The conveyor the stream feeds
+ * @param distance Distance the belt moved since the last update
+ */
+void ProductStream::Update(Conveyor* conveyor, double distance)
+{
+    TraceScope trace("ProductStream::Update", "update");
+
+    mDistance += distance;
+
+    double top = conveyor->GetY() - conveyor->GetHeight() / 2;
+    double bottom = conveyor->GetY() + conveyor->GetHeight() / 2;
+
+    // Products past the end of the belt or finished with go back to the pool
+    for (size_t i = 0; i < mActive.size();)
+    {
+        auto product = mActive[i];
+        if (product->GetY() - StreamMargin > bottom || ProductParker::IsFinished(product))
+        {
+            Park(product);
+            mFree.push_back(product);
+            mActive[i] = mActive.back();
+            mActive.pop_back();
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    // Place the next products once they are about to come into view
+    while (mNext != nullptr && !mFree.empty())
+    {
+        double y = conveyor->GetY() - mNextPlacement + mDistance;
+        if (y < top - StreamMargin)
+        {
+            break;
+        }
+
+        auto product = mFree.back();
+        mFree.pop_back();
+
+        product->XmlLoad(mNext.get());
+        product->SetInitialPosition(conveyor->GetX(), y, conveyor->GetHeight());
+        product->Reset(conveyor);
+        product->SetLane(mLane);
+        product->GetGame()->UnparkItem(product);
+        mActive.push_back(product);
+
+        ReadNext();
+    }
+}
+
+/**
+ * Park every product and start the source again, such as when the conveyor restarts
+ */
+void ProductStream::Reset()
+{
+    // Resetting the conveyor resets every product, including the parked ones
+    mActive.clear();
+    mFree.clear();
+    for (auto& product : mPool)
+    {
+        Park(product.get());
+        mFree.push_back(product.get());
+    }
+
+    mSource->Rewind();
+    mDistance = 0;
+    mLastPlacement = 0;
+    ReadNext();
+}
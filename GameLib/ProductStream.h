@@ -0,0 +1,191 @@
+/**
+ * @file ProductStream.h
+ * @author Attulya Pratap Gupta
+ *
+ * Streams products onto a conveyor from a fixed pool
+ */
+
+#ifndef PRODUCTSTREAM_H
+#define PRODUCTSTREAM_H
+
+#include <memory>
+#include <vector>
+#include <fstream>
+
+#include "LevelGenerator.h"
+
+class Level;
+class Product;
+class Conveyor;
+
+/**
+ * A source of products for a streaming conveyor.
+ *
+ * Each call to Next gives the XML for the next product, in the same
+ * form as the products in a level file.
+ */
+class ProductSource
+{
+public:
+    virtual ~ProductSource() = default;
+
+    /**
+     * Get the next product
+     * @return The product node, owned by the caller, nullptr once the source is used up
+     */
+    virtual wxXmlNode* Next() = 0;
+
+    /**
+     * Start again from the first product
+     */
+    virtual void Rewind() = 0;
+
+    /**
+     * Get the number of products the source gives
+     * @return Number of products, -1 if it never ends
+     */
+    virtual int GetCount() const = 0;
+
+    static std::unique_ptr<ProductSource> Create(wxXmlNode* conveyorNode);
+};
+
+/**
+ * Products chosen at random the same way LevelGenerator chooses them
+ */
+class GeneratedProductSource : public ProductSource
+{
+private:
+    /// Seed the products are generated from
+    unsigned int mSeed;
+
+    /// Number of products to give, -1 for no end
+    int mCount;
+
+    /// Number of products given so far
+    int mGiven = 0;
+
+    /// Generator the products come from
+    std::unique_ptr<LevelGenerator> mGenerator;
+
+public:
+    GeneratedProductSource(unsigned int seed, int count = -1);
+
+    wxXmlNode* Next() override;
+    void Rewind() override;
+
+    /**
+     * Get the number of products the source gives
+     * @return Number of products, -1 if it never ends
+     */
+    int GetCount() const override { return mCount; }
+};
+
+/**
+ * Products read one line at a time from a file.
+ *
+ * Each line holds one product element, such as
+ * <product placement="+150" shape="circle" color="red" kick="yes"/>,
+ * so the file is never held in memory however long it is.
+ */
+class FileProductSource : public ProductSource
+{
+private:
+    /// Name of the file
+    std::string mFilename;
+
+    /// The open file
+    std::ifstream mFile;
+
+    /// Start again from the top once the file runs out?
+    bool mLoop;
+
+    /// Number of products in the file, counted when it is opened
+    int mCount = 0;
+
+public:
+    FileProductSource(const std::string& filename, bool loop = false);
+
+    wxXmlNode* Next() override;
+    void Rewind() override;
+
+    /**
+     * Get the number of products the source gives
+     * @return Number of products, -1 if it loops forever
+     */
+    int GetCount() const override { return mLoop ? -1 : mCount; }
+};
+
+/**
+ * Feeds a conveyor from a product source using a fixed pool of products.
+ *
+ * Products are taken from the pool just before they come into view and
+ * go back to it once they have left the belt, so the number of product
+ * objects stays the same however long the conveyor runs. Products in the
+ * pool are parked with Game::ParkItem so nothing updates, draws or visits them.
+ */
+class ProductStream
+{
+private:
+    /// Where the products come from
+    std::unique_ptr<ProductSource> mSource;
+
+    /// Every product the stream owns
+    std::vector<std::shared_ptr<Product>> mPool;
+
+    /// Products waiting in the pool to be used
+    std::vector<Product*> mFree;
+
+    /// Products on the belt
+    std::vector<Product*> mActive;
+
+    /// Next product to place, nullptr if the source is used up
+    std::unique_ptr<wxXmlNode> mNext;
+
+    /// Placement of the next product, measured like placements in a level file
+    double mNextPlacement = 0;
+
+    /// Placement of the last product placed
+    double mLastPlacement = 0;
+
+    /// Distance the belt has moved since the stream started
+    double mDistance = 0;
+
+    /// Lane of the conveyor this stream feeds
+    int mLane = 0;
+
+    void ReadNext();
+    void Park(Product* product);
+
+public:
+    ProductStream(std::unique_ptr<ProductSource> source, int lane);
+
+    void CreatePool(Level* level, int size, double conveyorHeight);
+    void Update(Conveyor* conveyor, double distance);
+    void Reset();
+
+    /**
+     * Get the number of products the stream gives
+     * @return Number of products, -1 if it never ends
+     */
+    int GetCount() const { return mSource->GetCount(); }
+
+    /**
+     * Get the lane of the conveyor this stream feeds
+     * @return Lane number
+     */
+    int GetLane() const { return mLane; }
+
+    /**
+     * Get the number of products the stream owns
+     * @return Size of the pool
+     */
+    int GetPoolSize() const { return int(mPool.size()); }
+
+    /**
+     * Get the number of products on the belt
+     * @return Number of products
+     */
+    int GetActiveCount() const { return int(mActive.size()); }
+};
+
+#endif //PRODUCTSTREAM_H
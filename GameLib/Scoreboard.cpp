@@ -7,10 +7,12 @@
 #include <sstream>
 #include "Scoreboard.h"
 
-#include "LastProductVisitor.h"
 #include "Level.h"
+#include "Game.h"
 #include "VisitorBase.h"
-#include "ProductDetector.h"
+#include "Product.h"
+#include "SpartyVisitor.h"
+#include "TraceRecorder.h"
 
 /**
  * Size of the scoreboard in virtual pixels
@@ -50,6 +52,8 @@ Scoreboard::Scoreboard(Level* level) : Item(level->GetGame())
  */
 void Scoreboard::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
+	TraceScope trace("Scoreboard::Draw", "paint");
+
 	// Offset for text position
 	double offsetX = xCoordinate + 10;
 	double offsetY = yCoordinate + 10;
@@ -100,15 +104,13 @@ void Scoreboard::Draw(std::shared_ptr<wxGraphicsContext> graphics)
  */
 void Scoreboard::Update(double elapsed)
 {
+	TraceScope trace("Scoreboard::Update", "update");
+
 	// Updates level score
-	ProductDetector detector;
-	GetGame()->Accept(&detector);
-	detector.UpdateScoreboard();
+	ScorePassedProducts();
 
 	// Level end scoring
-	LastProductVisitor visitor;
-	GetGame()->Accept(&visitor);
-	if(visitor.HasLastProductReached())
+	if(GetGame()->GetLevel()->IsLastProductReached())
 	{
 		// Delay adding score until Level Complete banner appears
 		double timer = GetGame()->GetEndTimer() - elapsed;
@@ -165,4 +167,91 @@ void Scoreboard::AddLevelScoreToGame()
 		mPerfectScore = true;
 		mGameScore += GetGame()->CalculateBonusPoints();
 	}
-}
\ No newline at end of file
+}
+
+/**
+ * Score every product that has passed the beam since the last update.
+ *
+ * Products are queued by the beam as they pass it, so this only looks
+ * at those products and scores all of them, however many passed in a
+ * single update. Nothing on a lane is scored until that lane's Sparty
+ * is connected.
+ */
+void Scoreboard::ScorePassedProducts()
+{
+	if(mPassedProducts.empty())
+	{
+		return;
+	}
+
+	if(mSpartys.empty())
+	{
+		SpartyVisitor visitor;
+		GetGame()->Accept(&visitor);
+		for(auto sparty : visitor.GetSpartys())
+		{
+			mSpartys.emplace(sparty->GetLane(), sparty);
+		}
+	}
+
+	// Products on a lane whose Sparty is not connected yet stay queued
+	std::vector<Product*> waiting;
+	for(auto product : mPassedProducts)
+	{
+		if(product->GetScored())
+		{
+			continue;
+		}
+
+		auto sparty = mSpartys.find(product->GetLane());
+		if(sparty == mSpartys.end() || !sparty->second->IsConnected())
+		{
+			waiting.push_back(product);
+			continue;
+		}
+
+		// Good if kicked correctly, bad otherwise
+		mLevelScore += product->GetKicked() == product->ShouldKick() ? mGood : mBad;
+		product->SetScored(true);
+	}
+
+	mPassedProducts = waiting;
+}
+
+/**
+ * Save the scores
+ * @param state Buffer to save into
+ */
+void Scoreboard::SaveState(GameState* state)
+{
+	state->Put(mLevelScore);
+	state->Put(mGameScore);
+	state->Put(mPerfectScore);
+	state->Put(mScoreAdded);
+
+	state->Put(mPassedProducts.size());
+	for(auto product : mPassedProducts)
+	{
+		state->Put(product);
+	}
+}
+
+/**
+ * Restore the scores
+ * @param state Buffer to restore from
+ */
+void Scoreboard::RestoreState(GameState* state)
+{
+	state->Get(mLevelScore);
+	state->Get(mGameScore);
+	state->Get(mPerfectScore);
+	state->Get(mScoreAdded);
+
+	size_t count = 0;
+	state->Get(count);
+	mPassedProducts.resize(count, nullptr);
+	for(auto& product : mPassedProducts)
+	{
+		state->Get(product);
+	}
+}
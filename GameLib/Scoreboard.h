@@ -10,7 +10,11 @@
 
 #include "Item.h"
 #include <string>
+#include <vector>
+#include <map>
 class Level;
+class Product;
+class Sparty;
 
 /**
  * Class for the scoreboard
@@ -36,6 +40,10 @@ private:
 	bool mPerfectScore = false;
 	/// Whether the level score has been added to game score
 	bool mScoreAdded = false;
+	/// Products that have passed the beam and are waiting to be scored
+	std::vector<Product*> mPassedProducts;
+	/// Sparty kicking each lane of this level, found the first time products are scored
+	std::map<int, Sparty*> mSpartys;
 
 public:
     /// Default constructor (disabled)
@@ -105,6 +113,27 @@ public:
 
     void Accept(VisitorBase* visitor) override;
     void AddLevelScoreToGame();
+    void ScorePassedProducts();
+
+	/**
+	 * Queue a product that has just passed the beam to be scored
+	 * @param product Product that passed the beam
+	 */
+	void PostPassedBeam(Product* product) { mPassedProducts.push_back(product); }
+
+	/**
+	 * Discard products waiting to be scored, such as when the products are reset
+	 */
+	void ClearPassedProducts() { mPassedProducts.clear(); }
+
+	/**
+	 * Get the number of products waiting to be scored
+	 * @return Number of products
+	 */
+	size_t GetPassedProductCount() const { return mPassedProducts.size(); }
+
+    void SaveState(GameState* state) override;
+    void RestoreState(GameState* state) override;
 
     /**
      * Getter for instructions
@@ -36,6 +36,11 @@ public:
 	 * End of Level Scoring Sequence
 	 */
 	void EndLevelScoring() {mScoreboard->AddLevelScoreToGame();}
+
+	/**
+	 * Discard products waiting to be scored, if there is a scoreboard
+	 */
+	void ClearPassedProducts() { if (mScoreboard != nullptr) mScoreboard->ClearPassedProducts(); }
 };
 
 
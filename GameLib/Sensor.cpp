@@ -9,8 +9,8 @@
 #include "Game.h"
 #include "ItemFinder.h"
 #include "OutputSetter.h"
-#include "OutputResetter.h"
-#include "ProductDetector.h"
+#include "TraceRecorder.h"
+#include "SpriteAtlas.h"
 #include <string>
 
 using namespace std;
@@ -42,13 +42,12 @@ const int SensorRange[] = {-40, 15};
  */
 Sensor::Sensor(Level* level) : Item(level->GetGame())
 {
-    mCameraImage = make_unique<wxImage>(SensorCameraImage, wxBITMAP_TYPE_ANY);
-    mCameraBitmap = make_unique<wxBitmap>(*mCameraImage);
-    mCableImage = make_unique<wxImage>(SensorCableImage, wxBITMAP_TYPE_ANY);
-    mCableBitmap = make_unique<wxBitmap>(*mCableImage);
+    // The images are loaded into the atlas once, however many sensors there are
+    SpriteAtlas::Get().Load(SensorCameraImage);
+    auto size = SpriteAtlas::Get().Load(SensorCableImage);
 
-    SetWidth(mCableBitmap->GetWidth());
-    SetHeight(mCableBitmap->GetHeight());
+    SetWidth(size.GetWidth());
+    SetHeight(size.GetHeight());
 }
 
 /**
@@ -57,18 +56,20 @@ Sensor::Sensor(Level* level) : Item(level->GetGame())
  * */
 void Sensor::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
+    TraceScope trace("Sensor::Draw", "paint");
 
-    graphics->DrawBitmap(*mCableBitmap,
-                         GetX() - GetWidth()/2,
-                         GetY() - GetHeight() / 2,
-                         GetWidth(),
-                         GetHeight());
+    auto& atlas = SpriteAtlas::Get();
+    atlas.Draw(graphics, SensorCableImage,
+               GetX() - GetWidth()/2,
+               GetY() - GetHeight() / 2,
+               GetWidth(),
+               GetHeight());
 
-    graphics->DrawBitmap(*mCameraBitmap,
-                         GetX() - GetWidth()/2,
-                         GetY() - GetHeight() / 2,
-                         GetWidth(),
-                         GetHeight());
+    atlas.Draw(graphics, SensorCameraImage,
+               GetX() - GetWidth()/2,
+               GetY() - GetHeight() / 2,
+               GetWidth(),
+               GetHeight());
 
 
 }
@@ -83,7 +84,7 @@ void Sensor::XmlLoad(wxXmlNode *node)
 
     auto outputs = node->GetChildren();
 
-    double wid = mCableBitmap->GetWidth();
+    double wid = GetWidth();
     double x = GetX() + wid/2;
     double offsetY = GetY() + PanelOffsetY;
 
@@ -96,6 +97,7 @@ void Sensor::XmlLoad(wxXmlNode *node)
         double y = offsetY + mNumOutputs * PropertySize.GetHeight();
         newOutput->XmlLoad(output);
         newOutput->SetLocation(x, y);
+        newOutput->SetLane(GetLane());
         GetGame()->AddItem(newOutput);
         ++mNumOutputs;
     }
@@ -132,18 +134,3 @@ bool Sensor::DetectProduct(tuple<double, double> range, double y)
     }
     return false;
 }
-
-/**
- * Update the sensor
- * @param elapsed The elapsed time since the last update
- */
-void Sensor::Update(double elapsed)
-{
-    OutputResetter resetter;
-    GetGame()->Accept(&resetter);
-
-    ProductDetector detector;
-    GetGame()->Accept(&detector);
-
-    detector.UpdateSensor();
-}
\ No newline at end of file
@@ -19,18 +19,6 @@ class Sensor : public Item
 {
 private:
 
-    /// The camera image
-    std::unique_ptr<wxImage> mCameraImage;
-
-    /// The bitmap we can display for this camera
-    std::unique_ptr<wxBitmap> mCameraBitmap;
-
-    /// The cable image
-    std::unique_ptr<wxImage> mCableImage;
-
-    /// The bitmap we can display for this cable
-    std::unique_ptr<wxBitmap> mCableBitmap;
-
     /// Number of outputs the sensor has
     int mNumOutputs = 0;
 
@@ -50,8 +38,6 @@ public:
 
     void XmlLoad(wxXmlNode* node) override;
 
-    void Update(double elapsed) override;
-
     /**
      * Getter for number of outputs for testing
      * @return number of outputs
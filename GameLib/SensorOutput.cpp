@@ -6,6 +6,8 @@
 #include "SensorOutput.h"
 #include "Game.h"
 #include "VisitorBase.h"
+#include "TraceRecorder.h"
+#include "SpriteAtlas.h"
 
 using namespace std;
 
@@ -137,18 +139,29 @@ void SensorOutput::Draw(std::shared_ptr<wxGraphicsContext> graphics)
         case Properties::Basketball:
         case Properties::Football:
         {
-            graphics->DrawBitmap(*mContentBitmap, propertyX, propertyY, PropertyShapeSize, PropertyShapeSize);
+            SpriteAtlas::Get().Draw(graphics, PropertiesToContentImages.at(mProperty),
+                                    propertyX, propertyY, PropertyShapeSize, PropertyShapeSize);
             break;
         }
         default:
             break;
     }
 
-    mOutputPin->SetPosition(GetX() + PropertySize.GetWidth() + DefaultLineLength, GetY() + PropertySize.GetHeight()/2);
     mOutputPin->Draw(graphics);
 
 }
 
+/**
+ * Set the location of the sensor output, with its pin beside it
+ * @param x X location of the top left of the output in pixels
+ * @param y Y location of the top left of the output in pixels
+ */
+void SensorOutput::SetLocation(double x, double y)
+{
+    Item::SetLocation(x, y);
+    mOutputPin->SetPosition(GetX() + PropertySize.GetWidth() + DefaultLineLength, GetY() + PropertySize.GetHeight()/2);
+}
+
 /**
  * Loads the attributes of the sensor output
  *
@@ -169,8 +182,8 @@ void SensorOutput::XmlLoad(wxXmlNode *node)
             case Properties::Basketball:
             case Properties::Football:
             {
-                mContentImage = make_unique<wxImage>(SensorOutput::PropertiesToContentImages.at(mProperty), wxBITMAP_TYPE_PNG);
-                mContentBitmap = make_unique<wxBitmap>(*mContentImage);
+                // Every output showing the same content shares one image in the atlas
+                SpriteAtlas::Get().Load(SensorOutput::PropertiesToContentImages.at(mProperty));
                 break;
             }
             default:
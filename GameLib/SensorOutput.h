@@ -35,16 +35,11 @@ private:
     /// A list of the output pins
     std::shared_ptr<Pin> mOutputPin;
 
-    /// Content image for the outputs Izzo, Smith, Football, and Basketball
-    std::unique_ptr<wxImage> mContentImage;
-
-    /// Content bitmap for outputs Izzo, Smith, Football, and Basketball
-    std::unique_ptr<wxBitmap> mContentBitmap;
-
 public:
 
     SensorOutput(Game* game);
     void Draw(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void SetLocation(double x, double y) override;
     void XmlLoad(wxXmlNode* node) override;
     void SetOutput(int property);
 
@@ -77,6 +72,18 @@ public:
      * */
     void SetShowControlPoints(bool show) override { mOutputPin->SetShowControlPoints(show);}
 
+    /**
+     * Save the output pin state
+     * @param state Buffer to save into
+     */
+    void SaveState(GameState* state) override { mOutputPin->SaveState(state); }
+
+    /**
+     * Restore the output pin state
+     * @param state Buffer to restore from
+     */
+    void RestoreState(GameState* state) override { mOutputPin->RestoreState(state); }
+
 };
 
 #endif //PROJECT1_GAMELIB_SENSOROUTPUT_H
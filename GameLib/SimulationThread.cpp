@@ -0,0 +1,196 @@
+/**
+ * @file SimulationThread.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "SimulationThread.h"
+#include "Game.h"
+#include "InputLog.h"
+#include "TraceRecorder.h"
+#include <chrono>
+
+/**
+ * Constructor
+ * @param game Game to run
+ * @param view Game the window draws, never updated
+ * @param tickTime Simulated time for one tick in seconds
+ */
+SimulationThread::SimulationThread(Game* game, Game* view, double tickTime) :
+    mGame(game), mView(view), mTickTime(tickTime)
+{
+}
+
+/**
+ * Destructor
+ */
+SimulationThread::~SimulationThread()
+{
+    Stop();
+}
+
+/**
+ * Start running the game. The game must not be touched outside the thread until Stop.
+ */
+void SimulationThread::Start()
+{
+    if (IsRunning())
+    {
+        return;
+    }
+
+    mStopping = false;
+    mThread = std::thread(&SimulationThread::Run, this);
+}
+
+/**
+ * Stop running the game and wait for the thread to finish.
+ * Events still waiting are applied first.
+ */
+void SimulationThread::Stop()
+{
+    if (!IsRunning())
+    {
+        return;
+    }
+
+    mStopping = true;
+    mThread.join();
+}
+
+/**
+ * Send a user action to the game, only ever called by the window.
+ *
+ * Actions that change which items the game has are applied to the view
+ * straight away as well, so frames captured after the simulation applies
+ * them can be restored into it. Clicks and drags only change state the
+ * frames carry, so they are left to the simulation.
+ *
+ * @param event The action, applied before the next tick
+ * @return False if too many actions are waiting and this one was dropped
+ */
+bool SimulationThread::Post(const InputEvent& event)
+{
+    if (!mCommands.Post(event))
+    {
+        return false;
+    }
+
+    switch (event.GetType())
+    {
+        case InputEvent::Types::AddGate:
+        case InputEvent::Types::Connect:
+        case InputEvent::Types::SelectLevel:
+            event.Apply(mView);
+            break;
+
+        default:
+            break;
+    }
+
+    return true;
+}
+
+/**
+ * Run ticks straight away on the calling thread and publish a frame,
+ * such as to step through a game one tick at a time. Only call while stopped.
+ * @param ticks Number of ticks to run
+ */
+void SimulationThread::Step(int ticks)
+{
+    if (IsRunning() || ticks <= 0)
+    {
+        return;
+    }
+
+    for (int i = 0; i < ticks; i++)
+    {
+        Tick();
+    }
+    PublishFrame();
+}
+
+/**
+ * Draw the newest frame, only ever called by the window when it paints
+ * @param graphics Graphics context to draw on
+ * @param width Width of the window in pixels
+ * @param height Height of the window in pixels
+ * @return True if a frame not drawn before was restored into the view
+ */
+bool SimulationThread::Draw(std::shared_ptr<wxGraphicsContext> graphics, int width, int height)
+{
+    bool fresh = mFrames.Acquire() && mFrames.GetReadBuffer().mState.Restore(mView);
+    mView->OnDraw(graphics, width, height);
+    return fresh;
+}
+
+/**
+ * Capture the state of the game and publish it to the window
+ */
+void SimulationThread::PublishFrame()
+{
+    TraceScope trace("SimulationThread::PublishFrame", "update");
+
+    auto& frame = mFrames.GetWriteBuffer();
+    frame.mState.Capture(mGame);
+    frame.mTick = mTick;
+    frame.mTime = mTick * mTickTime;
+
+    mFrames.Publish();
+}
+
+/**
+ * Run one tick, applying the actions waiting before it
+ */
+void SimulationThread::Tick()
+{
+    TraceScope trace("SimulationThread::Tick", "update");
+
+    // Actions apply between ticks, exactly as a replay applies them
+    mCommands.Apply(mGame, mLog);
+
+    auto tick = InputEvent::Tick(mTickTime);
+    if (mLog != nullptr)
+    {
+        mLog->Record(tick);
+    }
+    tick.Apply(mGame);
+
+    mTick++;
+}
+
+/**
+ * The thread: run ticks on a fixed schedule and publish a frame after each batch
+ */
+void SimulationThread::Run()
+{
+    using Clock = std::chrono::steady_clock;
+    auto tickDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(mTickTime));
+    auto next = Clock::now();
+
+    while (!mStopping)
+    {
+        int ticks = 0;
+        while (Clock::now() >= next && ticks < MaxCatchUpTicks)
+        {
+            Tick();
+            ticks++;
+            next += tickDuration;
+        }
+
+        // Too far behind to catch up, so carry on from now rather than run a burst of ticks
+        if (ticks == MaxCatchUpTicks && Clock::now() >= next)
+        {
+            next = Clock::now() + tickDuration;
+        }
+
+        if (ticks > 0)
+        {
+            PublishFrame();
+        }
+
+        std::this_thread::sleep_until(next);
+    }
+
+    mCommands.Apply(mGame, mLog);
+}
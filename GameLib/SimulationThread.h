@@ -0,0 +1,135 @@
+/**
+ * @file SimulationThread.h
+ * @author Attulya Pratap Gupta
+ *
+ * Runs a game on its own thread with fixed ticks
+ */
+
+#ifndef SIMULATIONTHREAD_H
+#define SIMULATIONTHREAD_H
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "CommandQueue.h"
+#include "FrameState.h"
+#include "TripleBuffer.h"
+
+class Game;
+class InputLog;
+
+/**
+ * One frame published by the simulation thread
+ */
+struct RenderFrame
+{
+    /// Where the items are, their pin states and the scores after the tick
+    FrameState mState;
+
+    unsigned int mTick = 0; ///< Number of ticks run
+    double mTime = 0;       ///< Simulation time in seconds
+};
+
+/**
+ * Runs a game on its own thread with fixed ticks.
+ *
+ * The thread owns the game while it runs. User actions reach it as
+ * InputEvents through a CommandQueue and are applied between ticks,
+ * and after each batch of ticks the state of the game is captured into a
+ * FrameState that is published through a triple buffer. Capturing only
+ * copies plain values, so painting never happens inside the tick loop
+ * and every tick advances the game by the same time, whatever the frame
+ * rate.
+ *
+ * Drawing stays on the window's thread, as wxGraphicsContext requires on
+ * GTK and macOS. The window owns a second game, the view, that is never
+ * updated. It is given the same levels, gates and wires as the simulated
+ * game when events are posted, and the newest frame is restored into it
+ * before it is drawn.
+ */
+class SimulationThread
+{
+private:
+    /// The game, only touched by the thread while it runs
+    Game* mGame;
+
+    /// The game the window draws, only touched by the window
+    Game* mView;
+
+    /// Simulated time for one tick in seconds
+    double mTickTime;
+
+    /// The thread
+    std::thread mThread;
+
+    /// Set to stop the thread
+    std::atomic<bool> mStopping{false};
+
+    /// User actions waiting to be applied
+    CommandQueue mCommands;
+
+    /// Frames from the thread to the window
+    TripleBuffer<RenderFrame> mFrames;
+
+    /// If not null, every event applied is recorded here so the session can be replayed
+    InputLog* mLog = nullptr;
+
+    /// Ticks run so far
+    unsigned int mTick = 0;
+
+    void Run();
+    void Tick();
+    void PublishFrame();
+
+public:
+    /// Most ticks run to catch up before the lost time is dropped
+    static const int MaxCatchUpTicks = 10;
+
+    SimulationThread(Game* game, Game* view, double tickTime = 1.0 / 60.0);
+    ~SimulationThread();
+
+    /// Copy constructor (disabled)
+    SimulationThread(const SimulationThread&) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const SimulationThread&) = delete;
+
+    void Start();
+    void Stop();
+    bool Post(const InputEvent& event);
+    void Step(int ticks);
+    bool Draw(std::shared_ptr<wxGraphicsContext> graphics, int width, int height);
+
+    /**
+     * Take the newest frame if there is one, only ever called by the window
+     * @return True if GetFrame now gives a frame it did not give before
+     */
+    bool Acquire() { return mFrames.Acquire(); }
+
+    /**
+     * Get the newest frame taken by Acquire, valid until Acquire is called again
+     * @return The frame
+     */
+    const RenderFrame& GetFrame() const { return mFrames.GetReadBuffer(); }
+
+    /**
+     * Is the thread running?
+     * @return True between Start and Stop
+     */
+    bool IsRunning() const { return mThread.joinable(); }
+
+    /**
+     * Get the queue user actions go through
+     * @return The command queue
+     */
+    const CommandQueue& GetCommands() const { return mCommands; }
+
+    /**
+     * Record every event the thread applies, ticks included. Only call while stopped.
+     * @param log Log to record into, nullptr to stop recording
+     */
+    void SetLog(InputLog* log) { mLog = log; }
+};
+
+#endif //SIMULATIONTHREAD_H
@@ -8,6 +8,8 @@
 #include "Beam.h"
 #include "ProductDetector.h"
 #include "VisitorBase.h"
+#include "TraceRecorder.h"
+#include "SpriteAtlas.h"
 
 /// Image for the sparty background, what is behind the boot
 const std::wstring SpartyBackImage = L"images/sparty-back.png";
@@ -46,17 +48,14 @@ Sparty::Sparty(Level* level) : Item(level->GetGame())
 }
 
 /**
- * Load the images for Sparty
+ * Load the images for Sparty into the sprite atlas
  */
 void Sparty::LoadImages()
 {
-    mSpartyBackImage = std::make_unique<wxImage>(SpartyBackImage, wxBITMAP_TYPE_PNG);
-    mSpartyBootImage = std::make_unique<wxImage>(SpartyBootImage, wxBITMAP_TYPE_PNG);
-    mSpartyForegroundImage = std::make_unique<wxImage>(SpartyFrontImage, wxBITMAP_TYPE_PNG);
-
-    mSpartyBackBitmap = std::make_unique<wxBitmap>(*mSpartyBackImage);
-    mSpartyBootBitmap = std::make_unique<wxBitmap>(*mSpartyBootImage);
-    mSpartyForegroundBitmap = std::make_unique<wxBitmap>(*mSpartyForegroundImage);
+    auto& atlas = SpriteAtlas::Get();
+    mImageSize = atlas.Load(SpartyBackImage);
+    atlas.Load(SpartyBootImage);
+    atlas.Load(SpartyFrontImage);
 }
 
 /**
@@ -65,19 +64,23 @@ void Sparty::LoadImages()
  */
 void Sparty::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 {
+    TraceScope trace("Sparty::Draw", "paint");
+
     // Check if width is not set (or is zero)
-    if (GetWidth() <= 0 && mSpartyBackImage && mSpartyBackImage->IsOk())
+    if (GetWidth() <= 0 && mImageSize.GetHeight() > 0)
     {
         // Calculate and set width based on the current height and image aspect ratio
-        double aspectRatio = (double)mSpartyBackImage->GetWidth() / mSpartyBackImage->GetHeight();
+        double aspectRatio = (double)mImageSize.GetWidth() / mImageSize.GetHeight();
         SetWidth(GetHeight() * aspectRatio);
     }
 
     double wid = GetWidth();
     double hit = GetHeight();
 
+    auto& atlas = SpriteAtlas::Get();
+
     // Draw background
-    graphics->DrawBitmap(*mSpartyBackBitmap,
+    atlas.Draw(graphics, SpartyBackImage,
         GetX() - wid/2, GetY() - hit/2,
         wid, hit);
 
@@ -91,13 +94,13 @@ void Sparty::Draw(std::shared_ptr<wxGraphicsContext> graphics)
 	graphics->Translate(GetBootPivotX(), GetBootPivotY());
 	graphics->Rotate(mBootRotation);
 	graphics->Translate(-GetBootPivotX(), -GetBootPivotY());
-	graphics->DrawBitmap(*mSpartyBootBitmap,
+	atlas.Draw(graphics, SpartyBootImage,
 		0, 0,
 		wid, hit);
 	graphics->PopState();
 
     // Draw foreground
-    graphics->DrawBitmap(*mSpartyForegroundBitmap,
+    atlas.Draw(graphics, SpartyFrontImage,
         GetX() - wid/2, GetY() - hit/2,
         wid, hit);
 
@@ -114,7 +117,9 @@ void Sparty::Draw(std::shared_ptr<wxGraphicsContext> graphics)
  */
 void Sparty::Update(double elapsed)
 {
-    ProductDetector detector;
+    TraceScope trace("Sparty::Update", "update");
+
+    ProductDetector detector(GetLane());
     GetGame()->Accept(&detector);
 
     bool currentPinState = mInputPin->IsOne();
@@ -157,7 +162,7 @@ void Sparty::XmlLoad(wxXmlNode* node)
     double height;
     node->GetAttribute(L"height", L"300").ToDouble(&height);
     SetHeight(height);
-    double aspectRatio = (double)mSpartyBackImage->GetWidth() / mSpartyBackImage->GetHeight();
+    double aspectRatio = (double)mImageSize.GetWidth() / mImageSize.GetHeight();
     SetWidth(height * aspectRatio);
 }
 
@@ -293,4 +298,30 @@ bool Sparty::DetectProduct(std::tuple<double, double> range)
         return true;
     }
     return false;
-}
\ No newline at end of file
+}
+
+/**
+ * Save the kick animation and input pin state
+ * @param state Buffer to save into
+ */
+void Sparty::SaveState(GameState* state)
+{
+    state->Put(mBootRotation);
+    state->Put(mKickTime);
+    state->Put(mIsKicking);
+    state->Put(mPreviousPinState);
+    mInputPin->SaveState(state);
+}
+
+/**
+ * Restore the kick animation and input pin state
+ * @param state Buffer to restore from
+ */
+void Sparty::RestoreState(GameState* state)
+{
+    state->Get(mBootRotation);
+    state->Get(mKickTime);
+    state->Get(mIsKicking);
+    state->Get(mPreviousPinState);
+    mInputPin->RestoreState(state);
+}
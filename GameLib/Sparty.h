@@ -40,23 +40,8 @@ class Sparty : public Item
      /// Input pin for Sparty
      std::shared_ptr<SpartyPin> mInputPin;
 
-     /// Image for Sparty background
-     std::unique_ptr<wxImage> mSpartyBackImage;
-
-     /// Image for Sparty boot
-     std::unique_ptr<wxImage> mSpartyBootImage;
-
-     /// Image for Sparty foreground
-     std::unique_ptr<wxImage> mSpartyForegroundImage;
-
-     /// Bitmap for Sparty background
-     std::unique_ptr<wxBitmap> mSpartyBackBitmap;
-
-     /// Bitmap for Sparty boot
-     std::unique_ptr<wxBitmap> mSpartyBootBitmap;
-
-     /// Bitmap for Sparty foreground
-     std::unique_ptr<wxBitmap> mSpartyForegroundBitmap;
+     /// Size of the Sparty images in pixels, which all share the same size
+     wxSize mImageSize;
 
      // Private helper methods
      double GetBootPivotX() const;   // X-coordinate of the boot's pivot
@@ -122,6 +107,9 @@ public:
       * @return if the input pin has a connection or not
       * */
      bool IsConnected() { return !mInputPin->IsUnknown(); }
+
+     void SaveState(GameState* state) override;
+     void RestoreState(GameState* state) override;
 };
 
 #endif //SPARTY_H
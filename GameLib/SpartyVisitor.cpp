@@ -0,0 +1,6 @@
+/**
+ * @file SpartyVisitor.cpp
+ * @author Rachel Jansen
+ */
+#include "pch.h"
+#include "SpartyVisitor.h"
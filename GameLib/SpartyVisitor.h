@@ -0,0 +1,77 @@
+/**
+ * @file SpartyVisitor.h
+ * @author Rachel Jansen
+ *
+ *
+ */
+
+#ifndef SPARTYVISITOR_H
+#define SPARTYVISITOR_H
+
+#include "Sparty.h"
+#include "VisitorBase.h"
+
+/**
+ * Class to visit Sparty and get the input pin
+ */
+class SpartyVisitor : public VisitorBase {
+private:
+	/// First Sparty object we visited
+	Sparty* mSparty = nullptr;
+
+	/// Every Sparty object we visited, one per lane
+	std::vector<Sparty*> mSpartys;
+
+public:
+	/**
+	 * Visits Sparty and saves the pointer to it
+	 * @param sparty The Sparty object we are visiting
+	 */
+	void VisitSparty(Sparty* sparty) override
+	{
+		if (mSparty == nullptr)
+		{
+			mSparty = sparty;
+		}
+		mSpartys.push_back(sparty);
+	}
+
+	/**
+	 * Gets the first Sparty object we visited
+	 * @return Pointer to Sparty, nullptr if the game has none
+	 */
+	Sparty* GetSparty() { return mSparty; }
+
+	/**
+	 * Gets every Sparty object we visited
+	 * @return Pointers to the Sparty objects
+	 */
+	const std::vector<Sparty*>& GetSpartys() { return mSpartys; }
+
+	/**
+	 * Gets the Sparty object kicking products off a lane
+	 * @param lane Lane to look for
+	 * @return Pointer to Sparty, nullptr if the lane has none
+	 */
+	Sparty* GetSparty(int lane)
+	{
+		for (auto sparty : mSpartys)
+		{
+			if (sparty->GetLane() == lane)
+			{
+				return sparty;
+			}
+		}
+		return nullptr;
+	}
+
+	/**
+	 * Gets the input pin of the Sparty object we visited
+	 * @return Pointer to the input pin, nullptr if the game has no Sparty
+	 */
+	std::shared_ptr<Pin> GetInputPin() { return mSparty != nullptr ? mSparty->GetInputPin() : nullptr; }
+};
+
+
+
+#endif //SPARTYVISITOR_H
@@ -0,0 +1,289 @@
+/**
+ * @file SpriteAtlas.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "SpriteAtlas.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+
+/**
+ * Get the atlas the game draws from
+ * @return The one atlas for the process
+ */
+SpriteAtlas& SpriteAtlas::Get()
+{
+    static SpriteAtlas atlas;
+    return atlas;
+}
+
+/**
+ * Add an image to the atlas, replacing any image with the same name.
+ * The image is packed the next time the atlas is built.
+ * @param name Name the image is drawn by
+ * @param image The image
+ */
+void SpriteAtlas::Add(const std::wstring& name, const wxImage& image)
+{
+    mPending[name] = image;
+    mSprites[name] = Sprite{-1, 0, 0, image.GetWidth(), image.GetHeight()};
+}
+
+/**
+ * Load an image file into the atlas, named by its file name.
+ * A file already in the atlas is not read again.
+ * @param filename File to load
+ * @return Size of the image in pixels
+ */
+wxSize SpriteAtlas::Load(const std::wstring& filename)
+{
+    if (!Has(filename))
+    {
+        TraceScope trace("SpriteAtlas::Load", "asset");
+        Add(filename, wxImage(filename, wxBITMAP_TYPE_ANY));
+    }
+    return GetSize(filename);
+}
+
+/**
+ * Pack every image into pages.
+ *
+ * Images are placed tallest first along shelves that run across a page,
+ * starting a new shelf when one is full and a new page when a page is.
+ * An image too big for a page gets a page of its own.
+ */
+void SpriteAtlas::Build()
+{
+    TraceScope trace("SpriteAtlas::Build", "asset");
+
+    for (auto& pending : mPending)
+    {
+        mImages[pending.first] = pending.second;
+    }
+    mPending.clear();
+
+    std::vector<const std::wstring*> order;
+    for (auto& image : mImages)
+    {
+        order.push_back(&image.first);
+    }
+    std::stable_sort(order.begin(), order.end(), [this](const std::wstring* a, const std::wstring* b) {
+        return mImages[*a].GetHeight() > mImages[*b].GetHeight();
+    });
+
+    // Place the sprites, remembering how much of each page is used
+    std::vector<wxSize> used;
+    std::vector<const std::wstring*> oversized;
+    int shelfX = 0, shelfY = 0, shelfHeight = 0;
+    for (auto name : order)
+    {
+        auto& sprite = mSprites[*name];
+        int width = sprite.mWidth + SpritePadding * 2;
+        int height = sprite.mHeight + SpritePadding * 2;
+
+        if (width > PageSize || height > PageSize)
+        {
+            oversized.push_back(name);
+            continue;
+        }
+
+        if (used.empty() || shelfX + width > PageSize)
+        {
+            shelfX = 0;
+            shelfY += shelfHeight;
+            shelfHeight = 0;
+        }
+        if (used.empty() || shelfY + height > PageSize)
+        {
+            used.emplace_back(0, 0);
+            shelfX = shelfY = shelfHeight = 0;
+        }
+
+        sprite.mPage = int(used.size()) - 1;
+        sprite.mX = shelfX + SpritePadding;
+        sprite.mY = shelfY + SpritePadding;
+
+        shelfX += width;
+        shelfHeight = std::max(shelfHeight, height);
+        used.back().x = std::max(used.back().x, shelfX);
+        used.back().y = std::max(used.back().y, shelfY + shelfHeight);
+    }
+
+    for (auto name : oversized)
+    {
+        auto& sprite = mSprites[*name];
+        sprite.mPage = int(used.size());
+        sprite.mX = sprite.mY = SpritePadding;
+        used.emplace_back(sprite.mWidth + SpritePadding * 2, sprite.mHeight + SpritePadding * 2);
+    }
+
+    // Copy the images into their pages
+    mPages.clear();
+    for (auto& size : used)
+    {
+        wxImage page(size.x, size.y);
+        page.InitAlpha();
+        memset(page.GetData(), 0, size.x * size.y * 3);
+        memset(page.GetAlpha(), 0, size.x * size.y);
+        mPages.push_back(page);
+    }
+
+    for (auto& image : mImages)
+    {
+        auto& sprite = mSprites[image.first];
+        auto& source = image.second;
+        if (!source.IsOk())
+        {
+            continue;
+        }
+
+        auto& page = mPages[sprite.mPage];
+        for (int y = 0; y < sprite.mHeight; y++)
+        {
+            for (int x = 0; x < sprite.mWidth; x++)
+            {
+                page.SetRGB(sprite.mX + x, sprite.mY + y, source.GetRed(x, y), source.GetGreen(x, y), source.GetBlue(x, y));
+                page.SetAlpha(sprite.mX + x, sprite.mY + y, source.HasAlpha() ? source.GetAlpha(x, y) : 255);
+            }
+        }
+    }
+
+    // The bitmaps are made again for the new pages the next time anything draws
+    mPageBitmaps.clear();
+    mSubBitmaps.clear();
+    mRenderer = nullptr;
+}
+
+/**
+ * Remove every sprite from the atlas
+ */
+void SpriteAtlas::Clear()
+{
+    mSprites.clear();
+    mPending.clear();
+    mImages.clear();
+    mPages.clear();
+    mPageBitmaps.clear();
+    mSubBitmaps.clear();
+    mRenderer = nullptr;
+}
+
+/**
+ * Is there a sprite with this name?
+ * @param name Name of the sprite
+ * @return True if the atlas has the sprite
+ */
+bool SpriteAtlas::Has(const std::wstring& name) const
+{
+    return mSprites.find(name) != mSprites.end();
+}
+
+/**
+ * Get the size of a sprite
+ * @param name Name of the sprite
+ * @return Size in pixels, zero if there is no such sprite
+ */
+wxSize SpriteAtlas::GetSize(const std::wstring& name) const
+{
+    auto sprite = GetSprite(name);
+    return sprite != nullptr ? wxSize(sprite->mWidth, sprite->mHeight) : wxSize(0, 0);
+}
+
+/**
+ * Get where a sprite is in the atlas
+ * @param name Name of the sprite
+ * @return The sprite, nullptr if there is no such sprite
+ */
+const SpriteAtlas::Sprite* SpriteAtlas::GetSprite(const std::wstring& name) const
+{
+    auto found = mSprites.find(name);
+    return found != mSprites.end() ? &found->second : nullptr;
+}
+
+/**
+ * Get the image a sprite was made from
+ * @param name Name of the sprite
+ * @return The image, nullptr if there is no such sprite
+ */
+const wxImage* SpriteAtlas::GetImage(const std::wstring& name) const
+{
+    auto pending = mPending.find(name);
+    if (pending != mPending.end())
+    {
+        return &pending->second;
+    }
+
+    auto found = mImages.find(name);
+    return found != mImages.end() ? &found->second : nullptr;
+}
+
+/**
+ * Get the bitmap a sprite is drawn from, building the atlas if
+ * anything has been added since it was last built
+ * @param graphics Graphics context the bitmap is for
+ * @param name Name of the sprite
+ * @return The bitmap, nullptr if there is no such sprite
+ */
+const wxGraphicsBitmap* SpriteAtlas::GetBitmap(wxGraphicsContext* graphics, const std::wstring& name)
+{
+    if (!mPending.empty())
+    {
+        Build();
+    }
+
+    if (mRenderer != graphics->GetRenderer())
+    {
+        mPageBitmaps.clear();
+        mSubBitmaps.clear();
+        mRenderer = graphics->GetRenderer();
+    }
+
+    auto found = mSubBitmaps.find(name);
+    if (found != mSubBitmaps.end())
+    {
+        return &found->second;
+    }
+
+    auto sprite = GetSprite(name);
+    if (sprite == nullptr || sprite->mPage < 0)
+    {
+        return nullptr;
+    }
+
+    if (mPageBitmaps.empty())
+    {
+        TraceScope trace("SpriteAtlas::CreateBitmaps", "paint");
+        for (auto& page : mPages)
+        {
+            mPageBitmaps.push_back(graphics->CreateBitmapFromImage(page));
+        }
+    }
+
+    auto bitmap = graphics->CreateSubBitmap(mPageBitmaps[sprite->mPage],
+                                            sprite->mX, sprite->mY, sprite->mWidth, sprite->mHeight);
+    return &mSubBitmaps.emplace(name, bitmap).first->second;
+}
+
+/**
+ * Draw a sprite
+ * @param graphics Graphics context to draw on
+ * @param name Name of the sprite
+ * @param x Left of where to draw
+ * @param y Top of where to draw
+ * @param width Width to draw
+ * @param height Height to draw
+ * @return True if the sprite was drawn
+ */
+bool SpriteAtlas::Draw(wxGraphicsContext* graphics, const std::wstring& name,
+                       double x, double y, double width, double height)
+{
+    auto bitmap = GetBitmap(graphics, name);
+    if (bitmap == nullptr)
+    {
+        return false;
+    }
+
+    graphics->DrawBitmap(*bitmap, x, y, width, height);
+    return true;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file SpriteAtlas.h
+ * @author Attulya Pratap Gupta
+ *
+ * Packs the game's images into a few large textures
+ */
+
+#ifndef SPRITEATLAS_H
+#define SPRITEATLAS_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Packs the images the game draws into a few large pages.
+ *
+ * Each image is loaded once, however many items draw it, and packed
+ * into a page with the others. Drawing an image is then a blit of a
+ * rectangle of a page the graphics context has already made into a
+ * texture, rather than a separate bitmap for every item.
+ *
+ * Products are not in the atlas; ProductSpriteCache renders them at the
+ * size they are drawn at.
+ */
+class SpriteAtlas
+{
+public:
+    /// Width and height of a page in pixels
+    static const int PageSize = 2048;
+
+    /// Empty pixels kept around each sprite so neighbours never bleed into it when scaled
+    static const int SpritePadding = 1;
+
+    /// Where a sprite is in the atlas
+    struct Sprite
+    {
+        int mPage = -1;  ///< Page the sprite is on, -1 until the atlas is built
+        int mX = 0;      ///< Left of the sprite in the page
+        int mY = 0;      ///< Top of the sprite in the page
+        int mWidth = 0;  ///< Width of the sprite in pixels
+        int mHeight = 0; ///< Height of the sprite in pixels
+    };
+
+private:
+    /// Every sprite, by name
+    std::map<std::wstring, Sprite> mSprites;
+
+    /// Images added since the atlas was last built, by name
+    std::map<std::wstring, wxImage> mPending;
+
+    /// Images of every sprite so the pages can be packed again when one is added
+    std::map<std::wstring, wxImage> mImages;
+
+    /// The packed pages
+    std::vector<wxImage> mPages;
+
+    /// Each page made into a bitmap for the renderer below
+    std::vector<wxGraphicsBitmap> mPageBitmaps;
+
+    /// Sub bitmaps already made for each sprite
+    std::map<std::wstring, wxGraphicsBitmap> mSubBitmaps;
+
+    /// Renderer the bitmaps were made for
+    wxGraphicsRenderer* mRenderer = nullptr;
+
+    const wxGraphicsBitmap* GetBitmap(wxGraphicsContext* graphics, const std::wstring& name);
+
+public:
+    static SpriteAtlas& Get();
+
+    void Add(const std::wstring& name, const wxImage& image);
+    wxSize Load(const std::wstring& filename);
+    void Build();
+    void Clear();
+
+    bool Has(const std::wstring& name) const;
+    wxSize GetSize(const std::wstring& name) const;
+    const Sprite* GetSprite(const std::wstring& name) const;
+    const wxImage* GetImage(const std::wstring& name) const;
+
+    bool Draw(wxGraphicsContext* graphics, const std::wstring& name, double x, double y, double width, double height);
+
+    /**
+     * Draw a sprite
+     * @param graphics Graphics context to draw on
+     * @param name Name of the sprite
+     * @param x Left of where to draw
+     * @param y Top of where to draw
+     * @param width Width to draw
+     * @param height Height to draw
+     * @return True if the sprite was drawn
+     */
+    bool Draw(std::shared_ptr<wxGraphicsContext> graphics, const std::wstring& name,
+              double x, double y, double width, double height)
+    {
+        return Draw(graphics.get(), name, x, y, width, height);
+    }
+
+    /**
+     * Get the number of pages the atlas is packed into
+     * @return Number of pages
+     */
+    int GetPageCount() const { return int(mPages.size()); }
+
+    /**
+     * Get one packed page
+     * @param page Page number
+     * @return The page image
+     */
+    const wxImage& GetPage(int page) const { return mPages[page]; }
+};
+
+#endif //SPRITEATLAS_H
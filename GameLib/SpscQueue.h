@@ -0,0 +1,96 @@
+/**
+ * @file SpscQueue.h
+ * @author Attulya Pratap Gupta
+ *
+ * Lock-free queue from one producer thread to one consumer thread
+ */
+
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <vector>
+
+/**
+ * Fixed size ring buffer from one producer thread to one consumer thread.
+ *
+ * The producer only writes the tail and the consumer only writes the
+ * head, so neither ever takes a lock. Push fails rather than waits
+ * when the queue is full.
+ *
+ * @tparam T Type of the values queued
+ */
+template<class T>
+class SpscQueue
+{
+private:
+    /// The slots, one more than the capacity so full and empty can be told apart
+    std::vector<T> mSlots;
+
+    /// Next slot the consumer reads, written only by the consumer
+    alignas(64) std::atomic<size_t> mHead{0};
+
+    /// Next slot the producer writes, written only by the producer
+    alignas(64) std::atomic<size_t> mTail{0};
+
+public:
+    /**
+     * Constructor
+     * @param capacity Largest number of values the queue holds
+     */
+    explicit SpscQueue(size_t capacity) : mSlots(capacity + 1) {}
+
+    /**
+     * Add a value, only ever called by the producer
+     * @param value Value to add
+     * @return False if the queue is full and the value was not added
+     */
+    bool Push(const T& value)
+    {
+        auto tail = mTail.load(std::memory_order_relaxed);
+        auto next = tail + 1 == mSlots.size() ? 0 : tail + 1;
+        if (next == mHead.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        mSlots[tail] = value;
+        mTail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Take the oldest value, only ever called by the consumer
+     * @param value Set to the value taken
+     * @return False if the queue is empty
+     */
+    bool Pop(T& value)
+    {
+        auto head = mHead.load(std::memory_order_relaxed);
+        if (head == mTail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        value = mSlots[head];
+        mHead.store(head + 1 == mSlots.size() ? 0 : head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Is the queue empty? Only exact when called by the consumer
+     * @return True if there is nothing to take
+     */
+    bool IsEmpty() const
+    {
+        return mHead.load(std::memory_order_acquire) == mTail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Get the largest number of values the queue holds
+     * @return Capacity
+     */
+    size_t GetCapacity() const { return mSlots.size() - 1; }
+};
+
+#endif //SPSCQUEUE_H
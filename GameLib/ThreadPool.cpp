@@ -0,0 +1,130 @@
+/**
+ * @file ThreadPool.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "ThreadPool.h"
+#include <algorithm>
+
+/**
+ * Constructor
+ * @param threads Number of worker threads, -1 for one less than the number of cores
+ */
+ThreadPool::ThreadPool(int threads)
+{
+    if (threads < 0)
+    {
+        threads = std::max(int(std::thread::hardware_concurrency()) - 1, 0);
+    }
+
+    for (int t = 0; t < threads; t++)
+    {
+        mThreads.emplace_back(&ThreadPool::Worker, this);
+    }
+}
+
+/**
+ * Destructor
+ */
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mWake.notify_all();
+
+    for (auto& thread : mThreads)
+    {
+        thread.join();
+    }
+}
+
+/**
+ * Get the pool shared by the whole program
+ * @return The pool, with a worker for every core but one
+ */
+ThreadPool& ThreadPool::Get()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+/**
+ * Run a loop on the workers and the calling thread
+ * @param count Number of iterations
+ * @param chunk Number of iterations handed out at a time
+ * @param task Loop body, called with the first and one past the last iteration of a chunk
+ */
+void ThreadPool::ParallelFor(int count, int chunk, const std::function<void(int, int)>& task)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    chunk = std::max(chunk, 1);
+    if (mThreads.empty() || count <= chunk)
+    {
+        task(0, count);
+        return;
+    }
+
+    std::lock_guard<std::mutex> call(mCallMutex);
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTask = &task;
+        mCount = count;
+        mChunk = chunk;
+        mNext = 0;
+        mBusy = int(mThreads.size());
+        mGeneration++;
+    }
+    mWake.notify_all();
+
+    RunChunks();
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDone.wait(lock, [this] { return mBusy == 0; });
+    mTask = nullptr;
+}
+
+/**
+ * Take chunks of the current loop until there are none left
+ */
+void ThreadPool::RunChunks()
+{
+    for (int begin = mNext.fetch_add(mChunk); begin < mCount; begin = mNext.fetch_add(mChunk))
+    {
+        (*mTask)(begin, std::min(begin + mChunk, mCount));
+    }
+}
+
+/**
+ * A worker thread: wait for a loop, help run it, repeat
+ */
+void ThreadPool::Worker()
+{
+    unsigned int seen = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWake.wait(lock, [this, seen] { return mStopping || mGeneration != seen; });
+            if (mStopping)
+            {
+                return;
+            }
+            seen = mGeneration;
+        }
+
+        RunChunks();
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (--mBusy == 0)
+        {
+            mDone.notify_one();
+        }
+    }
+}
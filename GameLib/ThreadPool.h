@@ -0,0 +1,89 @@
+/**
+ * @file ThreadPool.h
+ * @author Attulya Pratap Gupta
+ *
+ * Fixed set of worker threads that split a loop between them
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed set of worker threads that split a loop between them.
+ *
+ * ParallelFor hands out chunks of an index range to the workers and to
+ * the calling thread, and returns only once every chunk has finished,
+ * so consecutive calls act as a barrier between the steps of a pass.
+ * The workers sleep between calls.
+ */
+class ThreadPool
+{
+private:
+    /// The worker threads
+    std::vector<std::thread> mThreads;
+
+    /// Protects everything below that is not atomic
+    std::mutex mMutex;
+
+    /// Signalled when there is work or the pool is stopping
+    std::condition_variable mWake;
+
+    /// Signalled when the last worker finishes its share of a loop
+    std::condition_variable mDone;
+
+    /// Only one ParallelFor at a time
+    std::mutex mCallMutex;
+
+    /// The loop body being run
+    const std::function<void(int, int)>* mTask = nullptr;
+
+    /// Start of the next chunk to hand out
+    std::atomic<int> mNext{0};
+
+    /// Number of iterations of the loop
+    int mCount = 0;
+
+    /// Number of iterations in a chunk
+    int mChunk = 1;
+
+    /// Number of workers still running the current loop
+    int mBusy = 0;
+
+    /// Incremented for every loop so the workers can tell there is new work
+    unsigned int mGeneration = 0;
+
+    /// Set when the pool is being destroyed
+    bool mStopping = false;
+
+    void Worker();
+    void RunChunks();
+
+public:
+    explicit ThreadPool(int threads = -1);
+    ~ThreadPool();
+
+    /// Copy constructor (disabled)
+    ThreadPool(const ThreadPool&) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const ThreadPool&) = delete;
+
+    static ThreadPool& Get();
+
+    void ParallelFor(int count, int chunk, const std::function<void(int, int)>& task);
+
+    /**
+     * Get the number of worker threads, not counting the caller of ParallelFor
+     * @return Number of workers
+     */
+    int GetThreadCount() const { return int(mThreads.size()); }
+};
+
+#endif //THREADPOOL_H
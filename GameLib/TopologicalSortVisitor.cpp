@@ -13,6 +13,10 @@
 #include "GateAnd.h"
 #include "GateOr.h"
 #include "GateSRFlipFlop.h"
+#include "GateMulti.h"
+#include "GateLut.h"
+#include "GateMacro.h"
+#include "TraceRecorder.h"
 
 /**
  * Helper function to sort pins in each gate
@@ -69,6 +73,8 @@ void TopologicalSortVisitor::VisitGateHelper(Gate* gate) {
  *  Function to finalize sorting and get sorted list of gates
  * */
 void TopologicalSortVisitor::FinalizeSorting() {
+    TraceScope trace("TopologicalSortVisitor::FinalizeSorting", "circuit");
+
     // Clear any existing sorted gates
     mSortedGates.clear();
 
@@ -123,4 +129,31 @@ void TopologicalSortVisitor::VisitGateDFlipFlop(GateDFlipFlop* gate)
 void TopologicalSortVisitor::VisitGateSRFlipFlop(GateSRFlipFlop* gate)
 {
     VisitGateHelper(gate);
-}
\ No newline at end of file
+}
+
+/**
+ * Function to visit multi-input Gate
+ * @param gate to visit
+ * */
+void TopologicalSortVisitor::VisitGateMulti(GateMulti* gate)
+{
+    VisitGateHelper(gate);
+}
+
+/**
+ * Function to visit lookup table Gate
+ * @param gate to visit
+ * */
+void TopologicalSortVisitor::VisitGateLut(GateLut* gate)
+{
+    VisitGateHelper(gate);
+}
+
+/**
+ * Function to visit macro Gate
+ * @param gate to visit
+ * */
+void TopologicalSortVisitor::VisitGateMacro(GateMacro* gate)
+{
+    VisitGateHelper(gate);
+}
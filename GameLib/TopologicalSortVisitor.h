@@ -39,6 +39,9 @@ public:
     void VisitGateNot(GateNot* gate) override;
     void VisitGateDFlipFlop(GateDFlipFlop* gate) override;
     void VisitGateSRFlipFlop(GateSRFlipFlop* gate) override;
+    void VisitGateMulti(GateMulti* gate) override;
+    void VisitGateLut(GateLut* gate) override;
+    void VisitGateMacro(GateMacro* gate) override;
 
     /**
      * Getter for sorted gates
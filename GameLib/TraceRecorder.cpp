@@ -0,0 +1,169 @@
+/**
+ * @file TraceRecorder.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include "pch.h"
+#include "TraceRecorder.h"
+#include <wx/ffile.h>
+#include <algorithm>
+
+/// Process id written into every trace event
+const int TraceProcessId = 1;
+
+/**
+ * Get the single trace recorder for the application
+ * @return Reference to the recorder
+ */
+TraceRecorder& TraceRecorder::Get()
+{
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+/**
+ * Get the ring buffer for the calling thread, creating it the first time
+ * a thread records an event. Only that first call takes a lock.
+ * @return Pointer to the buffer for this thread
+ */
+TraceRecorder::ThreadBuffer* TraceRecorder::GetThreadBuffer()
+{
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (buffer == nullptr)
+    {
+        auto newBuffer = std::make_unique<ThreadBuffer>();
+
+        std::lock_guard<std::mutex> lock(mBuffersMutex);
+        newBuffer->mThreadId = int(mBuffers.size()) + 1;
+        buffer = newBuffer.get();
+        mBuffers.push_back(std::move(newBuffer));
+    }
+
+    return buffer;
+}
+
+/**
+ * Current time relative to the start of the trace
+ * @return Time in microseconds
+ */
+long long TraceRecorder::Now() const
+{
+    auto elapsed = std::chrono::steady_clock::now() - mEpoch;
+    return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+}
+
+/**
+ * Write an event into the calling thread's ring buffer
+ * @param name Name of the event
+ * @param category Category of the event
+ * @param start Start time in microseconds
+ * @param duration Duration in microseconds, -1 for an instant event
+ */
+void TraceRecorder::Record(const char* name, const char* category, long long start, long long duration)
+{
+    auto buffer = GetThreadBuffer();
+
+    // Only this thread writes to the buffer, so a relaxed load of our own head is enough
+    auto head = buffer->mHead.load(std::memory_order_relaxed);
+    auto& event = buffer->mEvents[head % TraceBufferCapacity];
+    event.mName = name;
+    event.mCategory = category;
+    event.mStart = start;
+    event.mDuration = duration;
+
+    // Publish the event to Save
+    buffer->mHead.store(head + 1, std::memory_order_release);
+}
+
+/**
+ * Record an event that started at start and ends now
+ * @param name Name of the event
+ * @param category Category of the event
+ * @param start Start time in microseconds from Now()
+ */
+void TraceRecorder::Complete(const char* name, const char* category, long long start)
+{
+    if (IsEnabled())
+    {
+        Record(name, category, start, Now() - start);
+    }
+}
+
+/**
+ * Record an instant event, such as a user action
+ * @param name Name of the event
+ * @param category Category of the event
+ */
+void TraceRecorder::Instant(const char* name, const char* category)
+{
+    if (IsEnabled())
+    {
+        Record(name, category, Now(), -1);
+    }
+}
+
+/**
+ * Discard all events recorded so far
+ */
+void TraceRecorder::Clear()
+{
+    std::lock_guard<std::mutex> lock(mBuffersMutex);
+    for (auto& buffer : mBuffers)
+    {
+        buffer->mFirst.store(buffer->mHead.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Save the recorded events as Chrome trace_event JSON.
+ *
+ * Events written by other threads while saving may be lost or
+ * partially written, so save after the game has stopped updating.
+ *
+ * @param filename File to write
+ * @return True if the file was written
+ */
+bool TraceRecorder::Save(const wxString& filename)
+{
+    wxFFile file(filename, L"w");
+    if (!file.IsOpened())
+    {
+        return false;
+    }
+
+    file.Write(L"{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    bool first = true;
+    std::lock_guard<std::mutex> lock(mBuffersMutex);
+    for (auto& buffer : mBuffers)
+    {
+        auto head = buffer->mHead.load(std::memory_order_acquire);
+        auto begin = std::max(buffer->mFirst.load(std::memory_order_relaxed),
+                              head > TraceBufferCapacity ? head - TraceBufferCapacity : 0);
+
+        for (auto i = begin; i < head; i++)
+        {
+            auto& event = buffer->mEvents[i % TraceBufferCapacity];
+
+            wxString line;
+            if (event.mDuration >= 0)
+            {
+                line.Printf(L"{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,\"pid\":%d,\"tid\":%d}",
+                            event.mName, event.mCategory, event.mStart, event.mDuration,
+                            TraceProcessId, buffer->mThreadId);
+            }
+            else
+            {
+                line.Printf(L"{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%lld,\"pid\":%d,\"tid\":%d}",
+                            event.mName, event.mCategory, event.mStart,
+                            TraceProcessId, buffer->mThreadId);
+            }
+
+            file.Write(first ? line : L",\n" + line);
+            first = false;
+        }
+    }
+
+    file.Write(L"\n]}\n");
+    return file.Close();
+}
@@ -0,0 +1,143 @@
+/**
+ * @file TraceRecorder.h
+ * @author Attulya Pratap Gupta
+ *
+ * Records timing events and saves them as Chrome trace_event JSON
+ */
+
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include <atomic>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <chrono>
+
+/// Number of events each thread keeps before the oldest are overwritten
+const int TraceBufferCapacity = 1 << 16;
+
+/**
+ * Class that records trace events into per-thread ring buffers.
+ *
+ * Recording an event only touches the calling thread's own buffer,
+ * so tracing stays cheap enough to leave on while the game runs.
+ * The buffers can be saved as Chrome trace_event JSON, which
+ * chrome://tracing and Perfetto can open.
+ */
+class TraceRecorder
+{
+private:
+    /// A single recorded event
+    struct Event
+    {
+        const char* mName = nullptr;     ///< Name of the event (string literal)
+        const char* mCategory = nullptr; ///< Category of the event (string literal)
+        long long mStart = 0;            ///< Start time in microseconds since the epoch
+        long long mDuration = -1;        ///< Duration in microseconds, -1 for an instant event
+    };
+
+    /// Ring buffer of events written by a single thread
+    struct ThreadBuffer
+    {
+        std::array<Event, TraceBufferCapacity> mEvents; ///< The event slots
+        std::atomic<unsigned long long> mHead{0};       ///< Number of events ever written
+        std::atomic<unsigned long long> mFirst{0};      ///< First event still wanted after a Clear
+        int mThreadId = 0;                              ///< Id written to the trace for this thread
+    };
+
+    /// Is tracing currently enabled?
+    std::atomic<bool> mEnabled{false};
+
+    /// Protects the list of buffers when a new thread registers
+    std::mutex mBuffersMutex;
+
+    /// One buffer for every thread that has recorded an event
+    std::vector<std::unique_ptr<ThreadBuffer>> mBuffers;
+
+    /// Time all event timestamps are relative to
+    std::chrono::steady_clock::time_point mEpoch = std::chrono::steady_clock::now();
+
+    ThreadBuffer* GetThreadBuffer();
+    void Record(const char* name, const char* category, long long start, long long duration);
+
+    TraceRecorder() = default;
+
+public:
+    /// Copy constructor (disabled)
+    TraceRecorder(const TraceRecorder&) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const TraceRecorder&) = delete;
+
+    static TraceRecorder& Get();
+
+    /**
+     * Enable or disable recording
+     * @param enabled True to record events
+     */
+    void SetEnabled(bool enabled) { mEnabled.store(enabled, std::memory_order_relaxed); }
+
+    /**
+     * Is recording enabled?
+     * @return True if events are being recorded
+     */
+    bool IsEnabled() const { return mEnabled.load(std::memory_order_relaxed); }
+
+    long long Now() const;
+    void Complete(const char* name, const char* category, long long start);
+    void Instant(const char* name, const char* category);
+    void Clear();
+    bool Save(const wxString& filename);
+};
+
+/**
+ * Records a complete trace event covering the lifetime of this object
+ */
+class TraceScope
+{
+private:
+    /// Name of the event
+    const char* mName;
+
+    /// Category of the event
+    const char* mCategory;
+
+    /// Start time in microseconds, -1 when tracing was disabled at construction
+    long long mStart = -1;
+
+public:
+    /**
+     * Constructor
+     * @param name Name of the event, must be a string literal
+     * @param category Category of the event, must be a string literal
+     */
+    TraceScope(const char* name, const char* category) : mName(name), mCategory(category)
+    {
+        auto& recorder = TraceRecorder::Get();
+        if (recorder.IsEnabled())
+        {
+            mStart = recorder.Now();
+        }
+    }
+
+    /**
+     * Destructor, records the event
+     */
+    ~TraceScope()
+    {
+        if (mStart >= 0)
+        {
+            TraceRecorder::Get().Complete(mName, mCategory, mStart);
+        }
+    }
+
+    /// Copy constructor (disabled)
+    TraceScope(const TraceScope&) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const TraceScope&) = delete;
+};
+
+#endif //TRACERECORDER_H
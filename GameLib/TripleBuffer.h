@@ -0,0 +1,84 @@
+/**
+ * @file TripleBuffer.h
+ * @author Attulya Pratap Gupta
+ *
+ * Lock-free hand-off of the latest value from one thread to another
+ */
+
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+
+/**
+ * Passes the latest value from a writer thread to a reader thread
+ * without either one ever waiting.
+ *
+ * The writer fills its buffer and publishes it, swapping it with the
+ * spare buffer in the middle. The reader swaps its buffer with the
+ * middle one when something new has been published. Each thread only
+ * ever touches its own buffer, so a slow reader never holds up the
+ * writer and the reader always gets the newest complete value.
+ *
+ * @tparam T Type of the value passed
+ */
+template<class T>
+class TripleBuffer
+{
+private:
+    /// Bits of mMiddle that hold the index of the buffer
+    static const int IndexMask = 3;
+
+    /// Bit of mMiddle set when the middle buffer holds a value the reader has not seen
+    static const int FreshBit = 4;
+
+    /// The three buffers
+    T mBuffers[3];
+
+    /// Buffer only the writer uses
+    int mWrite = 0;
+
+    /// Buffer only the reader uses
+    int mRead = 1;
+
+    /// The spare buffer between them, with FreshBit set once it is published
+    std::atomic<int> mMiddle{2};
+
+public:
+    /**
+     * Get the buffer the writer fills, only ever called by the writer
+     * @return The writer's buffer
+     */
+    T& GetWriteBuffer() { return mBuffers[mWrite]; }
+
+    /**
+     * Publish the writer's buffer and take the spare one to fill next
+     */
+    void Publish()
+    {
+        mWrite = mMiddle.exchange(mWrite | FreshBit, std::memory_order_acq_rel) & IndexMask;
+    }
+
+    /**
+     * Take the newest published value if there is one, only ever called by the reader
+     * @return True if the read buffer now holds a value it did not hold before
+     */
+    bool Acquire()
+    {
+        if ((mMiddle.load(std::memory_order_relaxed) & FreshBit) == 0)
+        {
+            return false;
+        }
+
+        mRead = mMiddle.exchange(mRead, std::memory_order_acq_rel) & IndexMask;
+        return true;
+    }
+
+    /**
+     * Get the buffer the reader reads, valid until the next call to Acquire
+     * @return The reader's buffer
+     */
+    const T& GetReadBuffer() const { return mBuffers[mRead]; }
+};
+
+#endif //TRIPLEBUFFER_H
@@ -23,6 +23,9 @@ class GateAnd;
 class GateNot;
 class GateDFlipFlop;
 class GateSRFlipFlop;
+class GateMulti;
+class GateLut;
+class GateMacro;
 class Pin;
 
 /**
@@ -121,6 +124,24 @@ public:
 	 */
 	virtual void VisitGateDFlipFlop(GateDFlipFlop* gateDFlipFlop) {};
 
+	/**
+	 * Visit a multi-input and, or or xor gate object
+	 * @param gateMulti Multi-input gate we are visiting
+	 */
+	virtual void VisitGateMulti(GateMulti* gateMulti) {};
+
+	/**
+	 * Visit a lookup table gate object
+	 * @param gateLut Lookup table gate we are visiting
+	 */
+	virtual void VisitGateLut(GateLut* gateLut) {};
+
+	/**
+	 * Visit a macro gate object
+	 * @param gateMacro Macro gate we are visiting
+	 */
+	virtual void VisitGateMacro(GateMacro* gateMacro) {};
+
 	/**
 	 * Visit a pin object
 	 * @param pin The pin we are visiting
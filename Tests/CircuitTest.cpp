@@ -0,0 +1,475 @@
+/**
+ * @file CircuitTest.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <Game.h>
+#include <GateAnd.h>
+#include <GateNot.h>
+#include <GateSRFlipFlop.h>
+#include <GateMacro.h>
+#include <CompiledCircuit.h>
+#include <GateKernels.h>
+#include <ThreadPool.h>
+#include <CircuitCompiler.h>
+#include <MacroDefinition.h>
+#include <CircuitOptimizer.h>
+#include <KickPredictor.h>
+#include <Pin.h>
+
+using NodeTypes = CompiledCircuit::NodeTypes;
+
+TEST(CircuitTest, Evaluate)
+{
+	CompiledCircuit circuit;
+	int a = circuit.AddSignal();
+	int b = circuit.AddSignal();
+
+	int wire = circuit.AddSignal();
+	int output = circuit.AddSignal();
+
+	// Added out of order, Finalize puts the Not after the And
+	circuit.AddNode(NodeTypes::Not, {wire}, std::vector<int>{output});
+	int andNode = circuit.AddNode(NodeTypes::And, {a, b}, std::vector<int>{wire});
+	circuit.Finalize();
+	ASSERT_EQ(andNode, circuit.GetOrder()[0]);
+
+	// Unknown inputs give unknown outputs
+	circuit.Evaluate();
+	ASSERT_EQ(SignalUnknown, circuit.GetSignal(output));
+
+	circuit.SetSignal(a, SignalOne);
+	circuit.SetSignal(b, SignalOne);
+	circuit.Evaluate();
+	ASSERT_EQ(SignalZero, circuit.GetSignal(output));
+
+	circuit.SetSignal(b, SignalZero);
+	circuit.Evaluate();
+	ASSERT_EQ(SignalOne, circuit.GetSignal(output));
+}
+
+TEST(CircuitTest, Kernels)
+{
+	// Every kernel agrees with EvaluateCombinational on every mix of zero, one and unknown
+	const uint64_t table = 0x96e8c3a5f10b7d42;
+	for (auto type : {NodeTypes::And, NodeTypes::Or, NodeTypes::Xor, NodeTypes::Not, NodeTypes::Lut})
+	{
+		// A table only has rows for six inputs
+		int maxCount = type == NodeTypes::Lut ? 6 : GateKernels::MaxArity + 1;
+		for (int count = 1; count <= maxCount; count++)
+		{
+			auto kernel = GateKernels::Find(type, count);
+			ASSERT_NE(nullptr, kernel);
+
+			int combinations = 1;
+			for (int i = 0; i < count && combinations < 10000; i++)
+			{
+				combinations *= 3;
+			}
+
+			std::vector<unsigned char> values(count);
+			std::vector<int> inputs(count);
+			for (int i = 0; i < count; i++)
+			{
+				inputs[i] = i;
+			}
+
+			for (int c = 0; c < combinations; c++)
+			{
+				for (int i = 0, rest = c; i < count; i++, rest /= 3)
+				{
+					values[i] = (unsigned char)(rest % 3);
+				}
+
+				ASSERT_EQ(CompiledCircuit::EvaluateCombinational(type, values.data(), count, table),
+					kernel(values.data(), inputs.data(), count, table));
+			}
+		}
+	}
+
+	// Flip flops hold state, so they have no kernel
+	ASSERT_EQ(nullptr, GateKernels::Find(NodeTypes::DFlipFlop, 2));
+	ASSERT_EQ(nullptr, GateKernels::Find(NodeTypes::SRFlipFlop, 2));
+}
+
+TEST(CircuitTest, Buckets)
+{
+	CompiledCircuit circuit;
+	int a = circuit.AddSignal(SignalOne);
+	int b = circuit.AddSignal(SignalZero);
+
+	// Ands and Ors added alternately on the first level, Nots reading them on the second
+	std::vector<int> firsts;
+	for (int i = 0; i < 4; i++)
+	{
+		firsts.push_back(circuit.GetOutput(circuit.AddNode(i % 2 == 0 ? NodeTypes::And : NodeTypes::Or, {a, b})));
+	}
+
+	std::vector<int> nots;
+	for (auto first : firsts)
+	{
+		nots.push_back(circuit.GetOutput(circuit.AddNode(NodeTypes::Not, {first})));
+	}
+	circuit.Finalize();
+
+	// One bucket for the Ands, one for the Ors and one for the Nots
+	auto& buckets = circuit.GetBuckets();
+	ASSERT_EQ(3u, buckets.size());
+	ASSERT_EQ(0, buckets[0].mLevel);
+	ASSERT_EQ(2, buckets[0].mCount);
+	ASSERT_EQ(0, buckets[1].mLevel);
+	ASSERT_EQ(2, buckets[1].mCount);
+	ASSERT_EQ(1, buckets[2].mLevel);
+	ASSERT_EQ(4, buckets[2].mCount);
+
+	circuit.Evaluate();
+	for (int i = 0; i < 4; i++)
+	{
+		ASSERT_EQ(i % 2 == 0 ? SignalZero : SignalOne, circuit.GetSignal(firsts[i]));
+		ASSERT_EQ(i % 2 == 0 ? SignalOne : SignalZero, circuit.GetSignal(nots[i]));
+	}
+}
+
+TEST(CircuitTest, Loop)
+{
+	CompiledCircuit circuit;
+	int a = circuit.AddSignal(SignalOne);
+	int b = circuit.AddSignal(SignalOne);
+	int x = circuit.AddSignal();
+	int y = circuit.AddSignal(SignalZero);
+
+	// A Not added before the loop it reads, and a Not reading that
+	int notY = circuit.GetOutput(circuit.AddNode(NodeTypes::Not, {y}));
+	circuit.AddNode(NodeTypes::Or, {a, y}, std::vector<int>{x});
+	circuit.AddNode(NodeTypes::And, {x, b}, std::vector<int>{y});
+	int notNotY = circuit.GetOutput(circuit.AddNode(NodeTypes::Not, {notY}));
+
+	// A second loop driven by the first, and a Not after it
+	int held = circuit.AddSignal(SignalZero);
+	circuit.AddNode(NodeTypes::Or, {notNotY, held}, std::vector<int>{held});
+	int notHeld = circuit.GetOutput(circuit.AddNode(NodeTypes::Not, {held}));
+	circuit.Finalize();
+
+	// Each loop is one step, and what it drives is levelled after it
+	auto& buckets = circuit.GetBuckets();
+	ASSERT_EQ(5u, buckets.size());
+	ASSERT_EQ(-1, buckets[0].mLevel);
+	ASSERT_EQ(2, buckets[0].mCount);
+	ASSERT_EQ(1, buckets[1].mLevel);
+	ASSERT_EQ(2, buckets[2].mLevel);
+	ASSERT_EQ(-1, buckets[3].mLevel);
+	ASSERT_EQ(1, buckets[3].mCount);
+	ASSERT_EQ(4, buckets[4].mLevel);
+	ASSERT_EQ(5, circuit.GetLevelCount());
+
+	// So one evaluation reads the new values of the loops, not stale ones
+	circuit.Evaluate();
+	ASSERT_EQ(SignalOne, circuit.GetSignal(y));
+	ASSERT_EQ(SignalZero, circuit.GetSignal(notY));
+	ASSERT_EQ(SignalOne, circuit.GetSignal(notNotY));
+	ASSERT_EQ(SignalOne, circuit.GetSignal(held));
+	ASSERT_EQ(SignalZero, circuit.GetSignal(notHeld));
+}
+
+TEST(CircuitTest, Parallel)
+{
+	// Wide levels of gates, evaluated once on this thread and once on the pool
+	auto build = [](CompiledCircuit& circuit) {
+		std::vector<int> signals;
+		for (int i = 0; i < 16; i++)
+		{
+			signals.push_back(circuit.AddSignal(i % 3 == 0 ? SignalZero : SignalOne));
+		}
+
+		for (int level = 0; level < 3; level++)
+		{
+			std::vector<int> next;
+			for (int g = 0; g < CompiledCircuit::ParallelChunk * 3; g++)
+			{
+				int a = signals[g % signals.size()];
+				int b = signals[(g * 7 + 3) % signals.size()];
+				auto inputs = g % 4 == 3 ? std::vector<int>{a} : std::vector<int>{a, b};
+				next.push_back(circuit.GetOutput(circuit.AddNode(NodeTypes(g % 4), inputs)));
+			}
+			signals = next;
+		}
+		circuit.Finalize();
+	};
+
+	CompiledCircuit serial;
+	build(serial);
+	CompiledCircuit parallel;
+	build(parallel);
+	parallel.SetParallelThreshold(0);
+	ASSERT_EQ(3, parallel.GetLevelCount());
+
+	serial.Evaluate();
+	parallel.Evaluate();
+	for (int s = 0; s < serial.GetSignalCount(); s++)
+	{
+		ASSERT_EQ(serial.GetSignal(s), parallel.GetSignal(s));
+	}
+
+	// Every iteration of a loop runs exactly once
+	ThreadPool pool(3);
+	std::vector<int> counts(10000, 0);
+	pool.ParallelFor(int(counts.size()), 100, [&counts](int begin, int end) {
+		for (int i = begin; i < end; i++)
+		{
+			counts[i]++;
+		}
+	});
+	ASSERT_EQ(std::vector<int>(10000, 1), counts);
+}
+
+TEST(CircuitTest, DFlipFlop)
+{
+	CompiledCircuit circuit;
+	int d = circuit.AddSignal(SignalOne);
+	int clock = circuit.AddSignal(SignalZero);
+	int flipFlop = circuit.AddNode(NodeTypes::DFlipFlop, {d, clock});
+	circuit.Finalize();
+
+	circuit.Evaluate();
+	ASSERT_EQ(SignalUnknown, circuit.GetSignal(circuit.GetOutput(flipFlop)));
+
+	// Latches on the rising edge only
+	circuit.SetSignal(clock, SignalOne);
+	circuit.Evaluate();
+	ASSERT_EQ(SignalOne, circuit.GetSignal(circuit.GetOutput(flipFlop)));
+	ASSERT_EQ(SignalZero, circuit.GetSignal(circuit.GetOutput(flipFlop, 1)));
+
+	circuit.SetSignal(d, SignalZero);
+	circuit.Evaluate();
+	ASSERT_EQ(SignalOne, circuit.GetSignal(circuit.GetOutput(flipFlop)));
+}
+
+TEST(CircuitTest, Macro)
+{
+	Game game;
+
+	// A NAND gate made from an AND and a NOT
+	auto gateAnd = std::make_shared<GateAnd>(&game);
+	auto gateNot = std::make_shared<GateNot>(&game);
+	auto andOutput = gateAnd->GetOutputPins().first;
+	auto notInput = gateNot->GetInputPins()[0];
+	andOutput->Connect(notInput.get(), wxPoint(int(notInput->GetX()), int(notInput->GetY())));
+
+	auto definition = MacroDefinition::Create(L"NAND", {gateAnd, gateNot});
+	ASSERT_EQ(2, definition->GetInputCount());
+	ASSERT_EQ(1, definition->GetOutputCount());
+	ASSERT_EQ(2, definition->GetNodeCount());
+
+	auto macro = std::make_shared<GateMacro>(&game, definition);
+	auto inputs = macro->GetInputPins();
+	auto output = macro->GetOutputPins().first;
+	ASSERT_EQ(2, int(inputs.size()));
+	ASSERT_EQ(nullptr, macro->GetOutputPins().second);
+
+	inputs[0]->SetOne();
+	inputs[1]->SetOne();
+	macro->UpdateOutputPin();
+	ASSERT_TRUE(output->IsZero());
+
+	inputs[1]->SetZero();
+	macro->UpdateOutputPin();
+	ASSERT_TRUE(output->IsOne());
+
+	// Inputs left off the list are unknown
+	CompiledCircuit shortInputs;
+	int one = shortInputs.AddSignal(SignalOne);
+	int nand = shortInputs.AddSignal(SignalZero);
+	definition->Instantiate(&shortInputs, {one}, {nand});
+	shortInputs.Finalize();
+	shortInputs.Evaluate();
+	ASSERT_EQ(2, shortInputs.GetNodeCount());
+	ASSERT_EQ(SignalUnknown, shortInputs.GetSignal(nand));
+
+	// Macros made from macros flatten all the way down
+	auto nested = MacroDefinition::Create(L"NAND2", {macro});
+	ASSERT_EQ(2, nested->GetNodeCount());
+
+	// The compiled game holds the macro's gates, not the macro
+	game.AddItem(macro);
+	auto circuit = CircuitCompiler::Compile(&game);
+	ASSERT_EQ(2, circuit->GetNodeCount());
+}
+
+TEST(CircuitTest, CompileState)
+{
+	Game game;
+
+	// The compiled flip flop and one updated the way the game does, fed the same inputs
+	auto compiled = std::make_shared<GateSRFlipFlop>(&game);
+	auto reference = std::make_shared<GateSRFlipFlop>(&game);
+	game.AddItem(compiled);
+
+	Pin sourceS(0, 0, false, nullptr);
+	Pin sourceR(0, 0, false, nullptr);
+	auto inputs = compiled->GetInputPins();
+	sourceS.Connect(inputs[0].get(), wxPoint(int(inputs[0]->GetX()), int(inputs[0]->GetY())));
+	sourceR.Connect(inputs[1].get(), wxPoint(int(inputs[1]->GetX()), int(inputs[1]->GetY())));
+
+	auto circuit = CircuitCompiler::Compile(&game);
+	auto referenceInputs = reference->GetInputPins();
+	auto outputs = compiled->GetOutputPins();
+	auto referenceOutputs = reference->GetOutputPins();
+
+	// Holding from the first tick keeps the state the gate starts with
+	std::vector<std::pair<unsigned char, unsigned char>> ticks = {
+		{SignalZero, SignalZero}, {SignalZero, SignalOne}, {SignalZero, SignalZero},
+		{SignalOne, SignalZero}, {SignalZero, SignalZero}, {SignalOne, SignalOne}};
+	for (auto& tick : ticks)
+	{
+		CompiledCircuit::WritePin(&sourceS, tick.first);
+		CompiledCircuit::WritePin(&sourceR, tick.second);
+		circuit->Run();
+
+		CompiledCircuit::WritePin(referenceInputs[0].get(), tick.first);
+		CompiledCircuit::WritePin(referenceInputs[1].get(), tick.second);
+		reference->UpdateOutputPin();
+
+		ASSERT_EQ(CompiledCircuit::ReadPin(referenceOutputs.first.get()), CompiledCircuit::ReadPin(outputs.first.get()));
+		ASSERT_EQ(CompiledCircuit::ReadPin(referenceOutputs.second.get()), CompiledCircuit::ReadPin(outputs.second.get()));
+	}
+
+	// A circuit compiled mid-run carries on from the state the gate holds
+	CompiledCircuit::WritePin(&sourceS, SignalOne);
+	CompiledCircuit::WritePin(&sourceR, SignalZero);
+	circuit->Run();
+	CompiledCircuit::WritePin(&sourceS, SignalZero);
+	auto recompiled = CircuitCompiler::Compile(&game);
+	recompiled->Run();
+	ASSERT_TRUE(outputs.first->IsOne());
+	ASSERT_TRUE(outputs.second->IsZero());
+}
+
+TEST(CircuitTest, Optimize)
+{
+	Pin pinA(0, 0, false, nullptr);
+	Pin pinB(0, 0, false, nullptr);
+
+	CompiledCircuit circuit;
+	int a = circuit.AddSignal();
+	int b = circuit.AddSignal();
+	int unknown = circuit.AddSignal();
+	circuit.BindSource(a, &pinA);
+	circuit.BindSource(b, &pinB);
+
+	// A double NOT, two identical ANDs and an OR of the same signal twice
+	int doubleNot = circuit.GetOutput(circuit.AddNode(NodeTypes::Not,
+		{circuit.GetOutput(circuit.AddNode(NodeTypes::Not, {a}))}));
+	int and1 = circuit.GetOutput(circuit.AddNode(NodeTypes::And, {a, b}));
+	int and2 = circuit.GetOutput(circuit.AddNode(NodeTypes::And, {b, a}));
+	int orSame = circuit.GetOutput(circuit.AddNode(NodeTypes::Or, {and1, and2}));
+	int root = circuit.GetOutput(circuit.AddNode(NodeTypes::And, {doubleNot, orSame}));
+
+	// Stuck unknown, and a gate that goes nowhere. The first NOT also goes nowhere once bypassed
+	circuit.AddNode(NodeTypes::Or, {a, unknown});
+	circuit.AddNode(NodeTypes::Xor, {a, b});
+
+	circuit.AddRoot(root);
+	circuit.Finalize();
+
+	CircuitOptimizer optimizer;
+	auto optimized = optimizer.Optimize(circuit);
+	ASSERT_EQ(2, optimized->GetNodeCount());
+	ASSERT_EQ(1, optimizer.GetFoldedCount());
+	ASSERT_EQ(1, optimizer.GetMergedCount());
+	ASSERT_EQ(2, optimizer.GetBypassedCount());
+	ASSERT_EQ(2, optimizer.GetDeadCount());
+
+	// Both circuits compute the same root for every input
+	unsigned char values[] = {SignalZero, SignalOne, SignalUnknown};
+	for (auto valueA : values)
+	{
+		for (auto valueB : values)
+		{
+			CompiledCircuit::WritePin(&pinA, valueA);
+			CompiledCircuit::WritePin(&pinB, valueB);
+			circuit.Run();
+			optimized->Run();
+			ASSERT_EQ(circuit.GetSignal(root), optimized->GetSignal(optimized->GetRoots()[0]));
+		}
+	}
+}
+
+TEST(CircuitTest, Predict)
+{
+	const int Red = 1;
+	const int Blue = 3;
+	const unsigned int RedProduct = 1u << Red;
+	const unsigned int BlueProduct = 1u << Blue;
+
+	// Kick every red product as it reaches the beam
+	auto circuit = std::make_unique<CompiledCircuit>();
+	int beam = circuit->AddSignal();
+	int red = circuit->AddSignal();
+	int kick = circuit->GetOutput(circuit->AddNode(NodeTypes::And, {beam, red}));
+	circuit->Finalize();
+
+	KickPredictor predictor(std::move(circuit), kick);
+	predictor.SetBeamSignal(beam);
+	predictor.AddPropertySignal(red, Red);
+	ASSERT_FALSE(predictor.IsStateful());
+
+	// More products than fit in one word
+	std::vector<unsigned int> products;
+	for (int p = 0; p < 100; p++)
+	{
+		products.push_back(p % 3 == 0 ? RedProduct : BlueProduct);
+	}
+	auto& kicked = predictor.Predict(products);
+	for (int p = 0; p < 100; p++)
+	{
+		ASSERT_EQ(p % 3 == 0, kicked[p]);
+	}
+
+	// A flip flop clocked by the beam only kicks when the colour changes to red
+	auto stateful = std::make_unique<CompiledCircuit>();
+	beam = stateful->AddSignal();
+	red = stateful->AddSignal();
+	int flipFlop = stateful->AddNode(NodeTypes::DFlipFlop, {red, beam});
+	int q = stateful->GetOutput(flipFlop);
+	stateful->Finalize();
+
+	KickPredictor sequential(std::move(stateful), q);
+	sequential.SetBeamSignal(beam);
+	sequential.AddPropertySignal(red, Red);
+	ASSERT_TRUE(sequential.IsStateful());
+
+	auto& latched = sequential.Predict({RedProduct, RedProduct, BlueProduct, RedProduct});
+	ASSERT_EQ(std::vector<bool>({true, false, false, true}), latched);
+
+	// Sparty on Q' of an SR flip flop set by red and reset by blue only kicks
+	// a blue product after a red one. Q' starts high, so the first blue is no edge
+	Game game;
+	auto srFlipFlop = std::make_shared<GateSRFlipFlop>(&game);
+	game.AddItem(srFlipFlop);
+
+	Pin redSensor(0, 0, false, nullptr);
+	Pin blueSensor(0, 0, false, nullptr);
+	auto srInputs = srFlipFlop->GetInputPins();
+	redSensor.Connect(srInputs[0].get(), wxPoint(int(srInputs[0]->GetX()), int(srInputs[0]->GetY())));
+	blueSensor.Connect(srInputs[1].get(), wxPoint(int(srInputs[1]->GetX()), int(srInputs[1]->GetY())));
+
+	auto compiled = CircuitCompiler::Compile(&game);
+	int qNot = -1;
+	for (auto& sink : compiled->GetSinks())
+	{
+		qNot = sink.second == srFlipFlop->GetOutputPins().second.get() ? sink.first : qNot;
+	}
+	ASSERT_GE(qNot, 0);
+	auto sources = compiled->GetSources();
+
+	KickPredictor flipFlopPredictor(std::move(compiled), qNot);
+	for (auto& source : sources)
+	{
+		flipFlopPredictor.AddPropertySignal(source.first, source.second == &redSensor ? Red : Blue);
+	}
+
+	auto& reset = flipFlopPredictor.Predict({BlueProduct, RedProduct, BlueProduct, BlueProduct});
+	ASSERT_EQ(std::vector<bool>({false, false, true, false}), reset);
+}
@@ -0,0 +1,170 @@
+/**
+ * @file GameSnapshotTest.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <Game.h>
+#include <GameSnapshot.h>
+#include <Product.h>
+#include <VisitorBase.h>
+
+/// Time for one tick in seconds, also the interval between snapshots
+const double SnapshotTickTime = 0.25;
+
+/**
+ * Visitor that collects where the products are
+ */
+class ProductPositions : public VisitorBase
+{
+public:
+    std::vector<double> mPositions; ///< Y location of each product visited
+
+    /**
+     * Record where a product is
+     * @param product The product
+     */
+    void VisitProduct(Product* product) override { mPositions.push_back(product->GetY()); }
+};
+
+/**
+ * Get where the products of a game are
+ * @param game The game
+ * @return Y location of each product in play
+ */
+static std::vector<double> GetPositions(Game& game)
+{
+    ProductPositions positions;
+    game.Accept(&positions);
+    return positions.mPositions;
+}
+
+/**
+ * Load level 1 and start its conveyor
+ * @param game Game to start
+ */
+static void StartLevel(Game& game)
+{
+    game.LoadLevel(1);
+
+    // The start button of the level 1 conveyor panel
+    game.OnLeftDown(270, 50);
+}
+
+TEST(GameSnapshotTest, CaptureRestore)
+{
+    Game game;
+    StartLevel(game);
+    game.Update(SnapshotTickTime);
+
+    GameSnapshot snapshot;
+    snapshot.Capture(&game, 1.5);
+    ASSERT_DOUBLE_EQ(1.5, snapshot.GetTime());
+    ASSERT_GT(snapshot.GetSize(), 0u);
+
+    auto positions = GetPositions(game);
+    auto score = game.GetGameScore();
+    auto levelTime = game.GetLevel()->GetLevelTime();
+
+    for (int i = 0; i < 4; i++)
+    {
+        game.Update(SnapshotTickTime);
+    }
+    ASSERT_NE(positions, GetPositions(game));
+    game.SetGameScore(score + 100);
+
+    ASSERT_TRUE(snapshot.Restore(&game));
+    ASSERT_EQ(positions, GetPositions(game));
+    ASSERT_EQ(score, game.GetGameScore());
+    ASSERT_DOUBLE_EQ(levelTime, game.GetLevel()->GetLevelTime());
+
+    // Restoring again gives the same state
+    game.Update(SnapshotTickTime);
+    ASSERT_TRUE(snapshot.Restore(&game));
+    ASSERT_EQ(positions, GetPositions(game));
+}
+
+TEST(GameSnapshotTest, Conveyor)
+{
+    // Captured before the conveyor started
+    Game game;
+    game.LoadLevel(1);
+    GameSnapshot stopped;
+    stopped.Capture(&game);
+    auto positions = GetPositions(game);
+
+    game.OnLeftDown(270, 50);
+    game.Update(SnapshotTickTime);
+    ASSERT_NE(positions, GetPositions(game));
+
+    // The belt is stopped again, so the products stay where they are
+    ASSERT_TRUE(stopped.Restore(&game));
+    ASSERT_EQ(positions, GetPositions(game));
+    game.Update(SnapshotTickTime);
+    ASSERT_EQ(positions, GetPositions(game));
+}
+
+TEST(GameSnapshotTest, Rewind)
+{
+    Game game;
+    StartLevel(game);
+
+    GameHistory history(SnapshotTickTime, 10);
+    std::vector<std::vector<double>> positions;
+    for (int i = 0; i < 20; i++)
+    {
+        game.Update(SnapshotTickTime);
+        history.Update(&game, SnapshotTickTime);
+        positions.push_back(GetPositions(game));
+    }
+    ASSERT_EQ(20u, history.GetCount());
+    ASSERT_DOUBLE_EQ(5.0, history.GetTime());
+
+    // The newest snapshot at least a second old is the one four ticks back
+    ASSERT_TRUE(history.Rewind(&game, 1.0));
+    ASSERT_DOUBLE_EQ(4.0, history.GetTime());
+    ASSERT_EQ(16u, history.GetCount());
+    ASSERT_EQ(positions[15], GetPositions(game));
+
+    // Part of a tick rounds back to the snapshot before it
+    ASSERT_TRUE(history.Rewind(&game, 0.1));
+    ASSERT_DOUBLE_EQ(3.75, history.GetTime());
+    ASSERT_EQ(positions[14], GetPositions(game));
+
+    // Further back than the history goes stops at the oldest snapshot
+    ASSERT_TRUE(history.Rewind(&game, 100));
+    ASSERT_EQ(1u, history.GetCount());
+    ASSERT_EQ(positions[0], GetPositions(game));
+
+    history.Clear();
+    ASSERT_EQ(0u, history.GetCount());
+    ASSERT_FALSE(history.Rewind(&game, 1.0));
+}
+
+TEST(GameSnapshotTest, ReuseBuffers)
+{
+    Game game;
+    StartLevel(game);
+
+    // A one second span holds five snapshots a quarter second apart
+    GameHistory history(SnapshotTickTime, 1.0);
+    for (int i = 0; i < 40; i++)
+    {
+        game.Update(SnapshotTickTime);
+        history.Update(&game, SnapshotTickTime);
+    }
+    ASSERT_EQ(5u, history.GetCount());
+    ASSERT_EQ(5u, history.GetAllocatedCount());
+
+    // Snapshots dropped by a rewind are captured into again
+    ASSERT_TRUE(history.Rewind(&game, 0.5));
+    ASSERT_EQ(3u, history.GetCount());
+    for (int i = 0; i < 10; i++)
+    {
+        game.Update(SnapshotTickTime);
+        history.Update(&game, SnapshotTickTime);
+    }
+    ASSERT_EQ(5u, history.GetCount());
+    ASSERT_EQ(5u, history.GetAllocatedCount());
+}
@@ -6,10 +6,190 @@
 #include <pch.h>
 #include "gtest/gtest.h"
 #include <Game.h>
+#include <GateAnd.h>
+#include <VisitorBase.h>
+#include <GameSnapshot.h>
+#include <Product.h>
+#include <Level.h>
+#include <algorithm>
 
 
 using namespace std;
 
 TEST(GameTest, Construct) {
     Game game;
-}
\ No newline at end of file
+}
+
+/**
+ * Visitor that counts the AND gates it visits
+ */
+class AndCounter : public VisitorBase {
+public:
+    int mCount = 0; ///< Number of AND gates visited
+
+    /**
+     * Count an AND gate
+     * @param gate The gate
+     */
+    void VisitGateAnd(GateAnd* gate) override { mCount++; }
+};
+
+TEST(GameTest, ParkItems) {
+    Game game;
+    std::vector<std::shared_ptr<GateAnd>> gates;
+    for (int i = 0; i < 4; i++)
+    {
+        gates.push_back(make_shared<GateAnd>(&game));
+        game.AddItem(gates.back());
+    }
+
+    // Nothing moves until the parking is applied
+    game.ParkItem(gates[1].get());
+    game.ParkItem(gates[2].get());
+    AndCounter before;
+    game.Accept(&before);
+    ASSERT_EQ(before.mCount, 4);
+
+    game.ApplyParking();
+    AndCounter active;
+    game.Accept(&active);
+    ASSERT_EQ(active.mCount, 2);
+    ASSERT_EQ(game.GetParkedCount(), 2u);
+
+    AndCounter parked;
+    game.AcceptParked(&parked);
+    ASSERT_EQ(parked.mCount, 2);
+
+    // A single item comes back, then everything else
+    game.UnparkItem(gates[2].get());
+    game.ApplyParking();
+    ASSERT_EQ(game.GetParkedCount(), 1u);
+
+    game.UnparkItems();
+    game.ApplyParking();
+    AndCounter all;
+    game.Accept(&all);
+    ASSERT_EQ(all.mCount, 4);
+    ASSERT_EQ(game.GetParkedCount(), 0u);
+}
+
+/**
+ * Visitor that collects the AND gates in visiting order
+ */
+class AndCollector : public VisitorBase {
+public:
+    std::vector<GateAnd*> mGates; ///< Gates visited
+
+    /**
+     * Record an AND gate
+     * @param gate The gate
+     */
+    void VisitGateAnd(GateAnd* gate) override { mGates.push_back(gate); }
+};
+
+TEST(GameTest, UnparkOrder) {
+    Game game;
+    std::vector<GateAnd*> order;
+    std::vector<std::shared_ptr<GateAnd>> gates;
+    for (int i = 0; i < 6; i++)
+    {
+        gates.push_back(std::make_shared<GateAnd>(&game));
+        game.AddItem(gates.back());
+        order.push_back(gates.back().get());
+    }
+
+    // D is taken from index 3, then F from index 4 of what is left
+    game.ParkItem(gates[3].get());
+    game.ApplyParking();
+    game.ParkItem(gates[5].get());
+    game.ApplyParking();
+
+    // Parked together, B's index counts the gates parked before it in the same batch
+    game.ParkItem(gates[0].get());
+    game.ParkItem(gates[1].get());
+    game.ApplyParking();
+    ASSERT_EQ(game.GetParkedCount(), 4u);
+
+    game.UnparkItems();
+    game.ApplyParking();
+    AndCollector all;
+    game.Accept(&all);
+    ASSERT_EQ(all.mGates, order);
+}
+
+/**
+ * Visitor that collects the products it visits
+ */
+class ProductCollector : public VisitorBase {
+public:
+    std::vector<Product*> mProducts; ///< Products visited
+
+    /**
+     * Collect a product
+     * @param product The product
+     */
+    void VisitProduct(Product* product) override { mProducts.push_back(product); }
+};
+
+TEST(GameTest, SnapshotParkedItems) {
+    Game game;
+    game.LoadLevel(1);
+
+    ProductCollector products;
+    game.Accept(&products);
+    ASSERT_FALSE(products.mProducts.empty());
+    auto product = products.mProducts[0];
+
+    // Parked after the capture, so restoring puts it back in play
+    GameSnapshot inPlay;
+    inPlay.Capture(&game);
+    game.ParkItem(product);
+    game.ApplyParking();
+    ASSERT_TRUE(game.IsParked(product));
+
+    GameSnapshot parked;
+    parked.Capture(&game);
+
+    ASSERT_TRUE(inPlay.Restore(&game));
+    ASSERT_FALSE(game.IsParked(product));
+    ASSERT_EQ(game.GetParkedCount(), 0u);
+
+    ProductCollector restored;
+    game.Accept(&restored);
+    ASSERT_EQ(restored.mProducts, products.mProducts);
+
+    // Parked when captured, so restoring takes it out of play again
+    ASSERT_TRUE(parked.Restore(&game));
+    ASSERT_TRUE(game.IsParked(product));
+    ASSERT_EQ(game.GetParkedCount(), 1u);
+}
+
+TEST(GameTest, LastProductReached) {
+    Game game;
+    game.LoadLevel(1);
+    auto level = game.GetLevel();
+
+    ProductCollector products;
+    game.Accept(&products);
+    int count = int(products.mProducts.size());
+    ASSERT_EQ(level->GetProductsRemaining(), count);
+    ASSERT_FALSE(level->IsLastProductReached());
+
+    // Start the conveyor and run it until every product is past the beam
+    game.OnLeftDown(270, 50);
+    for (int i = 0; i < 2000 && !level->IsLastProductReached(); i++)
+    {
+        game.Update(0.01);
+
+        int passed = int(std::count_if(products.mProducts.begin(), products.mProducts.end(),
+                                       [](Product* product) { return product->GetPassedBeam(); }));
+        ASSERT_EQ(level->GetProductsRemaining(), count - passed);
+        ASSERT_EQ(level->IsLastProductReached(), passed == count);
+    }
+    ASSERT_TRUE(level->IsLastProductReached());
+
+    // Restarting the conveyor puts every product back
+    game.OnLeftDown(270, 50);
+    ASSERT_EQ(level->GetProductsRemaining(), count);
+    ASSERT_FALSE(level->IsLastProductReached());
+}
@@ -7,6 +7,11 @@
 #include "gtest/gtest.h"
 #include <Game.h>
 #include <Gate.h>
+#include <GateMulti.h>
+#include <GateLut.h>
+#include <ItemFactory.h>
+#include <GateAnd.h>
+#include <GateDrag.h>
 
 class GateMock : public Gate {
 public:
@@ -54,4 +59,147 @@ TEST(GateTest, HitTest)
 	ASSERT_FALSE(gate.HitTest(249,250));
 	ASSERT_FALSE(gate.HitTest(300,351));
 	ASSERT_FALSE(gate.HitTest(300,249));
-}
\ No newline at end of file
+}
+/**
+ * Set the input pins of a gate from the bits of a value
+ * @param gate Gate to set the inputs of
+ * @param inputs Input states, input i in bit i
+ */
+static void SetInputs(Gate& gate, unsigned int inputs)
+{
+	auto pins = gate.GetInputPins();
+	for (size_t i = 0; i < pins.size(); i++)
+	{
+		if (inputs & (1u << i))
+		{
+			pins[i]->SetOne();
+		}
+		else
+		{
+			pins[i]->SetZero();
+		}
+	}
+	gate.UpdateOutputPin();
+}
+
+TEST(GateTest, MultiInput)
+{
+	Game game;
+	GateMulti gateAnd(&game, GateMulti::Operations::And, 6);
+	GateMulti gateOr(&game, GateMulti::Operations::Or, 6);
+	GateMulti gateXor(&game, GateMulti::Operations::Xor, 6);
+	ASSERT_EQ(6, int(gateAnd.GetInputPins().size()));
+
+	// Unknown inputs give an unknown output
+	gateAnd.UpdateOutputPin();
+	ASSERT_TRUE(gateAnd.GetOutputPins().first->IsUnknown());
+
+	for (unsigned int inputs = 0; inputs < 64; inputs++)
+	{
+		SetInputs(gateAnd, inputs);
+		SetInputs(gateOr, inputs);
+		SetInputs(gateXor, inputs);
+
+		int ones = 0;
+		for (int i = 0; i < 6; i++)
+		{
+			ones += (inputs >> i) & 1;
+		}
+
+		ASSERT_EQ(ones == 6, gateAnd.GetOutputPins().first->IsOne());
+		ASSERT_EQ(ones > 0, gateOr.GetOutputPins().first->IsOne());
+		ASSERT_EQ(ones % 2 == 1, gateXor.GetOutputPins().first->IsOne());
+	}
+}
+
+TEST(GateTest, LookupTable)
+{
+	Game game;
+
+	// Three input majority
+	GateLut gate(&game, 3, 0xe8);
+	for (unsigned int inputs = 0; inputs < 8; inputs++)
+	{
+		SetInputs(gate, inputs);
+		bool majority = ((inputs & 1) + ((inputs >> 1) & 1) + ((inputs >> 2) & 1)) >= 2;
+		ASSERT_EQ(majority, gate.GetOutputPins().first->IsOne());
+	}
+
+	// Bits past the last combination of inputs are dropped
+	gate.SetTable(0xffe8);
+	ASSERT_EQ(0xe8u, gate.GetTable());
+
+	// Gates are created from the names used in level files
+	ASSERT_NE(nullptr, std::dynamic_pointer_cast<GateMulti>(ItemFactory::CreateGate(L"xor-3", &game)));
+	ASSERT_NE(nullptr, std::dynamic_pointer_cast<GateLut>(ItemFactory::CreateGate(L"lut-6", &game)));
+	ASSERT_EQ(nullptr, ItemFactory::CreateGate(L"lut-7", &game));
+}
+
+TEST(GateTest, Drag)
+{
+	Game game;
+	GateAnd gate(&game);
+	gate.SetLocation(300, 300);
+	gate.UpdatePinPositions();
+	auto before = GateDrag::GetBounds(&gate);
+	auto pin = gate.GetOutputPins().first;
+	double pinX = pin->GetX();
+
+	// Motion only records where the gate goes
+	GateDrag drag;
+	drag.Begin(&gate);
+	drag.Move(310, 300);
+	drag.Move(350, 320);
+	drag.Move(400, 340);
+	ASSERT_NEAR(300, gate.GetX(), 1);
+	ASSERT_EQ(pinX, pin->GetX());
+
+	// One flush moves the gate and its pins to the last place
+	ASSERT_TRUE(drag.Flush());
+	ASSERT_NEAR(400, gate.GetX(), 1);
+	ASSERT_EQ(340, gate.GetY());
+	ASSERT_DOUBLE_EQ(pinX + 100, pin->GetX());
+	ASSERT_EQ(3, drag.GetMoveCount());
+	ASSERT_EQ(1, drag.GetFlushCount());
+
+	// The dirty area covers where the gate was and where it is
+	auto after = GateDrag::GetBounds(&gate);
+	ASSERT_TRUE(drag.GetDirty().Contains(before));
+	ASSERT_TRUE(drag.GetDirty().Contains(after));
+	ASSERT_FALSE(drag.GetDirty().Contains(wxPoint2DDouble(1000, 700)));
+
+	// Nothing to do until the mouse moves again
+	ASSERT_FALSE(drag.Flush());
+	ASSERT_EQ(0, drag.GetDirty().m_width);
+
+	drag.Move(200, 200);
+	drag.End();
+	ASSERT_FALSE(drag.IsDragging());
+	ASSERT_NEAR(200, gate.GetX(), 1);
+}
+
+TEST(GateTest, Geometry)
+{
+	Game game;
+	GateAnd gate(&game);
+	gate.SetLocation(300, 300);
+	gate.UpdateGeometry();
+	ASSERT_FALSE(gate.IsGeometryDirty());
+	auto pin = gate.GetOutputPins().first;
+	double pinX = pin->GetX();
+
+	// Moving only marks the pins, they follow on the next geometry update
+	gate.SetLocation(400, 300);
+	ASSERT_TRUE(gate.IsGeometryDirty());
+	ASSERT_EQ(pinX, pin->GetX());
+
+	gate.UpdateGeometry();
+	ASSERT_FALSE(gate.IsGeometryDirty());
+	ASSERT_DOUBLE_EQ(pinX + 100, pin->GetX());
+
+	// Resizing keeps the top left where it is, so the center moves
+	double x = gate.GetX();
+	gate.SetSize(wxSize(100, 50));
+	ASSERT_DOUBLE_EQ(x + 12.5, gate.GetX());
+	ASSERT_TRUE(gate.IsGeometryDirty());
+}
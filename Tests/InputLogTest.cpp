@@ -0,0 +1,183 @@
+/**
+ * @file InputLogTest.cpp
+ * @author Navanidhiy Achuthan Kumaraguru
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <Game.h>
+#include <InputLog.h>
+#include <GateNot.h>
+#include <Pin.h>
+#include <VisitorBase.h>
+
+/// Time for one tick at 60 frames per second
+const double TestTickTime = 1.0 / 60.0;
+
+/**
+ * Record a short session that starts the conveyor on level 1
+ * @param log Log to record into
+ */
+static void RecordSession(InputLog& log)
+{
+    log.Start();
+    log.Record(InputEvent::SelectLevel(1));
+    log.Record(InputEvent::Tick(TestTickTime));
+    // The start button of the level 1 conveyor panel
+    log.Record(InputEvent::LeftDown(270, 50));
+    log.Record(InputEvent::AddGate(L"not", 600, 300));
+    log.Record(InputEvent::MouseMove(-5, 2000, true));
+    log.Record(InputEvent::Connect(640, 300, wxPoint(1100, 400)));
+    for (int i = 0; i < 600; i++)
+    {
+        log.Record(InputEvent::Tick(TestTickTime));
+    }
+    log.Stop();
+}
+
+/**
+ * Visitor that describes where the NOT gates are and what they are wired to
+ */
+class GateDescriber : public VisitorBase
+{
+public:
+    wxString mDescription; ///< One line for each gate
+
+    /**
+     * Describe a NOT gate
+     * @param gate The gate
+     */
+    void VisitGateNot(GateNot* gate) override
+    {
+        mDescription += wxString::Format(L"not %g,%g in", gate->GetX(), gate->GetY());
+        for (auto& input : gate->GetInputPins())
+        {
+            auto connected = input->GetConnected();
+            mDescription += connected == nullptr ? wxString(L" -") :
+                            wxString::Format(L" %g,%g", connected->GetX(), connected->GetY());
+        }
+
+        mDescription += L" out";
+        auto outputs = gate->GetOutputPins();
+        for (auto& output : {outputs.first, outputs.second})
+        {
+            if (output == nullptr)
+            {
+                continue;
+            }
+
+            for (auto pin : output->GetPins())
+            {
+                mDescription += wxString::Format(L" %g,%g", pin->GetX(), pin->GetY());
+            }
+        }
+        mDescription += L"\n";
+    }
+};
+
+/**
+ * Describe the gates of a game and their wires
+ * @param game The game
+ * @return One line for each gate
+ */
+static wxString DescribeGates(Game& game)
+{
+    GateDescriber describer;
+    game.Accept(&describer);
+    return describer.mDescription;
+}
+
+TEST(InputLogTest, EncodeDecode)
+{
+    InputLog log;
+    RecordSession(log);
+
+    InputLog decoded;
+    ASSERT_TRUE(decoded.Decode(log.Encode()));
+    ASSERT_EQ(decoded.GetEvents().size(), log.GetEvents().size());
+
+    for (size_t i = 0; i < log.GetEvents().size(); i++)
+    {
+        auto& expected = log.GetEvents()[i];
+        auto& actual = decoded.GetEvents()[i];
+        ASSERT_EQ(expected.GetType(), actual.GetType());
+        ASSERT_EQ(expected.GetTick(), actual.GetTick());
+        ASSERT_EQ(expected.GetX(), actual.GetX());
+        ASSERT_EQ(expected.GetY(), actual.GetY());
+        ASSERT_EQ(expected.GetLineEnd(), actual.GetLineEnd());
+        ASSERT_EQ(expected.GetValue(), actual.GetValue());
+        ASSERT_EQ(expected.GetElapsed(), actual.GetElapsed());
+    }
+
+    // Ticks are counted, so the last event is on the last tick
+    ASSERT_EQ(log.GetEvents().back().GetTick(), 600u);
+
+    // Decoding counts the ticks, not the tick the last event was stamped with
+    ASSERT_EQ(log.GetTickCount(), 601u);
+    ASSERT_EQ(decoded.GetTickCount(), log.GetTickCount());
+}
+
+TEST(InputLogTest, RejectsBadData)
+{
+    InputLog log;
+    RecordSession(log);
+    auto data = log.Encode();
+
+    InputLog decoded;
+    data.resize(data.size() - 3);
+    ASSERT_FALSE(decoded.Decode(data));
+    ASSERT_TRUE(decoded.GetEvents().empty());
+
+    data[0] = 'X';
+    ASSERT_FALSE(decoded.Decode(data));
+}
+
+TEST(InputLogTest, NotRecording)
+{
+    InputLog log;
+    log.Record(InputEvent::LeftDown(1, 2));
+    ASSERT_TRUE(log.GetEvents().empty());
+}
+
+TEST(InputLogTest, ReplayIsDeterministic)
+{
+    InputLog log;
+    RecordSession(log);
+
+    Game first;
+    log.Replay(&first);
+    Game second;
+    log.Replay(&second);
+
+    ASSERT_EQ(first.GetGateCount(), 1);
+    ASSERT_EQ(first.GetGateCount(), second.GetGateCount());
+    ASSERT_EQ(first.GetGameScore(), second.GetGameScore());
+    ASSERT_DOUBLE_EQ(first.GetEndTimer(), second.GetEndTimer());
+
+    // The gate is in the same place with the same wire
+    auto gates = DescribeGates(first);
+    ASSERT_TRUE(gates.StartsWith(L"not "));
+    ASSERT_EQ(wxNOT_FOUND, gates.Find(L"out\n"));
+    ASSERT_EQ(gates, DescribeGates(second));
+}
+
+TEST(InputLogTest, UnknownGate)
+{
+    // A gate type that does not exist is recorded, but adds nothing
+    auto event = InputEvent::AddGate(L"nand", 600, 300);
+    ASSERT_EQ(-1, event.GetValue());
+
+    InputLog log;
+    log.Start();
+    log.Record(InputEvent::SelectLevel(1));
+    log.Record(event);
+    log.Stop();
+
+    InputLog decoded;
+    ASSERT_TRUE(decoded.Decode(log.Encode()));
+    ASSERT_EQ(-1, decoded.GetEvents().back().GetValue());
+
+    Game game;
+    decoded.Replay(&game);
+    ASSERT_EQ(0, game.GetGateCount());
+}
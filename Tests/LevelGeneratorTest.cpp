@@ -0,0 +1,67 @@
+/**
+ * @file LevelGeneratorTest.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <wx/sstream.h>
+#include <LevelGenerator.h>
+
+/**
+ * Generate a level and write it to a string
+ * @param seed Seed for the generator
+ * @param products Number of products
+ * @param gates Number of gates
+ * @return The level XML
+ */
+static wxString GenerateXml(unsigned int seed, int products, int gates)
+{
+    LevelGenerator generator(seed);
+    generator.SetProductCount(products);
+    generator.SetSensorCount(2);
+    generator.SetGateCount(gates);
+
+    wxXmlDocument xmlDoc;
+    xmlDoc.SetRoot(generator.Generate());
+
+    wxStringOutputStream stream;
+    xmlDoc.Save(stream);
+    return stream.GetString();
+}
+
+/**
+ * Count the nodes with a name anywhere below a node
+ * @param node Node to search
+ * @param name Name of the nodes to count
+ * @return Number of nodes found
+ */
+static int CountNodes(wxXmlNode* node, const wxString& name)
+{
+    int count = 0;
+    for (auto child = node->GetChildren(); child; child = child->GetNext())
+    {
+        count += (child->GetName() == name ? 1 : 0) + CountNodes(child, name);
+    }
+    return count;
+}
+
+TEST(LevelGeneratorTest, SameSeedSameLevel)
+{
+    ASSERT_EQ(GenerateXml(7, 50, 40), GenerateXml(7, 50, 40));
+    ASSERT_NE(GenerateXml(7, 50, 40), GenerateXml(8, 50, 40));
+}
+
+TEST(LevelGeneratorTest, Counts)
+{
+    LevelGenerator generator(1);
+    generator.SetProductCount(200);
+    generator.SetSensorCount(3);
+    generator.SetGateCount(100);
+
+    std::unique_ptr<wxXmlNode> root(generator.Generate());
+    ASSERT_EQ(CountNodes(root.get(), L"product"), 200);
+    ASSERT_EQ(CountNodes(root.get(), L"sensor"), 3);
+    ASSERT_EQ(CountNodes(root.get(), L"gate"), 100);
+    ASSERT_EQ(CountNodes(root.get(), L"sparty"), 2);
+}
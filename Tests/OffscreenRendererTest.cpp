@@ -0,0 +1,83 @@
+/**
+ * @file OffscreenRendererTest.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <wx/filename.h>
+#include <Game.h>
+#include <OffscreenRenderer.h>
+
+/// Golden image of level 1 two seconds after its conveyor starts
+const wxString GoldenLevel1 = L"golden/level1-2s.png";
+
+/// Environment variable that makes the golden image tests write their images instead of checking them
+const wxString GoldenUpdateVariable = L"SPARTY_GOLDEN_UPDATE";
+
+/// Largest difference in any channel that still counts as the same, for antialiasing that differs by platform
+const int GoldenTolerance = 8;
+
+/// Fraction of pixels that may differ from the golden image by more than the tolerance
+const double GoldenMismatch = 0.002;
+
+TEST(OffscreenRendererTest, Deterministic)
+{
+    // The same level at the same time always draws the same frame
+    Game first;
+    first.LoadLevel(1);
+    first.OnLeftDown(270, 50);
+    OffscreenRenderer firstRenderer(575, 400);
+    auto firstImage = firstRenderer.RenderAt(&first, 2.0);
+
+    Game second;
+    second.LoadLevel(1);
+    second.OnLeftDown(270, 50);
+    OffscreenRenderer secondRenderer(575, 400);
+    secondRenderer.Advance(&second, 1.0);
+    secondRenderer.Advance(&second, 2.0);
+    auto secondImage = secondRenderer.Render(&second);
+
+    ASSERT_EQ(wxSize(575, 400), firstImage.GetSize());
+    ASSERT_DOUBLE_EQ(2.0, secondRenderer.GetTime());
+    ASSERT_EQ(0, OffscreenRenderer::Compare(firstImage, secondImage));
+
+    // Something was drawn, and the belt moving changes the frame
+    wxImage blank(575, 400);
+    blank.SetRGB(wxRect(0, 0, 575, 400), 255, 255, 255);
+    ASSERT_GT(OffscreenRenderer::Compare(firstImage, blank), 0.1);
+    ASSERT_GT(OffscreenRenderer::Compare(firstRenderer.RenderAt(&first, 4.0), firstImage), 0);
+
+    // A time already passed leaves the game where it is
+    auto later = firstRenderer.Render(&first);
+    ASSERT_EQ(0, OffscreenRenderer::Compare(firstRenderer.RenderAt(&first, 1.0), later));
+
+    // Images of different sizes never match
+    ASSERT_EQ(1, OffscreenRenderer::Compare(firstImage, OffscreenRenderer(100, 100).Render(&first)));
+}
+
+TEST(OffscreenRendererTest, Golden)
+{
+    Game game;
+    game.LoadLevel(1);
+    game.OnLeftDown(270, 50);
+    OffscreenRenderer renderer(575, 400);
+    auto image = renderer.RenderAt(&game, 2.0);
+
+    if (wxGetEnv(GoldenUpdateVariable, nullptr))
+    {
+        wxFileName::Mkdir(wxFileName(GoldenLevel1).GetPath(), wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+        ASSERT_TRUE(image.SaveFile(GoldenLevel1, wxBITMAP_TYPE_PNG));
+        return;
+    }
+
+    // Nothing to check against until the image is generated on a full build and committed
+    if (!wxFileExists(GoldenLevel1))
+    {
+        GTEST_SKIP() << "Run with " << GoldenUpdateVariable << "=1 to write " << GoldenLevel1
+                     << ", then add it to Tests/golden";
+    }
+
+    wxImage golden(GoldenLevel1, wxBITMAP_TYPE_PNG);
+    ASSERT_LE(OffscreenRenderer::Compare(image, golden, GoldenTolerance), GoldenMismatch);
+}
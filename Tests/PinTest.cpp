@@ -19,3 +19,21 @@ TEST(PinTest, State)
 	ASSERT_TRUE(outpin.first->IsUnknown());
 }
 
+
+TEST(PinTest, SaveRestoreState)
+{
+	Game game;
+	GateOr gate(&game);
+	auto outpin = gate.GetOutputPins().first;
+
+	GameState state;
+	outpin->SetOne();
+	gate.SaveState(&state);
+
+	outpin->SetZero();
+	ASSERT_TRUE(outpin->IsZero());
+
+	state.Seek(0);
+	gate.RestoreState(&state);
+	ASSERT_TRUE(outpin->IsOne());
+}
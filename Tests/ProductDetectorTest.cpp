@@ -0,0 +1,188 @@
+/**
+ * @file ProductDetectorTest.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <wx/filename.h>
+#include <wx/ffile.h>
+#include <Game.h>
+#include <Level.h>
+#include <Conveyor.h>
+#include <Product.h>
+#include <ProductDetector.h>
+#include <ThreadPool.h>
+
+/// Two lanes, each with its own conveyor, beam and Sparty
+const wchar_t* TwoLaneLevel = LR"(<?xml version='1.0' encoding='UTF-8'?>
+<level size="1150,800">
+	<items>
+		<conveyor x="150" y="400" speed="100" height="800" panel="60,-390">
+			<product placement="100" shape="square" color="green" kick="no"/>
+			<product placement="+150" shape="square" color="red" kick="yes"/>
+			<product placement="+120" shape="circle" color="blue" kick="no"/>
+		</conveyor>
+		<beam x="242" y="437" sender="-185"/>
+		<sparty x="290" y="340" height="300" pin="1100, 400"/>
+		<conveyor lane="1" x="550" y="400" speed="100" height="800" panel="60,-390">
+			<product placement="150" shape="diamond" color="red" kick="no"/>
+			<product placement="+100" shape="square" color="green" kick="no"/>
+			<product placement="+170" shape="circle" color="red" kick="yes"/>
+			<product placement="+90" shape="diamond" color="blue" kick="no"/>
+		</conveyor>
+		<beam lane="1" x="642" y="437" sender="-185"/>
+		<sparty lane="1" x="690" y="340" height="300" pin="1100, 600"/>
+		<scoreboard x="900" y="40" good="10" bad="-5">Two lanes</scoreboard>
+	</items>
+</level>
+)";
+
+/// Time for one tick in seconds
+const double LaneTickTime = 0.05;
+
+/**
+ * Visitor that finds the items of a two lane level
+ */
+class LaneItems : public VisitorBase
+{
+public:
+    std::vector<Conveyor*> mConveyors;  ///< Every conveyor
+    std::vector<Sparty*> mSpartys;      ///< Every Sparty
+    std::vector<Product*> mProducts;    ///< Every product in play
+    Scoreboard* mScoreboard = nullptr;  ///< The scoreboard
+
+    /**
+     * Visit a conveyor
+     * @param conveyor The conveyor
+     */
+    void VisitConveyor(Conveyor* conveyor) override { mConveyors.push_back(conveyor); }
+
+    /**
+     * Visit Sparty
+     * @param sparty Sparty
+     */
+    void VisitSparty(Sparty* sparty) override { mSpartys.push_back(sparty); }
+
+    /**
+     * Visit a product
+     * @param product The product
+     */
+    void VisitProduct(Product* product) override { mProducts.push_back(product); }
+
+    /**
+     * Visit the scoreboard
+     * @param scoreboard The scoreboard
+     */
+    void VisitScoreboard(Scoreboard* scoreboard) override { mScoreboard = scoreboard; }
+};
+
+/**
+ * Load the two lane level and start both conveyors
+ * @param game Game to load into
+ * @param items Set to the items of the level
+ */
+static void StartTwoLanes(Game& game, LaneItems& items)
+{
+    auto filename = wxFileName::CreateTempFileName(L"sparty-lanes");
+    wxFFile file(filename, L"w");
+    file.Write(wxString(TwoLaneLevel));
+    file.Close();
+    game.Load(filename);
+    wxRemoveFile(filename);
+
+    game.Accept(&items);
+    ASSERT_EQ(2u, items.mConveyors.size());
+    ASSERT_EQ(2u, items.mSpartys.size());
+    ASSERT_EQ(7u, items.mProducts.size());
+    ASSERT_NE(nullptr, items.mScoreboard);
+
+    // The start buttons of the two conveyor panels
+    game.OnLeftDown(270, 50);
+    game.OnLeftDown(670, 50);
+}
+
+/**
+ * Move the belts, detect every lane and score what passed the beams
+ * @param game The game
+ * @param items Items of the game
+ * @param pool Threads to detect the lanes on
+ */
+static void TickLanes(Game& game, LaneItems& items, ThreadPool& pool)
+{
+    for (auto conveyor : items.mConveyors)
+    {
+        conveyor->Update(LaneTickTime);
+    }
+    ProductDetector::UpdateLanes(&game, pool);
+    items.mScoreboard->ScorePassedProducts();
+}
+
+TEST(ProductDetectorTest, LanesMatchSerial)
+{
+    Game serial;
+    LaneItems serialItems;
+    StartTwoLanes(serial, serialItems);
+
+    Game parallel;
+    LaneItems parallelItems;
+    StartTwoLanes(parallel, parallelItems);
+
+    // No workers runs the lanes one after another on this thread
+    ThreadPool one(0);
+    ThreadPool pool(3);
+
+    // Only the first lane's Sparty is wired to start with
+    for (auto items : {&serialItems, &parallelItems})
+    {
+        for (auto sparty : items->mSpartys)
+        {
+            if (sparty->GetLane() == 0)
+            {
+                sparty->GetInputPin()->SetZero();
+            }
+        }
+    }
+
+    for (int i = 0; i < 400; i++)
+    {
+        if (i == 200)
+        {
+            // The second lane's products have waited until now to be scored
+            size_t waiting = 0;
+            for (auto product : serialItems.mProducts)
+            {
+                waiting += product->GetLane() == 1 && product->GetPassedBeam();
+            }
+            ASSERT_GT(waiting, 0u);
+            ASSERT_EQ(waiting, serialItems.mScoreboard->GetPassedProductCount());
+
+            for (auto items : {&serialItems, &parallelItems})
+            {
+                for (auto sparty : items->mSpartys)
+                {
+                    sparty->GetInputPin()->SetZero();
+                }
+            }
+        }
+
+        TickLanes(serial, serialItems, one);
+        TickLanes(parallel, parallelItems, pool);
+
+        ASSERT_EQ(serial.GetLevel()->GetProductsRemaining(), parallel.GetLevel()->GetProductsRemaining());
+        ASSERT_EQ(serialItems.mScoreboard->GetLevelScore(), parallelItems.mScoreboard->GetLevelScore());
+        ASSERT_EQ(serialItems.mScoreboard->GetPassedProductCount(),
+                  parallelItems.mScoreboard->GetPassedProductCount());
+        for (size_t p = 0; p < serialItems.mProducts.size(); p++)
+        {
+            ASSERT_EQ(serialItems.mProducts[p]->GetPassedBeam(), parallelItems.mProducts[p]->GetPassedBeam());
+            ASSERT_EQ(serialItems.mProducts[p]->GetScored(), parallelItems.mProducts[p]->GetScored());
+        }
+    }
+
+    // Every product on both lanes passed its beam and was scored once:
+    // five left alone correctly, two that should have been kicked
+    ASSERT_TRUE(parallel.GetLevel()->IsLastProductReached());
+    ASSERT_EQ(0u, parallelItems.mScoreboard->GetPassedProductCount());
+    ASSERT_EQ(5 * 10 - 2 * 5, parallelItems.mScoreboard->GetLevelScore());
+}
@@ -0,0 +1,255 @@
+/**
+ * @file ProductStreamTest.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <wx/filename.h>
+#include <fstream>
+#include <ProductStream.h>
+#include <Game.h>
+#include <Level.h>
+#include <Conveyor.h>
+#include <Product.h>
+#include <VisitorBase.h>
+#include <algorithm>
+#include <limits>
+
+/**
+ * Visitor that collects where the products in play are
+ */
+class StreamedProducts : public VisitorBase
+{
+public:
+    std::vector<double> mPositions; ///< Y location of each product visited
+
+    /**
+     * Record where a product is
+     * @param product The product
+     */
+    void VisitProduct(Product* product) override { mPositions.push_back(product->GetY()); }
+};
+
+/**
+ * Get where the products of a game in play are
+ * @param game The game
+ * @return Y location of each product in play, lowest first
+ */
+static std::vector<double> GetStreamed(Game& game)
+{
+    game.ApplyParking();
+    StreamedProducts products;
+    game.Accept(&products);
+    std::sort(products.mPositions.begin(), products.mPositions.end());
+    return products.mPositions;
+}
+
+/**
+ * Visitor that moves the products at one Y location to another
+ */
+class ProductMover : public VisitorBase
+{
+private:
+    double mFrom; ///< Y location of the products to move
+    double mTo;   ///< Y location to move them to
+
+public:
+    /**
+     * Constructor
+     * @param from Y location of the products to move
+     * @param to Y location to move them to
+     */
+    ProductMover(double from, double to) : mFrom(from), mTo(to) {}
+
+    /**
+     * Move a product if it is at the Y location
+     * @param product The product
+     */
+    void VisitProduct(Product* product) override
+    {
+        if (product->GetY() == mFrom)
+        {
+            product->SetLocation(product->GetX(), mTo);
+        }
+    }
+};
+
+/**
+ * Write lines to a temporary file
+ * @param lines Lines to write
+ * @return Name of the file
+ */
+static wxString WriteLines(const std::vector<std::string>& lines)
+{
+    auto filename = wxFileName::CreateTempFileName(L"sparty-stream");
+    std::ofstream file(filename.ToStdString());
+    for (auto& line : lines)
+    {
+        file << line << "\n";
+    }
+    return filename;
+}
+
+/**
+ * Read products from a source and describe them as one string
+ * @param source Source to read
+ * @param count Number of products to read
+ * @return The attributes of each product, one product per line
+ */
+static wxString ReadProducts(ProductSource& source, int count)
+{
+    wxString products;
+    for (int i = 0; i < count; i++)
+    {
+        std::unique_ptr<wxXmlNode> product(source.Next());
+        if (product == nullptr)
+        {
+            products += L"end\n";
+            break;
+        }
+
+        for (auto attribute = product->GetAttributes(); attribute; attribute = attribute->GetNext())
+        {
+            products += attribute->GetName() + L"=" + attribute->GetValue() + L" ";
+        }
+        products += L"\n";
+    }
+    return products;
+}
+
+TEST(ProductStreamTest, Generated)
+{
+    // The same seed gives the same products, and rewinding starts them over
+    GeneratedProductSource source(3, 5);
+    GeneratedProductSource same(3, 5);
+    auto products = ReadProducts(source, 5);
+    ASSERT_EQ(products, ReadProducts(same, 5));
+
+    source.Rewind();
+    ASSERT_EQ(products, ReadProducts(source, 5));
+
+    // A counted source ends, an endless one does not
+    ASSERT_EQ(5, source.GetCount());
+    ASSERT_EQ(L"end\n", ReadProducts(source, 1));
+
+    GeneratedProductSource endless(3);
+    ASSERT_EQ(-1, endless.GetCount());
+    ASSERT_EQ(wxNOT_FOUND, ReadProducts(endless, 500).Find(L"end"));
+}
+
+TEST(ProductStreamTest, File)
+{
+    auto filename = wxFileName::CreateTempFileName(L"sparty-stream");
+    {
+        std::ofstream file(filename.ToStdString());
+        file << "<product placement=\"100\" shape=\"circle\" color=\"red\" kick=\"yes\"/>\n";
+        file << "\n";
+        file << "<product placement=\"+150\" shape=\"square\" color=\"blue\" kick=\"no\"/>\n";
+    }
+
+    FileProductSource source(filename.ToStdString());
+    ASSERT_EQ(2, source.GetCount());
+    ASSERT_EQ(L"placement=100 shape=circle color=red kick=yes \n"
+              L"placement=+150 shape=square color=blue kick=no \n"
+              L"end\n", ReadProducts(source, 3));
+
+    // A looping file starts over from the top
+    FileProductSource loop(filename.ToStdString(), true);
+    ASSERT_EQ(-1, loop.GetCount());
+    auto products = ReadProducts(loop, 4);
+    ASSERT_EQ(wxNOT_FOUND, products.Find(L"end"));
+    ASSERT_EQ(2, products.Replace(L"color=red", L"color=red"));
+
+    wxRemoveFile(filename);
+
+    // A looping file without a product that loads is used up after one pass
+    auto broken = WriteLines({"<product placement=\"100\"", "not a product"});
+    FileProductSource brokenLoop(broken.ToStdString(), true);
+    ASSERT_EQ(L"end\n", ReadProducts(brokenLoop, 1));
+    wxRemoveFile(broken);
+}
+
+TEST(ProductStreamTest, Pool)
+{
+    auto filename = WriteLines({
+        "<product placement=\"100\" shape=\"circle\" color=\"red\" kick=\"no\"/>",
+        "<product placement=\"+300\" shape=\"square\" color=\"blue\" kick=\"no\"/>",
+        "<product placement=\"+300\" shape=\"diamond\" color=\"green\" kick=\"no\"/>",
+        "<product placement=\"+300\" shape=\"circle\" color=\"blue\" kick=\"no\"/>"});
+
+    Game game;
+    Level level(&game);
+    Conveyor conveyor(&level);
+    wxXmlNode node(wxXML_ELEMENT_NODE, L"conveyor");
+    node.AddAttribute(L"x", L"150");
+    node.AddAttribute(L"y", L"400");
+    node.AddAttribute(L"speed", L"100");
+    node.AddAttribute(L"height", L"800");
+    node.AddAttribute(L"panel", L"60,-390");
+    conveyor.XmlLoad(&node);
+
+    // Three products for a file of four, all parked to start with
+    ProductStream stream(std::make_unique<FileProductSource>(filename.ToStdString()), 0);
+    stream.CreatePool(&level, 3, conveyor.GetHeight());
+    ASSERT_EQ(4, stream.GetCount());
+    ASSERT_EQ(3, stream.GetPoolSize());
+    ASSERT_EQ(0, stream.GetActiveCount());
+    ASSERT_TRUE(GetStreamed(game).empty());
+    ASSERT_EQ(3u, game.GetParkedCount());
+
+    // The first two are in view, 100 and 400 above the middle of the belt
+    stream.Update(&conveyor, 0);
+    ASSERT_EQ(2, stream.GetActiveCount());
+    ASSERT_EQ(std::vector<double>({0, 300}), GetStreamed(game));
+
+    // The third is placed once the belt brings it near the top
+    stream.Update(&conveyor, 150);
+    ASSERT_EQ(2, stream.GetActiveCount());
+    stream.Update(&conveyor, 50);
+    ASSERT_EQ(3, stream.GetActiveCount());
+    ASSERT_EQ(std::vector<double>({-100, 0, 300}), GetStreamed(game));
+
+    // The fourth waits for a product to come back to the pool
+    stream.Update(&conveyor, 400);
+    ASSERT_EQ(3, stream.GetActiveCount());
+
+    // A product past the end of the belt goes back and is used for it
+    ProductMover mover(300, 1000);
+    game.Accept(&mover);
+    stream.Update(&conveyor, 0);
+    ASSERT_EQ(3, stream.GetActiveCount());
+    ASSERT_EQ(std::vector<double>({-100, 0, 0}), GetStreamed(game));
+    ASSERT_EQ(0u, game.GetParkedCount());
+
+    // Nothing more comes once the file is used up
+    stream.Update(&conveyor, 1000);
+    ASSERT_EQ(3, stream.GetActiveCount());
+
+    // Resetting parks everything and starts from the top again
+    stream.Reset();
+    ASSERT_EQ(0, stream.GetActiveCount());
+    ASSERT_TRUE(GetStreamed(game).empty());
+    stream.Update(&conveyor, 0);
+    ASSERT_EQ(std::vector<double>({0, 300}), GetStreamed(game));
+
+    wxRemoveFile(filename);
+}
+
+TEST(ProductStreamTest, EndlessCount)
+{
+    // An endless stream followed by a listed conveyor does not overflow the count
+    auto filename = WriteLines({
+        "<level size=\"1150,800\"><items>",
+        "<conveyor x=\"150\" y=\"400\" speed=\"100\" height=\"800\" panel=\"60,-390\" stream=\"seed\" seed=\"1\" pool=\"4\"/>",
+        "<conveyor lane=\"1\" x=\"550\" y=\"400\" speed=\"100\" height=\"800\" panel=\"60,-390\">",
+        "<product placement=\"100\" shape=\"circle\" color=\"red\"/>",
+        "</conveyor>",
+        "</items></level>"});
+
+    Game game;
+    game.Load(filename);
+    wxRemoveFile(filename);
+    ASSERT_EQ(std::numeric_limits<int>::max(), game.GetLevel()->GetProductsRemaining());
+    ASSERT_FALSE(game.GetLevel()->IsLastProductReached());
+}
@@ -8,6 +8,8 @@
 #include <Product.h>
 #include <Game.h>
 #include <Level.h>
+#include <DrawCuller.h>
+#include <GateAnd.h>
 #include <wx/xml/xml.h>
 
 /// The possible product properties
@@ -87,4 +89,30 @@ TEST_F(ProductTest, XmlLoadDefaultValues) {
     EXPECT_FALSE(product->ShouldKick());
 
     delete node;
-}
\ No newline at end of file
+}
+
+TEST_F(ProductTest, Cull) {
+    // A window twice the size of the virtual window, centred with a 50 pixel border
+    DrawCuller culler;
+    culler.SetWindow(2400, 1700, 2.0, 50, 50);
+
+    product->SetLocation(205, 400);
+    ASSERT_TRUE(culler.IsVisible(product.get()));
+
+    // Queued far above the top of the conveyor
+    product->SetLocation(205, -1000);
+    ASSERT_FALSE(culler.IsVisible(product.get()));
+
+    // Kicked off the side
+    product->SetLocation(2000, 400);
+    ASSERT_FALSE(culler.IsVisible(product.get()));
+
+    // Only products are culled
+    auto gate = std::make_shared<GateAnd>(game.get());
+    gate->SetLocation(5000, 5000);
+    ASSERT_TRUE(culler.IsVisible(gate.get()));
+
+    std::vector<std::shared_ptr<Item>> items = {gate, product};
+    ASSERT_EQ(culler.Cull(items).size(), 1u);
+    ASSERT_EQ(culler.GetCulledCount(), 1);
+}
@@ -8,6 +8,38 @@
 #include <Level.h>
 #include <Game.h>
 #include <Scoreboard.h>
+#include <Sparty.h>
+#include <Product.h>
+#include <VisitorBase.h>
+
+/**
+ * Visitor that finds the items products are scored with
+ */
+class ScoringItems : public VisitorBase
+{
+public:
+    Scoreboard* mScoreboard = nullptr;  ///< The level's scoreboard
+    Sparty* mSparty = nullptr;          ///< The level's Sparty
+    std::vector<Product*> mProducts;    ///< Every product in play
+
+    /**
+     * Visit the scoreboard
+     * @param scoreboard The scoreboard
+     */
+    void VisitScoreboard(Scoreboard* scoreboard) override { mScoreboard = scoreboard; }
+
+    /**
+     * Visit Sparty
+     * @param sparty Sparty
+     */
+    void VisitSparty(Sparty* sparty) override { mSparty = sparty; }
+
+    /**
+     * Visit a product
+     * @param product The product
+     */
+    void VisitProduct(Product* product) override { mProducts.push_back(product); }
+};
 
 class ScoreboardTest : public ::testing::Test {
 
@@ -71,4 +103,96 @@ TEST_F(ScoreboardTest, XmlLoadDefault)
 
     delete node;
 
-}
\ No newline at end of file
+}
+
+TEST_F(ScoreboardTest, ScoreSeveralProducts)
+{
+    game->LoadLevel(1);
+    ScoringItems items;
+    game->Accept(&items);
+    ASSERT_NE(items.mScoreboard, nullptr);
+    ASSERT_NE(items.mSparty, nullptr);
+    ASSERT_EQ(items.mProducts.size(), 4u);
+
+    // Sparty is wired to something
+    items.mSparty->GetInputPin()->SetZero();
+
+    // Every product in level 1 should be kicked, only two of them were
+    items.mProducts[0]->SetKicked(true);
+    items.mProducts[2]->SetKicked(true);
+
+    // All of them pass the beam during one long update
+    auto scoreboard = items.mScoreboard;
+    for (auto product : items.mProducts)
+    {
+        scoreboard->PostPassedBeam(product);
+    }
+    scoreboard->Update(10);
+
+    ASSERT_EQ(scoreboard->GetLevelScore(), 2 * scoreboard->GetGood() + 2 * scoreboard->GetBad());
+    ASSERT_EQ(scoreboard->GetPassedProductCount(), 0u);
+    for (auto product : items.mProducts)
+    {
+        ASSERT_TRUE(product->GetScored());
+    }
+
+    // A product is only ever scored once
+    scoreboard->PostPassedBeam(items.mProducts[0]);
+    scoreboard->Update(10);
+    ASSERT_EQ(scoreboard->GetLevelScore(), 2 * scoreboard->GetGood() + 2 * scoreboard->GetBad());
+    ASSERT_EQ(scoreboard->GetPassedProductCount(), 0u);
+}
+
+TEST_F(ScoreboardTest, WaitForSparty)
+{
+    game->LoadLevel(1);
+    ScoringItems items;
+    game->Accept(&items);
+    auto scoreboard = items.mScoreboard;
+
+    for (auto product : items.mProducts)
+    {
+        product->SetKicked(true);
+        scoreboard->PostPassedBeam(product);
+    }
+
+    // Nothing is scored while Sparty is not connected
+    ASSERT_FALSE(items.mSparty->IsConnected());
+    scoreboard->Update(1);
+    scoreboard->Update(1);
+    ASSERT_EQ(scoreboard->GetLevelScore(), 0);
+    ASSERT_EQ(scoreboard->GetPassedProductCount(), items.mProducts.size());
+    for (auto product : items.mProducts)
+    {
+        ASSERT_FALSE(product->GetScored());
+    }
+
+    // The waiting products are all scored once it is
+    items.mSparty->GetInputPin()->SetOne();
+    scoreboard->Update(1);
+    ASSERT_EQ(scoreboard->GetLevelScore(), int(items.mProducts.size()) * scoreboard->GetGood());
+    ASSERT_EQ(scoreboard->GetPassedProductCount(), 0u);
+}
+
+TEST_F(ScoreboardTest, ClearOnConveyorReset)
+{
+    game->LoadLevel(1);
+    ScoringItems items;
+    game->Accept(&items);
+    auto scoreboard = items.mScoreboard;
+
+    for (auto product : items.mProducts)
+    {
+        scoreboard->PostPassedBeam(product);
+    }
+    ASSERT_EQ(scoreboard->GetPassedProductCount(), items.mProducts.size());
+
+    // Starting the conveyor resets the products, which drops the queue
+    game->OnLeftDown(270, 50);
+    ASSERT_EQ(scoreboard->GetPassedProductCount(), 0u);
+
+    // So connecting Sparty afterwards scores nothing
+    items.mSparty->GetInputPin()->SetOne();
+    scoreboard->Update(1);
+    ASSERT_EQ(scoreboard->GetLevelScore(), 0);
+}
@@ -8,6 +8,9 @@
 #include <Level.h>
 #include <Game.h>
 #include <Sensor.h>
+#include <SensorOutputVisitor.h>
+#include <OutputSetter.h>
+#include <OutputResetter.h>
 
 class SensorTest : public ::testing::Test {
 
@@ -97,4 +100,46 @@ TEST_F(SensorTest, DetectProduct)
     // Test product out of range again
     productLocation = std::make_tuple(450, 550);
     ASSERT_FALSE(sensor->DetectProduct(productLocation, 500));
-}
\ No newline at end of file
+}
+
+TEST_F(SensorTest, Lanes)
+{
+    // A sensor on the second lane with a single red output
+    auto node = new wxXmlNode(wxXML_ELEMENT_NODE, L"sensor");
+    node->AddAttribute(L"x", L"155");
+    node->AddAttribute(L"y", L"430");
+    node->AddAttribute(L"lane", L"1");
+    node->AddChild(new wxXmlNode(wxXML_ELEMENT_NODE, L"red"));
+
+    sensor->XmlLoad(node);
+    ASSERT_EQ(sensor->GetLane(), 1);
+
+    SensorOutputVisitor visitor;
+    game->Accept(&visitor);
+    ASSERT_EQ(visitor.GetOutput().size(), 1);
+    auto pin = visitor.GetOutput()[0];
+
+    // A red product on the first lane leaves the output alone
+    OutputResetter resetter;
+    game->Accept(&resetter);
+    OutputSetter otherLane(0);
+    otherLane.SetProductProperties(1, 0, 0);
+    game->Accept(&otherLane);
+    ASSERT_TRUE(pin->IsZero());
+
+    // On its own lane it is set, and only its own lane's resetter clears it
+    OutputSetter ownLane(1);
+    ownLane.SetProductProperties(1, 0, 0);
+    game->Accept(&ownLane);
+    ASSERT_TRUE(pin->IsOne());
+
+    OutputResetter otherResetter(0);
+    game->Accept(&otherResetter);
+    ASSERT_TRUE(pin->IsOne());
+
+    OutputResetter ownResetter(1);
+    game->Accept(&ownResetter);
+    ASSERT_TRUE(pin->IsZero());
+
+    delete node;
+}
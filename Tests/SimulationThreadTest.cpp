@@ -0,0 +1,212 @@
+/**
+ * @file SimulationThreadTest.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <Game.h>
+#include <InputLog.h>
+#include <SimulationThread.h>
+#include <Product.h>
+#include <VisitorBase.h>
+#include <algorithm>
+#include <chrono>
+
+/**
+ * Visitor that collects where the products in play are
+ */
+class ProductLocations : public VisitorBase
+{
+public:
+    std::vector<wxPoint2DDouble> mLocations; ///< Location of each product visited
+
+    /**
+     * Record where a product is
+     * @param product The product
+     */
+    void VisitProduct(Product* product) override { mLocations.emplace_back(product->GetX(), product->GetY()); }
+};
+
+/**
+ * Get where the products in play are
+ * @param game The game
+ * @return Location of each product in visiting order
+ */
+static std::vector<wxPoint2DDouble> GetPositions(Game& game)
+{
+    ProductLocations locations;
+    game.Accept(&locations);
+    return locations.mLocations;
+}
+
+TEST(SimulationThreadTest, TripleBuffer)
+{
+    TripleBuffer<int> buffer;
+    ASSERT_FALSE(buffer.Acquire());
+
+    // The reader only ever sees the newest value published
+    buffer.GetWriteBuffer() = 1;
+    buffer.Publish();
+    buffer.GetWriteBuffer() = 2;
+    buffer.Publish();
+    ASSERT_TRUE(buffer.Acquire());
+    ASSERT_EQ(2, buffer.GetReadBuffer());
+    ASSERT_FALSE(buffer.Acquire());
+    ASSERT_EQ(2, buffer.GetReadBuffer());
+
+    buffer.GetWriteBuffer() = 3;
+    buffer.Publish();
+    ASSERT_TRUE(buffer.Acquire());
+    ASSERT_EQ(3, buffer.GetReadBuffer());
+}
+
+TEST(SimulationThreadTest, SpscQueue)
+{
+    SpscQueue<int> queue(3);
+    ASSERT_TRUE(queue.Push(1));
+    ASSERT_TRUE(queue.Push(2));
+    ASSERT_TRUE(queue.Push(3));
+    ASSERT_FALSE(queue.Push(4));
+
+    int value;
+    ASSERT_TRUE(queue.Pop(value));
+    ASSERT_EQ(1, value);
+
+    // Values cross from one thread to the other in order
+    const int Count = 100000;
+    std::thread producer([&queue]() {
+        for (int i = 4; i < Count; )
+        {
+            i += queue.Push(i) ? 1 : 0;
+        }
+    });
+
+    int expected = 2;
+    while (expected < Count)
+    {
+        if (queue.Pop(value))
+        {
+            ASSERT_EQ(expected, value);
+            expected++;
+        }
+    }
+    producer.join();
+    ASSERT_TRUE(queue.IsEmpty());
+}
+
+TEST(SimulationThreadTest, CommandQueue)
+{
+    Game game;
+    game.LoadLevel(1);
+    CommandQueue commands(8);
+    InputLog log;
+    log.Start();
+
+    // Moves with the button in the same state collapse to the last one
+    ASSERT_TRUE(commands.Post(InputEvent::MouseMove(10, 10, false)));
+    ASSERT_TRUE(commands.Post(InputEvent::MouseMove(20, 20, false)));
+    ASSERT_TRUE(commands.Post(InputEvent::MouseMove(30, 30, true)));
+    ASSERT_TRUE(commands.Post(InputEvent::MouseMove(40, 40, true)));
+    ASSERT_TRUE(commands.Post(InputEvent::MouseMove(50, 50, true)));
+    ASSERT_TRUE(commands.Post(InputEvent::LeftDown(60, 60)));
+    ASSERT_TRUE(commands.Post(InputEvent::MouseMove(70, 70, true)));
+    ASSERT_TRUE(commands.Post(InputEvent::MouseMove(80, 80, true)));
+    ASSERT_FALSE(commands.Post(InputEvent::MouseMove(90, 90, true)));
+    ASSERT_EQ(1, commands.GetDroppedCount());
+
+    ASSERT_EQ(4, commands.Apply(&game, &log));
+    ASSERT_TRUE(commands.IsEmpty());
+    ASSERT_EQ(8, commands.GetPostedCount());
+    ASSERT_EQ(4, commands.GetAppliedCount());
+
+    // Only the actions applied are recorded
+    auto& events = log.GetEvents();
+    ASSERT_EQ(4u, events.size());
+    ASSERT_EQ(20, events[0].GetX());
+    ASSERT_EQ(50, events[1].GetX());
+    ASSERT_EQ(InputEvent::Types::LeftDown, events[2].GetType());
+    ASSERT_EQ(80, events[3].GetX());
+
+    ASSERT_EQ(0, commands.Apply(&game, &log));
+}
+
+TEST(SimulationThreadTest, Step)
+{
+    Game game;
+    Game view;
+    InputLog log;
+    log.Start();
+
+    SimulationThread simulation(&game, &view, 1.0 / 120.0);
+    simulation.SetLog(&log);
+    ASSERT_TRUE(simulation.Post(InputEvent::SelectLevel(1)));
+    ASSERT_TRUE(simulation.Post(InputEvent::LeftDown(270, 50)));
+
+    // Choosing a level loads it into the view straight away
+    ASSERT_EQ(1, view.GetLevel()->GetLevelNumber());
+
+    wxImage image(575, 400);
+    std::shared_ptr<wxGraphicsContext> graphics(wxGraphicsContext::Create(image));
+    for (int step = 1; step <= 3; step++)
+    {
+        simulation.Step(30);
+
+        // The view looks like the simulated game once the newest frame is drawn
+        ASSERT_TRUE(simulation.Draw(graphics, 575, 400));
+        auto& frame = simulation.GetFrame();
+        ASSERT_EQ(30u * step, frame.mTick);
+        ASSERT_DOUBLE_EQ(step * 0.25, frame.mTime);
+        ASSERT_EQ(1, frame.mState.GetLevel());
+        ASSERT_EQ(GetPositions(game), GetPositions(view));
+        ASSERT_EQ(game.GetGameScore(), view.GetGameScore());
+
+        // Drawing again without a new frame leaves the view as it is
+        ASSERT_FALSE(simulation.Draw(graphics, 575, 400));
+    }
+    log.Stop();
+
+    // Every tick used the same time, so replaying the log gives the same game
+    Game replayed;
+    log.Replay(&replayed);
+    ASSERT_EQ(GetPositions(game), GetPositions(replayed));
+    ASSERT_EQ(game.GetGameScore(), replayed.GetGameScore());
+}
+
+TEST(SimulationThreadTest, Run)
+{
+    Game game;
+    Game view;
+    InputLog log;
+    log.Start();
+
+    SimulationThread simulation(&game, &view, 1.0 / 120.0);
+    simulation.SetLog(&log);
+    simulation.Start();
+    ASSERT_TRUE(simulation.Post(InputEvent::SelectLevel(1)));
+    ASSERT_TRUE(simulation.Post(InputEvent::LeftDown(270, 50)));
+
+    // Stepping is only for a stopped simulation
+    simulation.Step(1);
+
+    // However many ticks the thread gets through, the results only depend on the ticks it ran
+    while (!simulation.Acquire())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    simulation.Stop();
+    log.Stop();
+    ASSERT_FALSE(simulation.IsRunning());
+
+    auto& events = log.GetEvents();
+    auto ticks = std::count_if(events.begin(), events.end(),
+                               [](const InputEvent& event) { return event.GetType() == InputEvent::Types::Tick; });
+    ASSERT_GT(ticks, 0);
+    ASSERT_LE(simulation.GetFrame().mTick, unsigned(ticks));
+
+    Game replayed;
+    log.Replay(&replayed);
+    ASSERT_EQ(GetPositions(game), GetPositions(replayed));
+    ASSERT_EQ(game.GetGameScore(), replayed.GetGameScore());
+    ASSERT_DOUBLE_EQ(game.GetEndTimer(), replayed.GetEndTimer());
+}
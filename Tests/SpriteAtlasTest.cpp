@@ -0,0 +1,104 @@
+/**
+ * @file SpriteAtlasTest.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <SpriteAtlas.h>
+#include <ProductSpriteCache.h>
+
+/**
+ * Make a solid image
+ * @param width Width in pixels
+ * @param height Height in pixels
+ * @param red Red value of every pixel
+ * @return The image
+ */
+static wxImage SolidImage(int width, int height, unsigned char red)
+{
+    wxImage image(width, height);
+    image.SetRGB(wxRect(0, 0, width, height), red, 0, 0);
+    return image;
+}
+
+TEST(SpriteAtlasTest, Pack)
+{
+    SpriteAtlas atlas;
+    for (int i = 0; i < 40; i++)
+    {
+        atlas.Add(L"sprite" + std::to_wstring(i), SolidImage(30 + i * 7 % 200, 20 + i * 13 % 300, (unsigned char)i));
+    }
+    atlas.Add(L"huge", SolidImage(SpriteAtlas::PageSize + 10, 10, 255));
+    atlas.Build();
+
+    ASSERT_TRUE(atlas.Has(L"sprite0"));
+    ASSERT_FALSE(atlas.Has(L"missing"));
+
+    // Everything but the huge image fits on one page, which it has to itself
+    ASSERT_EQ(2, atlas.GetPageCount());
+    ASSERT_EQ(1, atlas.GetSprite(L"huge")->mPage);
+
+    std::vector<wxRect> placed;
+    for (int i = 0; i < 40; i++)
+    {
+        auto name = L"sprite" + std::to_wstring(i);
+        auto sprite = atlas.GetSprite(name);
+        ASSERT_EQ(0, sprite->mPage);
+
+        wxRect rect(sprite->mX, sprite->mY, sprite->mWidth, sprite->mHeight);
+        ASSERT_EQ(atlas.GetSize(name), rect.GetSize());
+        ASSERT_TRUE(wxRect(0, 0, atlas.GetPage(0).GetWidth(), atlas.GetPage(0).GetHeight()).Contains(rect));
+        for (auto& other : placed)
+        {
+            ASSERT_FALSE(rect.Intersects(other));
+        }
+        placed.push_back(rect);
+
+        // The pixels are copied into the page
+        ASSERT_EQ(i, atlas.GetPage(0).GetRed(sprite->mX + sprite->mWidth - 1, sprite->mY + sprite->mHeight - 1));
+        ASSERT_EQ(255, atlas.GetPage(0).GetAlpha(sprite->mX, sprite->mY));
+    }
+
+    // Adding an image packs it in with the rest the next time the atlas is built
+    atlas.Add(L"late", SolidImage(5, 5, 77));
+    ASSERT_EQ(-1, atlas.GetSprite(L"late")->mPage);
+    atlas.Build();
+    auto late = atlas.GetSprite(L"late");
+    ASSERT_EQ(0, late->mPage);
+    ASSERT_EQ(77, atlas.GetPage(0).GetRed(late->mX, late->mY));
+}
+
+TEST(SpriteAtlasTest, ProductSprites)
+{
+    using Properties = Product::Properties;
+
+    // A product is transparent outside its shape and filled with its colour inside
+    auto circle = ProductSpriteCache::Render({Properties::Circle, Properties::Red, Properties::None}, 64);
+    ASSERT_EQ(64, circle.GetWidth());
+    ASSERT_EQ(0, circle.GetAlpha(1, 1));
+    ASSERT_EQ(255, circle.GetAlpha(32, 32));
+    ASSERT_EQ(187, circle.GetRed(32, 32));
+
+    auto square = ProductSpriteCache::Render({Properties::Square, Properties::Blue, Properties::None}, 64);
+    ASSERT_EQ(255, square.GetAlpha(4, 4));
+    ASSERT_EQ(76, square.GetBlue(32, 32));
+
+    // Each appearance is rendered once for each size it is drawn at
+    wxImage target(400, 400);
+    std::unique_ptr<wxGraphicsContext> graphics(wxGraphicsContext::Create(target));
+    ProductSpriteCache cache;
+    ProductSpriteCache::Key green(Properties::Diamond, Properties::Green, Properties::None);
+    ProductSpriteCache::Key white(Properties::Square, Properties::White, Properties::None);
+
+    ASSERT_TRUE(cache.Draw(graphics.get(), green, 0, 0, 50, 50));
+    ASSERT_TRUE(cache.Draw(graphics.get(), green, 100, 0, 50, 50));
+    ASSERT_TRUE(cache.Draw(graphics.get(), white, 200, 0, 50, 50));
+    ASSERT_EQ(2, cache.GetCount());
+    ASSERT_EQ(2, cache.GetRenderedCount());
+
+    graphics->Scale(2, 2);
+    ASSERT_TRUE(cache.Draw(graphics.get(), green, 0, 100, 50, 50));
+    ASSERT_EQ(1, cache.GetCount());
+    ASSERT_EQ(3, cache.GetRenderedCount());
+}
@@ -0,0 +1,86 @@
+/**
+ * @file TraceRecorderTest.cpp
+ * @author Attulya Pratap Gupta
+ */
+
+#include <pch.h>
+#include "gtest/gtest.h"
+#include <wx/filename.h>
+#include <wx/ffile.h>
+#include <TraceRecorder.h>
+
+/**
+ * Save the recorded events and read the file back
+ * @return The saved JSON
+ */
+static wxString SaveTrace()
+{
+    auto filename = wxFileName::CreateTempFileName(L"sparty-trace");
+    EXPECT_TRUE(TraceRecorder::Get().Save(filename));
+
+    wxString json;
+    wxFFile file(filename, L"r");
+    file.ReadAll(&json);
+    file.Close();
+    wxRemoveFile(filename);
+    return json;
+}
+
+TEST(TraceRecorderTest, Save)
+{
+    auto& recorder = TraceRecorder::Get();
+    recorder.Clear();
+
+    // Nothing is recorded while disabled
+    recorder.Instant("Ignored", "test");
+
+    recorder.SetEnabled(true);
+    recorder.Instant("Click", "input");
+    {
+        TraceScope scope("Update", "update");
+    }
+    recorder.Complete("Paint", "paint", recorder.Now());
+    recorder.SetEnabled(false);
+
+    auto json = SaveTrace();
+    ASSERT_TRUE(json.StartsWith(L"{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    ASSERT_TRUE(json.EndsWith(L"\n]}\n"));
+    ASSERT_EQ(wxNOT_FOUND, json.Find(L"Ignored"));
+    ASSERT_NE(wxNOT_FOUND, json.Find(L"{\"name\":\"Click\",\"cat\":\"input\",\"ph\":\"i\""));
+    ASSERT_NE(wxNOT_FOUND, json.Find(L"{\"name\":\"Update\",\"cat\":\"update\",\"ph\":\"X\""));
+    ASSERT_NE(wxNOT_FOUND, json.Find(L"{\"name\":\"Paint\",\"cat\":\"paint\",\"ph\":\"X\""));
+
+    // Exactly the three events recorded while enabled
+    wxString events = json;
+    ASSERT_EQ(3u, events.Replace(L"\"pid\"", L""));
+
+    // Clear drops everything recorded so far
+    recorder.Clear();
+    ASSERT_EQ(wxNOT_FOUND, SaveTrace().Find(L"\"name\""));
+}
+
+TEST(TraceRecorderTest, Overflow)
+{
+    auto& recorder = TraceRecorder::Get();
+    recorder.Clear();
+    recorder.SetEnabled(true);
+
+    // The oldest events are overwritten once the buffer is full
+    for (int i = 0; i < 10; i++)
+    {
+        recorder.Instant("Old", "test");
+    }
+    for (int i = 0; i < TraceBufferCapacity; i++)
+    {
+        recorder.Instant("New", "test");
+    }
+    recorder.SetEnabled(false);
+
+    auto json = SaveTrace();
+    recorder.Clear();
+
+    ASSERT_EQ(wxNOT_FOUND, json.Find(L"\"Old\""));
+
+    wxString search = json;
+    ASSERT_EQ(size_t(TraceBufferCapacity), search.Replace(L"\"New\"", L""));
+}
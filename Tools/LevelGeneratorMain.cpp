@@ -0,0 +1,49 @@
+/**
+ * @file LevelGeneratorMain.cpp
+ * @author Attulya Pratap Gupta
+ *
+ * Writes a generated stress level:
+ *   LevelGenerator_run --products 1000 --sensors 3 --gates 5000 --seed 42 levels/stress.xml
+ */
+
+#include <pch.h>
+#include <wx/cmdline.h>
+#include <LevelGenerator.h>
+
+/// Command line options for the generator
+static const wxCmdLineEntryDesc GeneratorOptions[] = {
+    {wxCMD_LINE_OPTION, "p", "products", "number of products on the conveyor", wxCMD_LINE_VAL_NUMBER},
+    {wxCMD_LINE_OPTION, "s", "sensors", "number of sensors", wxCMD_LINE_VAL_NUMBER},
+    {wxCMD_LINE_OPTION, "g", "gates", "number of gates in the circuit", wxCMD_LINE_VAL_NUMBER},
+    {wxCMD_LINE_OPTION, "r", "seed", "random seed", wxCMD_LINE_VAL_NUMBER},
+    {wxCMD_LINE_PARAM, nullptr, nullptr, "output level file", wxCMD_LINE_VAL_STRING},
+    {wxCMD_LINE_NONE}
+};
+
+int main(int argc, char** argv)
+{
+    wxInitializer initializer(argc, argv);
+    if (!initializer.IsOk())
+    {
+        return 1;
+    }
+
+    wxCmdLineParser parser(GeneratorOptions, argc, argv);
+    if (parser.Parse() != 0)
+    {
+        return 1;
+    }
+
+    long products = 6, sensors = 1, gates = 0, seed = 0;
+    parser.Found("products", &products);
+    parser.Found("sensors", &sensors);
+    parser.Found("gates", &gates);
+    parser.Found("seed", &seed);
+
+    LevelGenerator generator((unsigned int)seed);
+    generator.SetProductCount(int(products));
+    generator.SetSensorCount(int(sensors));
+    generator.SetGateCount(int(gates));
+
+    return generator.Save(parser.GetParam(0)) ? 0 : 1;
+}